@@ -0,0 +1,120 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "base/assert.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace
+{
+std::atomic<uint64_t> g_allocatedBytes{0};
+std::atomic<uint64_t> g_allocationsCount{0};
+
+void * Allocate(size_t size)
+{
+  g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  g_allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  if (auto * p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+}  // namespace
+
+// Replaced allocation functions let the benchmarks report bytes and allocations per operation.
+void * operator new(size_t size) { return Allocate(size); }
+void * operator new[](size_t size) { return Allocate(size); }
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete[](void * p) noexcept { std::free(p); }
+void operator delete(void * p, size_t) noexcept { std::free(p); }
+void operator delete[](void * p, size_t) noexcept { std::free(p); }
+
+namespace benchmarks
+{
+namespace
+{
+uint64_t constexpr kMaxIterations = 1'000'000'000;
+
+struct Sample
+{
+  double m_seconds = 0.0;
+  uint64_t m_bytes = 0;
+  uint64_t m_allocations = 0;
+};
+
+Sample Measure(Operation const & operation, uint64_t iterations)
+{
+  Sample sample;
+  auto const bytes = GetAllocatedBytes();
+  auto const allocations = GetAllocationsCount();
+  base::Timer timer;
+  operation(iterations);
+  sample.m_seconds = timer.ElapsedSeconds();
+  sample.m_bytes = GetAllocatedBytes() - bytes;
+  sample.m_allocations = GetAllocationsCount() - allocations;
+  return sample;
+}
+
+double Median(std::vector<double> values)
+{
+  CHECK(!values.empty(), ());
+  auto const middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  return *middle;
+}
+}  // namespace
+
+void Registry::Register(std::string const & name, SetUp && setUp)
+{
+  m_benchmarks.push_back({name, std::move(setUp)});
+}
+
+Result Run(Benchmark const & benchmark, RunParams const & params)
+{
+  CHECK_GREATER(params.m_repetitions, 0, ());
+
+  auto const operation = benchmark.m_setUp();
+
+  // The calibration runs warm up caches and lazily built structures as well.
+  uint64_t iterations = 1;
+  while (iterations < kMaxIterations)
+  {
+    auto const seconds = Measure(operation, iterations).m_seconds;
+    if (seconds >= params.m_minSeconds)
+      break;
+
+    // Aim a bit above the target to not stop just below it, but grow at most tenfold.
+    double multiplier = 10.0;
+    if (seconds > 0.0)
+      multiplier = std::min(multiplier, std::max(1.5, 1.4 * params.m_minSeconds / seconds));
+    iterations = std::min(kMaxIterations, static_cast<uint64_t>(iterations * multiplier) + 1);
+  }
+
+  std::vector<double> nsPerOp;
+  std::vector<double> bytesPerOp;
+  std::vector<double> allocsPerOp;
+  for (size_t i = 0; i < params.m_repetitions; ++i)
+  {
+    auto const sample = Measure(operation, iterations);
+    auto const n = static_cast<double>(iterations);
+    nsPerOp.push_back(sample.m_seconds * 1e9 / n);
+    bytesPerOp.push_back(sample.m_bytes / n);
+    allocsPerOp.push_back(sample.m_allocations / n);
+  }
+
+  Result result;
+  result.m_name = benchmark.m_name;
+  result.m_iterations = iterations;
+  result.m_nsPerOp = Median(std::move(nsPerOp));
+  result.m_bytesPerOp = Median(std::move(bytesPerOp));
+  result.m_allocsPerOp = Median(std::move(allocsPerOp));
+  return result;
+}
+
+uint64_t GetAllocatedBytes() { return g_allocatedBytes.load(std::memory_order_relaxed); }
+
+uint64_t GetAllocationsCount() { return g_allocationsCount.load(std::memory_order_relaxed); }
+}  // namespace benchmarks
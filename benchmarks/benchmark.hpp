@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+// Keeps |value| alive so the measured computation is not optimized away.
+template <typename T>
+inline void DoNotOptimize(T const & value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs the measured kernel |iterations| times.
+using Operation = std::function<void(uint64_t iterations)>;
+// Builds inputs of a benchmark outside of the measurement and returns its operation.
+using SetUp = std::function<Operation()>;
+
+struct Benchmark
+{
+  std::string m_name;
+  SetUp m_setUp;
+};
+
+struct Result
+{
+  std::string m_name;
+  uint64_t m_iterations = 0;
+  double m_nsPerOp = 0.0;
+  double m_bytesPerOp = 0.0;
+  double m_allocsPerOp = 0.0;
+};
+
+struct RunParams
+{
+  // Minimal duration of a single measured run.
+  double m_minSeconds = 0.5;
+  // Number of measured runs, medians of them are reported.
+  size_t m_repetitions = 3;
+};
+
+class Registry
+{
+public:
+  void Register(std::string const & name, SetUp && setUp);
+
+  std::vector<Benchmark> const & GetBenchmarks() const { return m_benchmarks; }
+
+private:
+  std::vector<Benchmark> m_benchmarks;
+};
+
+// Calibrates the number of iterations to take at least |params.m_minSeconds| and
+// reports medians over |params.m_repetitions| runs.
+Result Run(Benchmark const & benchmark, RunParams const & params);
+
+// Totals of the global operator new of the benchmarks binary since the process start.
+uint64_t GetAllocatedBytes();
+uint64_t GetAllocationsCount();
+
+void RegisterIndexerBenchmarks(Registry & registry);
+void RegisterGeocoderBenchmarks(Registry & registry);
+void RegisterGeneratorBenchmarks(Registry & registry);
+}  // namespace benchmarks
@@ -0,0 +1,170 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "generator/feature_builder.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_source.hpp"
+
+#include "indexer/classificator.hpp"
+
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/geo_object_id.hpp"
+#include "base/math.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmarks
+{
+namespace
+{
+feature::FeatureBuilder MakeBuilding()
+{
+  feature::FeatureBuilder fb;
+  fb.AddType(classif().GetTypeByPath({"building"}));
+  fb.AddName("default", "Дом культуры");
+  fb.AddName("en", "House of Culture");
+  fb.AddHouseNumber("12к3");
+  fb.AddStreet("проспект Независимости");
+  fb.SetOsmId(base::MakeOsmWay(123456789));
+
+  auto const center = MercatorBounds::FromLatLon(53.9, 27.56);
+  size_t const pointsCount = 64;
+  for (size_t i = 0; i <= pointsCount; ++i)
+  {
+    auto const angle = math::twicePi * (i % pointsCount) / pointsCount;
+    fb.AddPoint(center + m2::PointD{1e-3 * std::cos(angle), 1e-3 * std::sin(angle)});
+  }
+  fb.SetArea();
+  CHECK(fb.PreSerializeAndRemoveUselessNamesForIntermediate(), ());
+  return fb;
+}
+
+void RegisterFeatureBuilder(Registry & registry)
+{
+  registry.Register("FeatureBuilder::SerializeForIntermediate", []() -> Operation {
+    auto fb = std::make_shared<feature::FeatureBuilder>(MakeBuilding());
+    return [fb](uint64_t iterations) {
+      feature::FeatureBuilder::Buffer buffer;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        fb->SerializeForIntermediate(buffer);
+        DoNotOptimize(buffer.data());
+      }
+    };
+  });
+
+  registry.Register("FeatureBuilder::DeserializeFromIntermediate", []() -> Operation {
+    auto buffer = std::make_shared<feature::FeatureBuilder::Buffer>();
+    MakeBuilding().SerializeForIntermediate(*buffer);
+    return [buffer](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        feature::FeatureBuilder fb;
+        fb.DeserializeFromIntermediate(*buffer);
+        DoNotOptimize(fb.GetOuterGeometry().size());
+      }
+    };
+  });
+}
+
+// Intermediate data of a synthetic extract with sparse node ids, removed with the fixture.
+class NodesFixture
+{
+public:
+  NodesFixture(std::string const & nodeStorage, size_t nodesCount)
+    : m_dir(base::JoinPath(GetPlatform().TmpDir(), "geocore_benchmarks_nodes_" + nodeStorage))
+  {
+    Platform::RmDirRecursively(m_dir);
+    CHECK(Platform::MkDirChecked(m_dir), (m_dir));
+
+    auto const osmFile = base::JoinPath(m_dir, "nodes.osm");
+    {
+      std::ofstream osm(osmFile);
+      osm << std::setprecision(9) << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          << "<osm version=\"0.6\">\n";
+      for (size_t i = 0; i < nodesCount; ++i)
+      {
+        osm << "  <node id=\"" << NodeId(i) << "\" lat=\"" << 53.0 + i * 1e-6 << "\" lon=\""
+            << 27.0 + i * 1e-6 << "\"/>\n";
+      }
+      osm << "</osm>\n";
+    }
+
+    m_info.m_dataPath = base::AddSlashIfNeeded(m_dir);
+    m_info.m_targetDir = m_info.m_dataPath;
+    m_info.m_tmpDir = m_info.m_dataPath;
+    m_info.m_osmFileName = osmFile;
+    m_info.SetOsmFileType("xml");
+    m_info.SetNodeStorageType(nodeStorage);
+    m_info.m_threadsCount = 1;
+    CHECK(generator::GenerateIntermediateData(m_info), ());
+
+    m_reader = std::make_unique<generator::cache::IntermediateDataReader>(m_info);
+  }
+
+  ~NodesFixture()
+  {
+    m_reader.reset();
+    Platform::RmDirRecursively(m_dir);
+  }
+
+  static uint64_t NodeId(size_t i) { return 3 * i + 1; }
+
+  generator::cache::IntermediateDataReader const & GetReader() const { return *m_reader; }
+
+private:
+  std::string m_dir;
+  feature::GenerateInfo m_info;
+  std::unique_ptr<generator::cache::IntermediateDataReader> m_reader;
+};
+
+void RegisterGetNode(Registry & registry, std::string const & nodeStorage)
+{
+  auto const name = "IntermediateDataReader::GetNode/" + nodeStorage;
+  registry.Register(name, [nodeStorage]() -> Operation {
+    size_t const nodesCount = 100000;
+    auto fixture = std::make_shared<NodesFixture>(nodeStorage, nodesCount);
+
+    // Only present nodes are requested: misses are logged by the storages.
+    std::mt19937 rng(0);
+    auto ids = std::make_shared<std::vector<uint64_t>>();
+    for (size_t i = 0; i < 4096; ++i)
+      ids->push_back(NodesFixture::NodeId(rng() % nodesCount));
+
+    return [fixture, ids](uint64_t iterations) {
+      auto const & reader = fixture->GetReader();
+      double sum = 0.0;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        double lat = 0.0;
+        double lon = 0.0;
+        if (reader.GetNode((*ids)[i % ids->size()], lat, lon))
+          sum += lat + lon;
+      }
+      DoNotOptimize(sum);
+    };
+  });
+}
+}  // namespace
+
+void RegisterGeneratorBenchmarks(Registry & registry)
+{
+  RegisterFeatureBuilder(registry);
+  RegisterGetNode(registry, "map");
+  RegisterGetNode(registry, "raw");
+}
+}  // namespace benchmarks
@@ -0,0 +1,216 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "geocoder/hierarchy.hpp"
+#include "geocoder/hierarchy_reader.hpp"
+#include "geocoder/house_numbers_matcher.hpp"
+#include "geocoder/index.hpp"
+#include "geocoder/types.hpp"
+
+#include "indexer/search_string_utils.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmarks
+{
+namespace
+{
+size_t constexpr kLocalitiesCount = 16;
+size_t constexpr kStreetsPerLocality = 128;
+size_t constexpr kBuildingsPerStreet = 16;
+
+std::string LocalityName(size_t locality) { return "Locality " + strings::to_string(locality); }
+
+std::string StreetName(size_t street) { return "Street " + strings::to_string(street) + " Avenue"; }
+
+// Hierarchy of localities, streets and numbered buildings in the geocoder jsonl format.
+std::string MakeHierarchyJsonl()
+{
+  std::ostringstream out;
+  uint64_t id = 1;
+  for (size_t l = 0; l < kLocalitiesCount; ++l)
+  {
+    auto const locality = LocalityName(l);
+    out << id++ << R"( {"properties": {"kind": "city", "locales": {"default": {"address": )"
+        << R"({"locality": ")" << locality << R"("}}}}})" << "\n";
+    for (size_t s = 0; s < kStreetsPerLocality; ++s)
+    {
+      auto const street = StreetName(s);
+      out << id++ << R"( {"properties": {"kind": "street", "locales": {"default": {"address": )"
+          << R"({"street": ")" << street << R"(", "locality": ")" << locality << R"("}}}}})"
+          << "\n";
+      for (size_t b = 1; b <= kBuildingsPerStreet; ++b)
+      {
+        out << id++
+            << R"( {"properties": {"kind": "building", "locales": {"default": {"address": )"
+            << R"({"building": ")" << b << (b % 4 == 0 ? "к1" : "") << R"(", "street": ")"
+            << street << R"(", "locality": ")" << locality << R"("}}}}})" << "\n";
+      }
+    }
+  }
+  return out.str();
+}
+
+struct IndexFixture
+{
+  geocoder::Hierarchy m_hierarchy;
+  std::unique_ptr<geocoder::Index> m_index;
+};
+
+void BuildIndex(IndexFixture & fixture)
+{
+  std::istringstream jsonl(MakeHierarchyJsonl());
+  fixture.m_hierarchy = geocoder::HierarchyReader(jsonl).Read();
+  fixture.m_index = std::make_unique<geocoder::Index>(fixture.m_hierarchy);
+  fixture.m_index->BuildIndex();
+}
+
+void RegisterIndex(Registry & registry)
+{
+  registry.Register("geocoder::Index::ForEachDocId", []() -> Operation {
+    struct Fixture : IndexFixture
+    {
+      std::vector<geocoder::Tokens> m_queries;
+    };
+
+    auto fixture = std::make_shared<Fixture>();
+    BuildIndex(*fixture);
+
+    // Streets and localities hit the index, every fourth query misses it.
+    std::mt19937 rng(0);
+    for (size_t i = 0; i < 1024; ++i)
+    {
+      std::string name;
+      switch (i % 4)
+      {
+      case 0: name = LocalityName(rng() % kLocalitiesCount); break;
+      case 1:
+      case 2: name = StreetName(rng() % kStreetsPerLocality); break;
+      case 3: name = "Missing " + strings::to_string(rng()); break;
+      }
+      geocoder::Tokens tokens;
+      search::NormalizeAndTokenizeAsUtf8(name, tokens);
+      fixture->m_queries.push_back(std::move(tokens));
+    }
+
+    return [fixture](uint64_t iterations) {
+      uint64_t sum = 0;
+      auto const & queries = fixture->m_queries;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        fixture->m_index->ForEachDocId(queries[i % queries.size()],
+                                       [&sum](geocoder::Index::DocId docId) { sum += docId; });
+      }
+      DoNotOptimize(sum);
+    };
+  });
+}
+
+void RegisterRelatedBuildings(Registry & registry)
+{
+  registry.Register("geocoder::Index::ForEachRelatedBuildingMatch", []() -> Operation {
+    struct Fixture : IndexFixture
+    {
+      std::vector<geocoder::Index::DocId> m_streets;
+      std::vector<std::string> m_queries;
+    };
+
+    auto fixture = std::make_shared<Fixture>();
+    BuildIndex(*fixture);
+
+    std::mt19937 rng(0);
+    for (size_t i = 0; i < 1024; ++i)
+    {
+      geocoder::Tokens tokens;
+      search::NormalizeAndTokenizeAsUtf8(StreetName(rng() % kStreetsPerLocality), tokens);
+      fixture->m_index->ForEachDocId(tokens, [&](geocoder::Index::DocId docId) {
+        if (fixture->m_index->GetDoc(docId).m_type == geocoder::Type::Street)
+          fixture->m_streets.push_back(docId);
+      });
+    }
+    for (auto const & query : {"12", "4к1", "16", "7", "128"})
+    {
+      std::vector<search::house_numbers::Token> parse;
+      search::house_numbers::ParseQuery(strings::MakeUniString(query), false /* queryIsPrefix */,
+                                        parse);
+      fixture->m_queries.push_back(search::house_numbers::EncodeParse(parse));
+    }
+
+    // Mirrors Geocoder::FillBuildingsLayer for a street candidate.
+    return [fixture](uint64_t iterations) {
+      auto const & streets = fixture->m_streets;
+      auto const & queries = fixture->m_queries;
+      size_t matched = 0;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        fixture->m_index->ForEachRelatedBuildingMatch(
+            streets[i % streets.size()], queries[i % queries.size()],
+            [&matched](geocoder::Index::DocId, search::house_numbers::MatchResult const &) {
+              ++matched;
+            });
+      }
+      DoNotOptimize(matched);
+    };
+  });
+}
+
+void RegisterHouseNumbers(Registry & registry)
+{
+  registry.Register("house_numbers::HouseNumbersMatch", []() -> Operation {
+    using search::house_numbers::Token;
+
+    struct Fixture
+    {
+      std::vector<std::string> m_houseNumbers;
+      std::vector<std::vector<Token>> m_queries;
+    };
+
+    auto fixture = std::make_shared<Fixture>();
+    // House numbers are stored normalized, the same way as the geocoder gets them.
+    for (auto const & hn : {"12", "12к3", "12а", "14", "5/2", "7 корпус 1", "3-5", "10 строение 2",
+                            "128", "1а", "22б", "9"})
+    {
+      fixture->m_houseNumbers.push_back(strings::ToUtf8(search::NormalizeAndSimplifyString(hn)));
+    }
+    for (auto const & query : {"12", "12к3", "5/2", "7 к1", "128", "22"})
+    {
+      std::vector<Token> parse;
+      search::house_numbers::ParseQuery(strings::MakeUniString(query), false /* queryIsPrefix */,
+                                        parse);
+      fixture->m_queries.push_back(std::move(parse));
+    }
+
+    // Mirrors Geocoder::FillBuildingsLayer: a stored number is converted and matched against
+    // a parsed query.
+    return [fixture](uint64_t iterations) {
+      auto const & houseNumbers = fixture->m_houseNumbers;
+      auto const & queries = fixture->m_queries;
+      size_t matched = 0;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        auto const & query = queries[(i / houseNumbers.size()) % queries.size()];
+        auto const & hn = strings::MakeUniString(houseNumbers[i % houseNumbers.size()]);
+        auto matchResult = search::house_numbers::MatchResult{};
+        if (search::house_numbers::HouseNumbersMatch(hn, query, matchResult))
+          ++matched;
+      }
+      DoNotOptimize(matched);
+    };
+  });
+}
+}  // namespace
+
+void RegisterGeocoderBenchmarks(Registry & registry)
+{
+  RegisterIndex(registry);
+  RegisterRelatedBuildings(registry);
+  RegisterHouseNumbers(registry);
+}
+}  // namespace benchmarks
@@ -0,0 +1,154 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "generator/json_streaming_writer.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/map_style.hpp"
+#include "indexer/map_style_reader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/assert.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace benchmarks;
+using namespace std;
+
+namespace po = boost::program_options;
+
+struct CliCommandOptions
+{
+  std::string m_resources_path;
+  std::string m_filter;
+  double m_min_seconds;
+  size_t m_repetitions;
+  std::string m_json_path;
+  bool m_list;
+};
+
+CliCommandOptions DefineOptions(int argc, char * argv[])
+{
+  CliCommandOptions o;
+  po::options_description optionsDescription;
+
+  optionsDescription.add_options()
+    ("resources_path", po::value(&o.m_resources_path)->default_value(GEOCORE_DATA_PATH), "Path to the classificator and other resources")
+    ("filter", po::value(&o.m_filter)->default_value(""), "Run only benchmarks whose names contain the substring")
+    ("min_seconds", po::value(&o.m_min_seconds)->default_value(0.5), "Minimal duration of a measured run")
+    ("repetitions", po::value(&o.m_repetitions)->default_value(3), "Number of measured runs, medians of them are reported")
+    ("json_path", po::value(&o.m_json_path)->default_value(""), "Path to save the results as json")
+    ("list", po::bool_switch(&o.m_list), "List benchmarks without running them")
+    ("help", "Produce help message");
+
+  po::variables_map vm;
+
+  po::store(po::parse_command_line(argc, argv, optionsDescription), vm);
+  po::notify(vm);
+
+  if (vm.count("help"))
+  {
+    std::cout << optionsDescription << std::endl;
+    exit(0);
+  }
+
+  return o;
+}
+
+void PrintResult(Result const & result)
+{
+  cout << left << setw(48) << result.m_name << right << fixed << setprecision(1) << setw(14)
+       << result.m_nsPerOp << setw(14) << result.m_bytesPerOp << setprecision(2) << setw(12)
+       << result.m_allocsPerOp << setw(14) << result.m_iterations << endl;
+}
+
+void SaveResults(vector<Result> const & results, string const & path)
+{
+  generator::JsonStreamingWriter writer(9 /* precision */);
+  writer.StartObject();
+  writer.Key("benchmarks");
+  writer.StartArray();
+  for (auto const & r : results)
+  {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(r.m_name);
+    writer.Key("iterations");
+    writer.Int(static_cast<int64_t>(r.m_iterations));
+    writer.Key("ns_per_op");
+    writer.Double(r.m_nsPerOp);
+    writer.Key("bytes_per_op");
+    writer.Double(r.m_bytesPerOp);
+    writer.Key("allocs_per_op");
+    writer.Double(r.m_allocsPerOp);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  ofstream stream(path.c_str());
+  CHECK(stream.is_open(), ("Can't open", path));
+  stream << writer.GetString() << endl;
+}
+
+int main(int argc, char * argv[])
+{
+  CliCommandOptions options;
+  try
+  {
+    options = DefineOptions(argc, argv);
+  }
+  catch(po::error& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+    return 1;
+  }
+
+  Registry registry;
+  RegisterIndexerBenchmarks(registry);
+  RegisterGeocoderBenchmarks(registry);
+  RegisterGeneratorBenchmarks(registry);
+
+  vector<Benchmark> selected;
+  for (auto const & benchmark : registry.GetBenchmarks())
+  {
+    if (benchmark.m_name.find(options.m_filter) != string::npos)
+      selected.push_back(benchmark);
+  }
+
+  if (options.m_list)
+  {
+    for (auto const & benchmark : selected)
+      cout << benchmark.m_name << endl;
+    return 0;
+  }
+
+  GetPlatform().SetResourceDir(options.m_resources_path);
+  GetStyleReader().SetCurrentStyle(MapStyleMerged);
+  classificator::Load();
+
+  RunParams params;
+  params.m_minSeconds = options.m_min_seconds;
+  params.m_repetitions = options.m_repetitions;
+
+  cout << left << setw(48) << "benchmark" << right << setw(14) << "ns/op" << setw(14)
+       << "bytes/op" << setw(12) << "allocs/op" << setw(14) << "iterations" << endl;
+
+  vector<Result> results;
+  for (auto const & benchmark : selected)
+  {
+    results.push_back(Run(benchmark, params));
+    PrintResult(results.back());
+  }
+
+  if (!options.m_json_path.empty())
+    SaveResults(results, options.m_json_path);
+  return 0;
+}
@@ -0,0 +1,235 @@
+#include "benchmarks/benchmark.hpp"
+
+#include "indexer/borders.hpp"
+#include "indexer/cell_id.hpp"
+#include "indexer/covered_object.hpp"
+#include "indexer/feature_covering.hpp"
+#include "indexer/interval_index.hpp"
+#include "indexer/interval_index_builder.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/math.hpp"
+#include "base/thread_pool_computational.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmarks
+{
+namespace
+{
+// Inputs are cycled through by the operations, sizes are powers of two.
+size_t constexpr kQueriesCount = 1024;
+
+m2::PointD const kCenter = MercatorBounds::FromLatLon(53.9, 27.56);
+
+// Closed ring of |count| points on a circle with a radius jittered by up to 10%.
+std::vector<m2::PointD> MakeRing(m2::PointD const & center, double radius, size_t count,
+                                 std::mt19937 & rng)
+{
+  std::uniform_real_distribution<double> jitter(0.9, 1.1);
+  std::vector<m2::PointD> ring;
+  ring.reserve(count + 1);
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const angle = math::twicePi * i / count;
+    auto const r = radius * jitter(rng);
+    ring.emplace_back(center.x + r * std::cos(angle), center.y + r * std::sin(angle));
+  }
+  ring.push_back(ring.front());
+  return ring;
+}
+
+void RegisterCovering(Registry & registry)
+{
+  registry.Register("covering::CoverRegion/city", []() -> Operation {
+    std::mt19937 rng(0);
+    auto object = std::make_shared<indexer::CoveredObject>();
+    object->SetId(1);
+    object->SetRings({MakeRing(kCenter, 0.1 /* radius */, 512, rng)});
+    auto pool = std::make_shared<base::thread_pool::computational::ThreadPool>(1);
+    return [object, pool](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i)
+        DoNotOptimize(covering::CoverRegion(*object, kRegionsDepthLevels, *pool));
+    };
+  });
+
+  registry.Register("covering::CoverGeoObject/building", []() -> Operation {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> offset(-0.1, 0.1);
+    auto objects = std::make_shared<std::vector<indexer::CoveredObject>>(kQueriesCount);
+    for (size_t i = 0; i < objects->size(); ++i)
+    {
+      m2::PointD const leftBottom{kCenter.x + offset(rng), kCenter.y + offset(rng)};
+      (*objects)[i].SetForTesting(i, m2::RectD{leftBottom, leftBottom + m2::PointD{3e-4, 2e-4}});
+    }
+    return [objects](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        auto const & object = (*objects)[i % kQueriesCount];
+        DoNotOptimize(covering::CoverGeoObject(object, kGeoObjectsDepthLevels));
+      }
+    };
+  });
+}
+
+struct CellValuePair
+{
+  using ValueType = uint32_t;
+
+  uint64_t GetCell() const { return m_cell; }
+  uint32_t GetValue() const { return m_value; }
+
+  uint64_t m_cell;
+  uint32_t m_value;
+};
+
+void RegisterIntervalIndex(Registry & registry)
+{
+  registry.Register("IntervalIndex::ForEach", []() -> Operation {
+    uint32_t const keyBits = 40;
+    uint64_t const keyEnd = uint64_t{1} << keyBits;
+    uint64_t const intervalLength = uint64_t{1} << 26;
+
+    std::mt19937_64 rng(0);
+    std::vector<CellValuePair> data;
+    for (uint32_t i = 0; i < 100000; ++i)
+      data.push_back({rng() % keyEnd, i});
+    std::sort(data.begin(), data.end(), [](auto const & l, auto const & r) {
+      return std::make_pair(l.m_cell, l.m_value) < std::make_pair(r.m_cell, r.m_value);
+    });
+
+    struct Fixture
+    {
+      std::vector<char> m_serial;
+      std::unique_ptr<MemReader> m_reader;
+      std::unique_ptr<IntervalIndex<MemReader, uint32_t>> m_index;
+      std::vector<std::pair<uint64_t, uint64_t>> m_intervals;
+    };
+
+    auto fixture = std::make_shared<Fixture>();
+    MemWriter<std::vector<char>> writer(fixture->m_serial);
+    BuildIntervalIndex(data.begin(), data.end(), writer, keyBits);
+    fixture->m_reader = std::make_unique<MemReader>(fixture->m_serial.data(),
+                                                    fixture->m_serial.size());
+    fixture->m_index = std::make_unique<IntervalIndex<MemReader, uint32_t>>(*fixture->m_reader);
+    for (size_t i = 0; i < kQueriesCount; ++i)
+    {
+      auto const begin = rng() % (keyEnd - intervalLength);
+      fixture->m_intervals.emplace_back(begin, begin + intervalLength);
+    }
+
+    return [fixture](uint64_t iterations) {
+      uint64_t sum = 0;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        auto const & interval = fixture->m_intervals[i % kQueriesCount];
+        fixture->m_index->ForEach([&sum](uint64_t, uint32_t value) { sum += value; },
+                                  interval.first, interval.second);
+      }
+      DoNotOptimize(sum);
+    };
+  });
+}
+
+// Borders source for Borders::DeserializeFromVec().
+class SyntheticBorders
+{
+public:
+  SyntheticBorders(size_t side, double step, size_t ringSize)
+  {
+    std::mt19937 rng(0);
+    for (size_t i = 0; i < side; ++i)
+    {
+      for (size_t j = 0; j < side; ++j)
+      {
+        m2::PointD const center{kCenter.x + i * step, kCenter.y + j * step};
+        m_rings.push_back(MakeRing(center, 0.6 * step, ringSize, rng));
+      }
+    }
+  }
+
+  template <typename Fn>
+  void ForEach(Fn && fn) const
+  {
+    std::vector<std::vector<m2::PointD>> const inners;
+    for (size_t i = 0; i < m_rings.size(); ++i)
+      fn(static_cast<uint64_t>(i), m_rings[i], inners);
+  }
+
+private:
+  std::vector<std::vector<m2::PointD>> m_rings;
+};
+
+void RegisterBorders(Registry & registry)
+{
+  registry.Register("indexer::Borders::IsPointInside", []() -> Operation {
+    size_t const side = 16;
+    double const step = 0.2;
+
+    struct Fixture
+    {
+      indexer::Borders m_borders;
+      std::vector<std::pair<uint64_t, m2::PointD>> m_queries;
+    };
+
+    auto fixture = std::make_shared<Fixture>();
+    fixture->m_borders.DeserializeFromVec(SyntheticBorders(side, step, 2048 /* ringSize */));
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> offset(-0.7 * step, 0.7 * step);
+    for (size_t i = 0; i < kQueriesCount; ++i)
+    {
+      auto const id = rng() % (side * side);
+      m2::PointD const center{kCenter.x + (id / side) * step, kCenter.y + (id % side) * step};
+      fixture->m_queries.emplace_back(id, center + m2::PointD{offset(rng), offset(rng)});
+    }
+
+    return [fixture](uint64_t iterations) {
+      size_t inside = 0;
+      for (uint64_t i = 0; i < iterations; ++i)
+      {
+        auto const & query = fixture->m_queries[i % kQueriesCount];
+        if (fixture->m_borders.IsPointInside(query.first, query.second))
+          ++inside;
+      }
+      DoNotOptimize(inside);
+    };
+  });
+}
+
+void RegisterNormalization(Registry & registry)
+{
+  registry.Register("search::NormalizeAndSimplifyString", []() -> Operation {
+    auto const strings = std::make_shared<std::vector<std::string>>(std::vector<std::string>{
+        "улица Новый Арбат", "Rue de la Paix", "Straße des 17. Juni", "проспект Независимости 12к3",
+        "Ciego de Ávila", "Şişli Belediyesi", "北京市朝阳区", "Nguyễn Thị Minh Khai"});
+    return [strings](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i)
+        DoNotOptimize(search::NormalizeAndSimplifyString((*strings)[i % strings->size()]));
+    };
+  });
+}
+}  // namespace
+
+void RegisterIndexerBenchmarks(Registry & registry)
+{
+  RegisterCovering(registry);
+  RegisterIntervalIndex(registry);
+  RegisterBorders(registry);
+  RegisterNormalization(registry);
+}
+}  // namespace benchmarks
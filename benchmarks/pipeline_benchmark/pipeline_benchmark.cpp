@@ -0,0 +1,414 @@
+#include "benchmarks/pipeline_benchmark/synthetic_osm.hpp"
+
+#include "generator/covering_index_generator.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/geo_objects/geo_objects_generator.hpp"
+#include "generator/json_streaming_writer.hpp"
+#include "generator/osm_source.hpp"
+#include "generator/profiler.hpp"
+#include "generator/raw_generator.hpp"
+#include "generator/regions/collector_region_info.hpp"
+#include "generator/regions/regions.hpp"
+#include "generator/streets/streets.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/map_style.hpp"
+#include "indexer/map_style_reader.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/assert.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <sys/resource.h>
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace benchmarks;
+using namespace generator;
+using namespace std;
+
+namespace po = boost::program_options;
+
+struct CliCommandOptions
+{
+  std::string m_resources_path;
+  std::string m_work_dir;
+  bool m_keep;
+  std::string m_format;
+  std::string m_threads;
+  std::string m_node_storage;
+  std::string m_json_path;
+  bool m_verbose;
+  SyntheticOsmParams m_osm;
+};
+
+CliCommandOptions DefineOptions(int argc, char * argv[])
+{
+  CliCommandOptions o;
+  po::options_description optionsDescription;
+
+  SyntheticOsmParams const d;
+  optionsDescription.add_options()
+    ("resources_path", po::value(&o.m_resources_path)->default_value(GEOCORE_DATA_PATH), "Path to the classificator and other resources")
+    ("work_dir", po::value(&o.m_work_dir)->default_value(GetPlatform().TmpDir()), "Directory to create the geocore_pipeline_benchmark subdirectory for the extract and the generated files in, the subdirectory is cleared before the run")
+    ("keep", po::bool_switch(&o.m_keep), "Keep the generated files")
+    ("format", po::value(&o.m_format)->default_value("o5m"), "Format of the synthetic extract: o5m or xml. Only o5m input is split between threads")
+    ("threads", po::value(&o.m_threads)->default_value("1"), "Comma-separated threads counts, the pipeline is run once per count")
+    ("node_storage", po::value(&o.m_node_storage)->default_value("map"), "Type of storage for intermediate points representation. Available: raw, map, mem")
+    ("json_path", po::value(&o.m_json_path)->default_value(""), "Path to save the results as json")
+    ("verbose", po::bool_switch(&o.m_verbose), "Keep info logs of the generator")
+    ("seed", po::value(&o.m_osm.m_seed)->default_value(d.m_seed), "Seed of the synthetic extract")
+    ("admin_depth", po::value(&o.m_osm.m_adminDepth)->default_value(d.m_adminDepth), "Administrative levels between the country and localities, up to 3")
+    ("admin_fanout", po::value(&o.m_osm.m_adminFanout)->default_value(d.m_adminFanout), "Children of an administrative unit along every axis")
+    ("localities_per_axis", po::value(&o.m_osm.m_localitiesPerAxis)->default_value(d.m_localitiesPerAxis), "Localities of a leaf unit along every axis")
+    ("streets_per_locality", po::value(&o.m_osm.m_streetsPerLocality)->default_value(d.m_streetsPerLocality), "Streets of a locality")
+    ("buildings_per_street", po::value(&o.m_osm.m_buildingsPerStreet)->default_value(d.m_buildingsPerStreet), "Addressed buildings along a street")
+    ("pois_per_street", po::value(&o.m_osm.m_poisPerStreet)->default_value(d.m_poisPerStreet), "POIs along a street")
+    ("border_points_per_side", po::value(&o.m_osm.m_borderPointsPerSide)->default_value(d.m_borderPointsPerSide), "Nodes on every side of a boundary")
+    ("help", "Produce help message");
+
+  po::variables_map vm;
+
+  po::store(po::parse_command_line(argc, argv, optionsDescription), vm);
+  po::notify(vm);
+
+  if (vm.count("help"))
+  {
+    std::cout << optionsDescription << std::endl;
+    exit(0);
+  }
+
+  return o;
+}
+
+double GetCpuSeconds()
+{
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+
+  auto const toSeconds = [](timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; };
+  return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+}
+
+map<string, uint64_t> GetFileSizes(string const & dir)
+{
+  Platform::FilesList files;
+  Platform::GetFilesRecursively(dir, files);
+  map<string, uint64_t> sizes;
+  for (auto const & file : files)
+  {
+    uint64_t size = 0;
+    if (Platform::GetFileSizeByFullPath(file, size))
+      sizes.emplace(file, size);
+  }
+  return sizes;
+}
+
+auto constexpr kCountersCount = static_cast<size_t>(profiler::Counter::Count);
+
+array<uint64_t, kCountersCount> GetCounters()
+{
+  array<uint64_t, kCountersCount> counters;
+  for (size_t i = 0; i < kCountersCount; ++i)
+    counters[i] = profiler::Profiler::Instance().GetCounter(static_cast<profiler::Counter>(i));
+  return counters;
+}
+
+struct StageResult
+{
+  string m_name;
+  double m_wallSeconds = 0.0;
+  double m_cpuSeconds = 0.0;
+  // Peak RSS of the process while the stage runs, peaks of previous stages are not included.
+  uint64_t m_peakRssKb = 0;
+  // Sizes of the files created or changed by the stage.
+  uint64_t m_outputBytes = 0;
+  array<uint64_t, kCountersCount> m_counters = {};
+};
+
+struct PipelineResult
+{
+  unsigned int m_threadsCount = 0;
+  vector<StageResult> m_stages;
+};
+
+// Measures stages of the pipeline writing into |dir|.
+class StageRunner
+{
+public:
+  StageRunner(string const & dir, vector<StageResult> & results) : m_dir(dir), m_results(results)
+  {
+  }
+
+  template <typename Fn>
+  void Run(string const & name, Fn && fn)
+  {
+    auto const sizesBefore = GetFileSizes(m_dir);
+    auto const countersBefore = GetCounters();
+    auto const cpuBefore = GetCpuSeconds();
+    base::Timer timer;
+    {
+      profiler::ScopedPhase phase(name);
+      CHECK(fn(), ("Stage", name, "failed."));
+    }
+
+    StageResult result;
+    result.m_name = name;
+    result.m_wallSeconds = timer.ElapsedSeconds();
+    result.m_cpuSeconds = GetCpuSeconds() - cpuBefore;
+    result.m_peakRssKb = profiler::Profiler::Instance().GetPhases().back().m_peakRssKb;
+    for (auto const & file : GetFileSizes(m_dir))
+    {
+      auto const it = sizesBefore.find(file.first);
+      if (it == sizesBefore.cend() || it->second != file.second)
+        result.m_outputBytes += file.second;
+    }
+    auto const countersAfter = GetCounters();
+    for (size_t i = 0; i < kCountersCount; ++i)
+      result.m_counters[i] = countersAfter[i] - countersBefore[i];
+
+    PrintStage(result);
+    m_results.push_back(move(result));
+  }
+
+  static void PrintHeader()
+  {
+    cout << left << setw(28) << "stage" << right << setw(12) << "wall, s" << setw(12) << "cpu, s"
+         << setw(12) << "cpu/wall" << setw(16) << "peak rss, MB" << setw(14) << "output, MB"
+         << endl;
+  }
+
+private:
+  static void PrintStage(StageResult const & r)
+  {
+    auto const utilization = r.m_wallSeconds > 0 ? r.m_cpuSeconds / r.m_wallSeconds : 0.0;
+    cout << left << setw(28) << r.m_name << right << fixed << setprecision(3) << setw(12)
+         << r.m_wallSeconds << setw(12) << r.m_cpuSeconds << setprecision(2) << setw(12)
+         << utilization << setprecision(1) << setw(16) << r.m_peakRssKb / 1024.0 << setw(14)
+         << r.m_outputBytes / (1024.0 * 1024.0) << endl;
+  }
+
+  string m_dir;
+  vector<StageResult> & m_results;
+};
+
+// Runs the stages of generator_tool from the intermediate data to the covering indexes.
+PipelineResult RunPipeline(CliCommandOptions const & options, string const & osmFile,
+                           string const & dir, unsigned int threadsCount)
+{
+  PipelineResult pipeline;
+  pipeline.m_threadsCount = threadsCount;
+
+  feature::GenerateInfo genInfo;
+  genInfo.m_threadsCount = threadsCount;
+  genInfo.m_verbose = options.m_verbose;
+  genInfo.m_dataPath = base::AddSlashIfNeeded(dir);
+  genInfo.m_targetDir = genInfo.m_dataPath;
+  genInfo.m_tmpDir = base::JoinPath(genInfo.m_dataPath, "tmp");
+  CHECK(Platform::MkDirRecursively(genInfo.m_tmpDir), (genInfo.m_tmpDir));
+  genInfo.SetNodeStorageType(options.m_node_storage);
+  genInfo.SetOsmFileType(options.m_format);
+  genInfo.m_osmFileName = osmFile;
+
+  auto const path = [&dir](string const & name) { return base::JoinPath(dir, name); };
+  auto const regionsFeatures = path("regions.mwm.tmp");
+  auto const streetsFeatures = path("streets.mwm.tmp");
+  auto const geoObjectsFeatures = path("geo_objects.mwm.tmp");
+  auto const regionsIndex = path("regions.locidx");
+  auto const regionsKv = path("regions.jsonl");
+  auto const streetsKv = path("streets.jsonl");
+  auto const geoObjectsKv = path("geo_objects.jsonl");
+  auto const geoObjectsIndex = path("geo_objects.locidx");
+  auto const idsWithoutAddresses = path("ids_without_addresses.txt");
+  auto const regionsInfoPath =
+      genInfo.GetTmpFileName("region", regions::CollectorRegionInfo::kDefaultExt);
+
+  StageRunner runner(dir, pipeline.m_stages);
+  runner.Run("preprocess", [&]() { return GenerateIntermediateData(genInfo); });
+  runner.Run("generate_features", [&]() {
+    RawGenerator rawGenerator(genInfo);
+    rawGenerator.GenerateRegionFeatures(regionsFeatures, regionsInfoPath);
+    rawGenerator.GenerateStreetsFeatures(streetsFeatures);
+    rawGenerator.GenerateGeoObjectsFeatures(geoObjectsFeatures);
+    return rawGenerator.Execute();
+  });
+  runner.Run("generate_regions_index", [&]() {
+    return GenerateRegionsIndex(regionsIndex, regionsFeatures, threadsCount) &&
+           GenerateBorders(regionsIndex, regionsFeatures);
+  });
+  runner.Run("generate_regions_kv", [&]() {
+    regions::GenerateRegions(regionsFeatures, regionsInfoPath, regionsKv, options.m_verbose,
+                             threadsCount);
+    return true;
+  });
+  runner.Run("generate_streets", [&]() {
+    streets::GenerateStreets(regionsIndex, regionsKv, streetsFeatures, geoObjectsFeatures,
+                             streetsKv, options.m_verbose, threadsCount);
+    return true;
+  });
+  runner.Run("generate_geo_objects", [&]() {
+    return geo_objects::GenerateGeoObjects(regionsIndex, regionsKv, geoObjectsFeatures,
+                                           idsWithoutAddresses, geoObjectsKv, options.m_verbose,
+                                           threadsCount);
+  });
+  runner.Run("generate_geo_objects_index", [&]() {
+    return GenerateGeoObjectsIndex(geoObjectsIndex, geoObjectsFeatures, threadsCount,
+                                   idsWithoutAddresses, streetsFeatures);
+  });
+  return pipeline;
+}
+
+void SaveResults(CliCommandOptions const & options, SyntheticOsm const & osm,
+                 uint64_t osmFileSize, vector<PipelineResult> const & pipelines,
+                 string const & path)
+{
+  JsonStreamingWriter writer(9 /* precision */);
+  writer.StartObject();
+  writer.Key("format");
+  writer.String(options.m_format);
+  writer.Key("node_storage");
+  writer.String(options.m_node_storage);
+  writer.Key("input_bytes");
+  writer.Int(static_cast<int64_t>(osmFileSize));
+  writer.Key("nodes");
+  writer.Int(static_cast<int64_t>(osm.m_nodes.size()));
+  writer.Key("ways");
+  writer.Int(static_cast<int64_t>(osm.m_ways.size()));
+  writer.Key("relations");
+  writer.Int(static_cast<int64_t>(osm.m_relations.size()));
+
+  writer.Key("runs");
+  writer.StartArray();
+  for (auto const & pipeline : pipelines)
+  {
+    writer.StartObject();
+    writer.Key("threads");
+    writer.Int(pipeline.m_threadsCount);
+    writer.Key("stages");
+    writer.StartArray();
+    for (auto const & stage : pipeline.m_stages)
+    {
+      writer.StartObject();
+      writer.Key("name");
+      writer.String(stage.m_name);
+      writer.Key("wall_seconds");
+      writer.Double(stage.m_wallSeconds);
+      writer.Key("cpu_seconds");
+      writer.Double(stage.m_cpuSeconds);
+      writer.Key("peak_rss_kb");
+      writer.Int(static_cast<int64_t>(stage.m_peakRssKb));
+      writer.Key("output_bytes");
+      writer.Int(static_cast<int64_t>(stage.m_outputBytes));
+      writer.Key("counters");
+      writer.StartObject();
+      for (size_t i = 0; i < kCountersCount; ++i)
+      {
+        writer.Key(DebugPrint(static_cast<profiler::Counter>(i)));
+        writer.Int(static_cast<int64_t>(stage.m_counters[i]));
+      }
+      writer.EndObject();
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  ofstream stream(path.c_str());
+  CHECK(stream.is_open(), ("Can't open", path));
+  stream << writer.GetString() << endl;
+}
+
+int main(int argc, char * argv[])
+{
+  CliCommandOptions options;
+  try
+  {
+    options = DefineOptions(argc, argv);
+  }
+  catch(po::error& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+    return 1;
+  }
+
+  vector<unsigned int> threadsCounts;
+  for (auto const & token : strings::Tokenize(options.m_threads, ","))
+  {
+    unsigned int threadsCount = 0;
+    if (!strings::to_uint(token, threadsCount) || threadsCount == 0)
+    {
+      std::cerr << "ERROR: bad threads count " << token << std::endl;
+      return 1;
+    }
+    threadsCounts.push_back(threadsCount);
+  }
+
+  if (!options.m_verbose)
+    base::g_LogLevel = LWARNING;
+
+  auto & platform = GetPlatform();
+  platform.SetResourceDir(options.m_resources_path);
+  GetStyleReader().SetCurrentStyle(MapStyleMerged);
+  classificator::Load();
+
+  // Only the own subdirectory is cleared, |options.m_work_dir| may hold other files.
+  auto const workDir = base::JoinPath(options.m_work_dir, "geocore_pipeline_benchmark");
+  Platform::RmDirRecursively(workDir);
+  CHECK(Platform::MkDirRecursively(workDir), (workDir));
+  platform.SetWritableDir(workDir);
+
+  base::Timer timer;
+  auto const osm = GenerateSyntheticOsm(options.m_osm);
+  auto const osmFile = base::JoinPath(workDir, "synthetic." + options.m_format);
+  {
+    ofstream stream(osmFile, ios::binary);
+    CHECK(stream.is_open(), ("Can't open", osmFile));
+    if (options.m_format == "o5m")
+      WriteO5m(osm, stream);
+    else
+      WriteXml(osm, stream);
+  }
+  uint64_t osmFileSize = 0;
+  CHECK(Platform::GetFileSizeByFullPath(osmFile, osmFileSize), (osmFile));
+  cout << "Synthetic extract: " << osm.m_nodes.size() << " nodes, " << osm.m_ways.size()
+       << " ways, " << osm.m_relations.size() << " relations, " << osmFileSize / 1024
+       << " KB of " << options.m_format << " in " << fixed << setprecision(3)
+       << timer.ElapsedSeconds() << " s" << endl;
+
+  // Counters of the generator are reported per stage.
+  profiler::Profiler::Instance().Enable();
+
+  vector<PipelineResult> pipelines;
+  for (auto const threadsCount : threadsCounts)
+  {
+    cout << endl << "threads: " << threadsCount << endl;
+    StageRunner::PrintHeader();
+    auto const dir = base::JoinPath(workDir, "threads_" + strings::to_string(threadsCount));
+    pipelines.push_back(RunPipeline(options, osmFile, dir, threadsCount));
+    if (!options.m_keep)
+      Platform::RmDirRecursively(dir);
+  }
+
+  if (!options.m_json_path.empty())
+    SaveResults(options, osm, osmFileSize, pipelines, options.m_json_path);
+  if (!options.m_keep)
+    Platform::RmDirRecursively(workDir);
+  return 0;
+}
@@ -0,0 +1,466 @@
+#include "benchmarks/pipeline_benchmark/synthetic_osm.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace benchmarks
+{
+namespace
+{
+double constexpr kOriginLat = 50.0;
+double constexpr kOriginLon = 10.0;
+
+struct Cell
+{
+  Cell Inset(double ratio) const
+  {
+    auto const dLat = ratio * (m_maxLat - m_minLat);
+    auto const dLon = ratio * (m_maxLon - m_minLon);
+    return {m_minLat + dLat, m_minLon + dLon, m_maxLat - dLat, m_maxLon - dLon};
+  }
+
+  // Cell (|i|, |j|) of the |n| x |n| grid, inset so that children stay strictly inside.
+  Cell Child(uint32_t i, uint32_t j, uint32_t n) const
+  {
+    auto const latStep = (m_maxLat - m_minLat) / n;
+    auto const lonStep = (m_maxLon - m_minLon) / n;
+    Cell const child{m_minLat + i * latStep, m_minLon + j * lonStep, m_minLat + (i + 1) * latStep,
+                     m_minLon + (j + 1) * lonStep};
+    return child.Inset(0.02);
+  }
+
+  double m_minLat;
+  double m_minLon;
+  double m_maxLat;
+  double m_maxLon;
+};
+
+struct AdminLevel
+{
+  char const * m_adminLevel;
+  char const * m_place;
+  char const * m_name;
+};
+
+AdminLevel const kAdminLevels[] = {
+    {"4", "state", "State"}, {"6", "county", "County"}, {"7", "municipality", "Municipality"}};
+
+class Builder
+{
+public:
+  explicit Builder(SyntheticOsmParams const & params) : m_params(params), m_rng(params.m_seed) {}
+
+  SyntheticOsm Build()
+  {
+    CHECK_LESS_OR_EQUAL(m_params.m_adminDepth, ARRAY_SIZE(kAdminLevels), ());
+    CHECK_GREATER(m_params.m_adminFanout, 0, ());
+    CHECK_GREATER(m_params.m_borderPointsPerSide, 0, ());
+
+    Cell const country{kOriginLat, kOriginLon, kOriginLat + m_params.m_countrySizeDegrees,
+                       kOriginLon + m_params.m_countrySizeDegrees};
+    AddBoundary(country, {{"admin_level", "2"}, {"name", "Synthland"}, {"name:en", "Synthland"}});
+    AddAdminUnits(country, 0 /* depth */);
+    return std::move(m_osm);
+  }
+
+private:
+  using Tags = std::vector<std::pair<std::string, std::string>>;
+
+  void AddAdminUnits(Cell const & parent, uint32_t depth)
+  {
+    if (depth == m_params.m_adminDepth)
+    {
+      for (uint32_t i = 0; i < m_params.m_localitiesPerAxis; ++i)
+      {
+        for (uint32_t j = 0; j < m_params.m_localitiesPerAxis; ++j)
+          AddLocality(parent.Child(i, j, m_params.m_localitiesPerAxis));
+      }
+      return;
+    }
+
+    auto const & level = kAdminLevels[depth];
+    for (uint32_t i = 0; i < m_params.m_adminFanout; ++i)
+    {
+      for (uint32_t j = 0; j < m_params.m_adminFanout; ++j)
+      {
+        auto const cell = parent.Child(i, j, m_params.m_adminFanout);
+        auto const name = std::string(level.m_name) + " " + strings::to_string(m_unitsCount++);
+        AddBoundary(cell, {{"admin_level", level.m_adminLevel}, {"place", level.m_place},
+                           {"name", name}});
+        AddAdminUnits(cell, depth + 1);
+      }
+    }
+  }
+
+  void AddLocality(Cell const & cell)
+  {
+    auto const name = "Locality " + strings::to_string(m_localitiesCount++);
+    AddBoundary(cell, {{"admin_level", "8"}, {"place", "city"}, {"name", name}});
+
+    auto const streets = m_params.m_streetsPerLocality;
+    auto const buildings = m_params.m_buildingsPerStreet;
+    if (streets == 0)
+      return;
+
+    auto const inner = cell.Inset(0.05);
+    auto const streetStep = (inner.m_maxLat - inner.m_minLat) / streets;
+    auto const houseStep = (inner.m_maxLon - inner.m_minLon) / std::max(buildings, 1u);
+    auto const halfSize = std::min(0.2 * houseStep, 0.1 * streetStep);
+    std::uniform_real_distribution<double> jitter(-0.1 * halfSize, 0.1 * halfSize);
+
+    for (uint32_t s = 0; s < streets; ++s)
+    {
+      auto const streetName = "Street " + strings::to_string(s);
+      auto const lat = inner.m_minLat + (s + 0.5) * streetStep;
+
+      std::vector<uint64_t> streetNodes;
+      for (uint32_t b = 0; b <= buildings; ++b)
+        streetNodes.push_back(AddNode(lat, inner.m_minLon + b * houseStep, {}));
+      AddWay(std::move(streetNodes), {{"highway", "residential"}, {"name", streetName}});
+
+      for (uint32_t b = 0; b < buildings; ++b)
+      {
+        auto const centerLat = lat + 0.25 * streetStep + jitter(m_rng);
+        auto const centerLon = inner.m_minLon + (b + 0.5) * houseStep + jitter(m_rng);
+        std::vector<uint64_t> ring;
+        for (auto const & corner : {std::make_pair(-1, -1), std::make_pair(-1, 1),
+                                    std::make_pair(1, 1), std::make_pair(1, -1)})
+        {
+          ring.push_back(AddNode(centerLat + corner.first * halfSize,
+                                 centerLon + corner.second * halfSize, {}));
+        }
+        ring.push_back(ring.front());
+        AddWay(std::move(ring), {{"building", "yes"},
+                                 {"addr:housenumber", MakeHouseNumber(b)},
+                                 {"addr:street", streetName}});
+      }
+
+      auto const poiStep =
+          (inner.m_maxLon - inner.m_minLon) / std::max(m_params.m_poisPerStreet, 1u);
+      for (uint32_t p = 0; p < m_params.m_poisPerStreet; ++p)
+      {
+        Tags tags = {{"amenity", "cafe"}, {"name", "Cafe " + strings::to_string(p)}};
+        // Every other POI is addressed, the rest get addresses from the buildings around.
+        if (p % 2 == 0)
+        {
+          tags.emplace_back("addr:housenumber", strings::to_string(buildings + p + 1));
+          tags.emplace_back("addr:street", streetName);
+        }
+        AddNode(lat - 0.25 * streetStep, inner.m_minLon + (p + 0.5) * poiStep, tags);
+      }
+    }
+  }
+
+  // Mostly plain numbers with some letter and building suffixes, as in real data.
+  std::string MakeHouseNumber(uint32_t index)
+  {
+    auto number = strings::to_string(index + 1);
+    switch (m_rng() % 8)
+    {
+    case 0: number += "a"; break;
+    case 1: number += "к1"; break;
+    default: break;
+    }
+    return number;
+  }
+
+  void AddBoundary(Cell const & cell, Tags const & tags)
+  {
+    std::pair<double, double> const corners[] = {{cell.m_minLat, cell.m_minLon},
+                                                 {cell.m_minLat, cell.m_maxLon},
+                                                 {cell.m_maxLat, cell.m_maxLon},
+                                                 {cell.m_maxLat, cell.m_minLon}};
+    auto const n = m_params.m_borderPointsPerSide;
+    std::vector<uint64_t> ring;
+    for (size_t c = 0; c < ARRAY_SIZE(corners); ++c)
+    {
+      auto const & from = corners[c];
+      auto const & to = corners[(c + 1) % ARRAY_SIZE(corners)];
+      for (uint32_t k = 0; k < n; ++k)
+      {
+        auto const t = static_cast<double>(k) / n;
+        ring.push_back(AddNode(from.first + t * (to.first - from.first),
+                               from.second + t * (to.second - from.second), {}));
+      }
+    }
+    ring.push_back(ring.front());
+    auto const wayId = AddWay(std::move(ring), {});
+
+    OsmElement relation;
+    relation.m_type = OsmElement::EntityType::Relation;
+    relation.m_id = m_osm.m_relations.size() + 1;
+    relation.AddMember(wayId, OsmElement::EntityType::Way, "outer");
+    relation.AddTag("type", "boundary");
+    relation.AddTag("boundary", "administrative");
+    for (auto const & tag : tags)
+      relation.AddTag(tag.first, tag.second);
+    m_osm.m_relations.push_back(std::move(relation));
+  }
+
+  uint64_t AddNode(double lat, double lon, Tags const & tags)
+  {
+    OsmElement node;
+    node.m_type = OsmElement::EntityType::Node;
+    node.m_id = m_osm.m_nodes.size() + 1;
+    node.m_lat = lat;
+    node.m_lon = lon;
+    for (auto const & tag : tags)
+      node.AddTag(tag.first, tag.second);
+    m_osm.m_nodes.push_back(std::move(node));
+    return m_osm.m_nodes.back().m_id;
+  }
+
+  uint64_t AddWay(std::vector<uint64_t> && nodes, Tags const & tags)
+  {
+    OsmElement way;
+    way.m_type = OsmElement::EntityType::Way;
+    way.m_id = m_osm.m_ways.size() + 1;
+    for (auto const node : nodes)
+      way.AddNd(node);
+    for (auto const & tag : tags)
+      way.AddTag(tag.first, tag.second);
+    m_osm.m_ways.push_back(std::move(way));
+    return m_osm.m_ways.back().m_id;
+  }
+
+  SyntheticOsmParams const & m_params;
+  std::mt19937 m_rng;
+  SyntheticOsm m_osm;
+  uint32_t m_unitsCount = 0;
+  uint32_t m_localitiesCount = 0;
+};
+
+std::string XmlEscape(std::string const & s)
+{
+  std::string result;
+  for (auto const c : s)
+  {
+    switch (c)
+    {
+    case '&': result += "&amp;"; break;
+    case '<': result += "&lt;"; break;
+    case '>': result += "&gt;"; break;
+    case '"': result += "&quot;"; break;
+    default: result += c; break;
+    }
+  }
+  return result;
+}
+
+void WriteXmlTags(OsmElement const & element, std::ostream & stream)
+{
+  for (auto const & tag : element.Tags())
+  {
+    stream << "    <tag k=\"" << XmlEscape(tag.m_key) << "\" v=\"" << XmlEscape(tag.m_value)
+           << "\"/>\n";
+  }
+}
+
+// Encoder of o5m datasets, see https://wiki.openstreetmap.org/wiki/O5m.
+class O5mWriter
+{
+public:
+  explicit O5mWriter(std::ostream & stream) : m_stream(stream)
+  {
+    m_stream.put(static_cast<char>(0xff));
+    m_stream.put(static_cast<char>(0xe0));
+    m_stream.put(4);
+    m_stream << "o5m2";
+  }
+
+  // Zeroes all delta-coded values of the reader and of the writer.
+  void Reset()
+  {
+    m_stream.put(static_cast<char>(0xff));
+    m_id = 0;
+    m_lat = 0;
+    m_lon = 0;
+    m_refs = {};
+  }
+
+  void WriteNode(OsmElement const & node)
+  {
+    std::string data;
+    WriteIdAndVersion(node, data);
+    auto const lon = static_cast<int64_t>(std::llround(node.m_lon * 1E+7));
+    auto const lat = static_cast<int64_t>(std::llround(node.m_lat * 1E+7));
+    WriteVarInt(lon - m_lon, data);
+    WriteVarInt(lat - m_lat, data);
+    m_lon = lon;
+    m_lat = lat;
+    WriteTags(node, data);
+    WriteDataset(0x10, data);
+  }
+
+  void WriteWay(OsmElement const & way)
+  {
+    std::string data;
+    WriteIdAndVersion(way, data);
+    std::string refs;
+    for (auto const node : way.Nodes())
+      WriteRef(OsmElement::EntityType::Node, node, refs);
+    WriteVarUInt(refs.size(), data);
+    data += refs;
+    WriteTags(way, data);
+    WriteDataset(0x11, data);
+  }
+
+  void WriteRelation(OsmElement const & relation)
+  {
+    std::string data;
+    WriteIdAndVersion(relation, data);
+    std::string refs;
+    for (auto const & member : relation.Members())
+    {
+      char type = '0';
+      switch (member.m_type)
+      {
+      case OsmElement::EntityType::Node: type = '0'; break;
+      case OsmElement::EntityType::Way: type = '1'; break;
+      case OsmElement::EntityType::Relation: type = '2'; break;
+      default: CHECK(false, ("Unexpected member type:", member.m_type));
+      }
+      WriteRef(member.m_type, member.m_ref, refs);
+      refs += '\0';
+      refs += type;
+      refs += member.m_role;
+      refs += '\0';
+    }
+    WriteVarUInt(refs.size(), data);
+    data += refs;
+    WriteTags(relation, data);
+    WriteDataset(0x12, data);
+  }
+
+  void Finish() { m_stream.put(static_cast<char>(0xfe)); }
+
+private:
+  static void WriteVarUInt(uint64_t value, std::string & out)
+  {
+    while (value >= 0x80)
+    {
+      out += static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    out += static_cast<char>(value);
+  }
+
+  static void WriteVarInt(int64_t value, std::string & out)
+  {
+    WriteVarUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), out);
+  }
+
+  void WriteIdAndVersion(OsmElement const & element, std::string & out)
+  {
+    auto const id = static_cast<int64_t>(element.m_id);
+    WriteVarInt(id - m_id, out);
+    m_id = id;
+    // Zero version means no metadata.
+    WriteVarUInt(0, out);
+  }
+
+  void WriteRef(OsmElement::EntityType type, uint64_t ref, std::string & out)
+  {
+    // Node references of ways and of relation members share one delta.
+    auto & last = m_refs[type == OsmElement::EntityType::Node
+                             ? 0
+                             : (type == OsmElement::EntityType::Way ? 1 : 2)];
+    WriteVarInt(static_cast<int64_t>(ref) - last, out);
+    last = static_cast<int64_t>(ref);
+  }
+
+  // Strings are written inline, the reader does not need the string table then.
+  static void WriteTags(OsmElement const & element, std::string & out)
+  {
+    for (auto const & tag : element.Tags())
+    {
+      out += '\0';
+      out += tag.m_key;
+      out += '\0';
+      out += tag.m_value;
+      out += '\0';
+    }
+  }
+
+  void WriteDataset(uint8_t type, std::string const & data)
+  {
+    std::string header(1, static_cast<char>(type));
+    WriteVarUInt(data.size(), header);
+    m_stream << header << data;
+  }
+
+  std::ostream & m_stream;
+  int64_t m_id = 0;
+  int64_t m_lat = 0;
+  int64_t m_lon = 0;
+  std::array<int64_t, 3> m_refs = {};
+};
+}  // namespace
+
+SyntheticOsm GenerateSyntheticOsm(SyntheticOsmParams const & params)
+{
+  return Builder(params).Build();
+}
+
+void WriteXml(SyntheticOsm const & osm, std::ostream & stream)
+{
+  stream << std::fixed << std::setprecision(7) << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         << "<osm version=\"0.6\" generator=\"geocore_benchmarks\">\n";
+  for (auto const & node : osm.m_nodes)
+  {
+    stream << "  <node id=\"" << node.m_id << "\" lat=\"" << node.m_lat << "\" lon=\""
+           << node.m_lon << "\"";
+    if (node.Tags().empty())
+    {
+      stream << "/>\n";
+      continue;
+    }
+    stream << ">\n";
+    WriteXmlTags(node, stream);
+    stream << "  </node>\n";
+  }
+  for (auto const & way : osm.m_ways)
+  {
+    stream << "  <way id=\"" << way.m_id << "\">\n";
+    for (auto const node : way.Nodes())
+      stream << "    <nd ref=\"" << node << "\"/>\n";
+    WriteXmlTags(way, stream);
+    stream << "  </way>\n";
+  }
+  for (auto const & relation : osm.m_relations)
+  {
+    stream << "  <relation id=\"" << relation.m_id << "\">\n";
+    for (auto const & member : relation.Members())
+    {
+      stream << "    <member type=\"" << DebugPrint(member.m_type) << "\" ref=\"" << member.m_ref
+             << "\" role=\"" << XmlEscape(member.m_role) << "\"/>\n";
+    }
+    WriteXmlTags(relation, stream);
+    stream << "  </relation>\n";
+  }
+  stream << "</osm>\n";
+}
+
+void WriteO5m(SyntheticOsm const & osm, std::ostream & stream)
+{
+  O5mWriter writer(stream);
+  for (auto const & node : osm.m_nodes)
+    writer.WriteNode(node);
+  writer.Reset();
+  for (auto const & way : osm.m_ways)
+    writer.WriteWay(way);
+  writer.Reset();
+  for (auto const & relation : osm.m_relations)
+    writer.WriteRelation(relation);
+  writer.Finish();
+}
+}  // namespace benchmarks
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace benchmarks
+{
+// Shape of a synthetic extract: a square country split into a grid hierarchy of administrative
+// units, localities with parallel streets in the leaf units, addressed buildings along the
+// streets and POIs between them.
+struct SyntheticOsmParams
+{
+  uint32_t m_seed = 0;
+  // Administrative levels between the country and the localities, up to three
+  // (state, county, municipality).
+  uint32_t m_adminDepth = 2;
+  // Every administrative unit is split into |m_adminFanout| x |m_adminFanout| children.
+  uint32_t m_adminFanout = 2;
+  // Every leaf unit holds |m_localitiesPerAxis| x |m_localitiesPerAxis| localities.
+  uint32_t m_localitiesPerAxis = 2;
+  uint32_t m_streetsPerLocality = 16;
+  // Building density: addressed buildings along one street.
+  uint32_t m_buildingsPerStreet = 32;
+  uint32_t m_poisPerStreet = 4;
+  // Nodes on every side of a boundary ring, dense borders make point-in-polygon tests costlier.
+  uint32_t m_borderPointsPerSide = 64;
+  double m_countrySizeDegrees = 1.0;
+};
+
+// Elements of the extract in the order of an OSM planet dump: nodes, ways, relations, each
+// sorted by id.
+struct SyntheticOsm
+{
+  std::vector<OsmElement> m_nodes;
+  std::vector<OsmElement> m_ways;
+  std::vector<OsmElement> m_relations;
+};
+
+// The same params and seed always give the same extract.
+SyntheticOsm GenerateSyntheticOsm(SyntheticOsmParams const & params);
+
+void WriteXml(SyntheticOsm const & osm, std::ostream & stream);
+// Writes o5m without metadata and string references, with a reset before every element kind.
+void WriteO5m(SyntheticOsm const & osm, std::ostream & stream);
+}  // namespace benchmarks
@@ -0,0 +1,86 @@
+#include "coding/bit_packed_frames.hpp"
+
+#include "coding/endianness.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace coding
+{
+uint8_t const * ReadPackedFrame(uint8_t const * data, size_t count, uint64_t * values)
+{
+  ASSERT_LESS_OR_EQUAL(count, kPackedFrameSize, ());
+
+  uint8_t const width = *data++;
+  ASSERT_LESS_OR_EQUAL(width, 64, ());
+  size_t const size = (count * width + 7) / 8;
+
+  // Zero padding lets any value be read by two loads without checks of the frame end.
+  uint8_t packed[kPackedFrameSize * sizeof(uint64_t) + 16];
+  std::memcpy(packed, data, size);
+  std::memset(packed + size, 0, 16);
+
+  uint64_t const mask = bits::GetFullMask(width);
+  size_t bit = 0;
+  for (size_t i = 0; i < count; ++i, bit += width)
+  {
+    uint8_t const * p = packed + (bit >> 3);
+    auto const shift = static_cast<uint32_t>(bit & 7);
+    uint64_t low;
+    std::memcpy(&low, p, sizeof(low));
+    low = SwapIfBigEndianMacroBased(low);
+    // Bits of the ninth byte for values crossing the word, vanishes for zero |shift|.
+    uint64_t const high = (static_cast<uint64_t>(p[8]) << 1) << (63 - shift);
+    values[i] = ((low >> shift) | high) & mask;
+  }
+
+  return data + size;
+}
+
+void DecodeDeltas(uint64_t * values, size_t count, uint64_t base)
+{
+  size_t i = 0;
+#if defined(__SSE2__)
+  __m128i carry = _mm_set1_epi64x(static_cast<int64_t>(base));
+  for (; i + 2 <= count; i += 2)
+  {
+    auto const p = reinterpret_cast<__m128i *>(values + i);
+    __m128i x = _mm_loadu_si128(p);
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, carry);
+    _mm_storeu_si128(p, x);
+    carry = _mm_unpackhi_epi64(x, x);
+  }
+  if (i != 0)
+    base = values[i - 1];
+#endif
+  for (; i < count; ++i)
+  {
+    base += values[i];
+    values[i] = base;
+  }
+}
+
+void DecodeZigZagDeltas(uint64_t * values, size_t count, int64_t base)
+{
+  size_t i = 0;
+#if defined(__SSE2__)
+  __m128i const one = _mm_set1_epi64x(1);
+  __m128i const zero = _mm_setzero_si128();
+  for (; i + 2 <= count; i += 2)
+  {
+    auto const p = reinterpret_cast<__m128i *>(values + i);
+    __m128i const x = _mm_loadu_si128(p);
+    __m128i const sign = _mm_sub_epi64(zero, _mm_and_si128(x, one));
+    _mm_storeu_si128(p, _mm_xor_si128(_mm_srli_epi64(x, 1), sign));
+  }
+#endif
+  for (; i < count; ++i)
+    values[i] = static_cast<uint64_t>(bits::ZigZagDecode(values[i]));
+
+  DecodeDeltas(values, count, static_cast<uint64_t>(base));
+}
+}  // namespace coding
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "coding/bit_streams.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace coding
+{
+// Frames of integers bit-packed with the same width. A frame of |count| values is a width byte
+// followed by |count * width| bits written starting with the least significant bit and padded
+// to a byte. The count is not stored and must be known by the reader.
+size_t constexpr kPackedFrameSize = 128;
+
+template <typename Sink>
+void WritePackedFrame(Sink & sink, uint64_t const * values, size_t count)
+{
+  CHECK_LESS_OR_EQUAL(count, kPackedFrameSize, ());
+
+  uint64_t usedBits = 0;
+  for (size_t i = 0; i < count; ++i)
+    usedBits |= values[i];
+
+  auto const width = static_cast<uint8_t>(bits::NumUsedBits(usedBits));
+  WriteToSink(sink, width);
+
+  BitWriter<Sink> bitWriter(sink);
+  for (size_t i = 0; i < count; ++i)
+    bitWriter.WriteAtMost64Bits(values[i], width);
+}
+
+// Unpacks a frame of |count| values from |data| to |values|. Returns the frame end.
+uint8_t const * ReadPackedFrame(uint8_t const * data, size_t count, uint64_t * values);
+
+// Replaces deltas by values: values[i] = base + deltas[0] + ... + deltas[i].
+void DecodeDeltas(uint64_t * values, size_t count, uint64_t base);
+// Same as DecodeDeltas() for zigzag encoded signed deltas.
+void DecodeZigZagDeltas(uint64_t * values, size_t count, int64_t base);
+}  // namespace coding
@@ -0,0 +1,71 @@
+#include "testing/testing.hpp"
+
+#include "coding/bit_packed_frames.hpp"
+#include "coding/writer.hpp"
+
+#include "base/bits.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+UNIT_TEST(BitPackedFrames_ReadWrite)
+{
+  mt19937_64 rng(0);
+  for (uint8_t width = 0; width <= 64; ++width)
+  {
+    for (size_t count : {size_t{0}, size_t{1}, size_t{7}, kPackedFrameSize})
+    {
+      vector<uint64_t> values(count);
+      for (auto & value : values)
+        value = rng() & bits::GetFullMask(width);
+      if (count != 0 && width != 0)
+        values.back() |= uint64_t{1} << (width - 1);
+
+      vector<uint8_t> buffer;
+      {
+        MemWriter<vector<uint8_t>> writer(buffer);
+        WritePackedFrame(writer, values.data(), count);
+      }
+      uint8_t const expectedWidth = count == 0 ? 0 : width;
+      TEST_EQUAL(buffer.size(), 1 + (count * expectedWidth + 7) / 8, (width, count));
+      TEST_EQUAL(buffer[0], expectedWidth, (width, count));
+
+      vector<uint64_t> decoded(count);
+      TEST_EQUAL(ReadPackedFrame(buffer.data(), count, decoded.data()),
+                 buffer.data() + buffer.size(), (width, count));
+      TEST_EQUAL(decoded, values, (width, count));
+    }
+  }
+}
+
+UNIT_TEST(BitPackedFrames_DecodeDeltas)
+{
+  for (size_t count = 0; count <= 5; ++count)
+  {
+    vector<uint64_t> deltas, expected;
+    vector<uint64_t> zigzagDeltas, zigzagExpected;
+    uint64_t sum = 10;
+    int64_t signedSum = -10;
+    for (size_t i = 0; i < count; ++i)
+    {
+      deltas.push_back(i * 3);
+      sum += deltas.back();
+      expected.push_back(sum);
+
+      int64_t const delta = i % 2 == 0 ? -static_cast<int64_t>(i) * 7 : static_cast<int64_t>(i);
+      zigzagDeltas.push_back(bits::ZigZagEncode(delta));
+      signedSum += delta;
+      zigzagExpected.push_back(static_cast<uint64_t>(signedSum));
+    }
+
+    DecodeDeltas(deltas.data(), count, 10);
+    TEST_EQUAL(deltas, expected, (count));
+
+    DecodeZigZagDeltas(zigzagDeltas.data(), count, -10);
+    TEST_EQUAL(zigzagDeltas, zigzagExpected, (count));
+  }
+}
@@ -81,6 +81,11 @@ uint8_t * MmapReader::Data() const
   return m_data->m_memory;
 }
 
+uint8_t const * MmapReader::DataWithOffset() const
+{
+  return m_data->m_memory + m_offset;
+}
+
 void MmapReader::SetOffsetAndSize(uint64_t offset, uint64_t size)
 {
   ASSERT_LESS_OR_EQUAL(offset + size, Size(), (offset, size));
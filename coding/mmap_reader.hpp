@@ -18,6 +18,8 @@ public:
 
   /// Direct file/memory access
   uint8_t * Data() const;
+  /// Direct memory access to the part of the file read by this reader.
+  uint8_t const * DataWithOffset() const;
 
 protected:
   // Used in special derived readers.
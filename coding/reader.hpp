@@ -56,6 +56,8 @@ public:
     memcpy(p, m_pData + pos, size);
   }
 
+  char const * Data() const { return m_pData; }
+
   MemReaderTemplate SubReader(uint64_t pos, uint64_t size) const
   {
     AssertPosAndSize(pos, size);
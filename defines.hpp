@@ -23,6 +23,7 @@
 #define ID2REL_EXT ".id2rel"
 
 #define CENTERS_FILE_TAG "centers"
+#define FEATURE_BOUNDS_FILE_TAG "bounds"
 #define DATA_FILE_TAG "dat"
 #define GEOMETRY_FILE_TAG "geom"
 #define TRIANGLE_FILE_TAG "trg"
@@ -57,6 +58,7 @@
 
 #define LOCALITY_DATA_FILE_TAG "locdata"
 #define GEO_OBJECTS_INDEX_FILE_TAG "locidx"
+#define COVERED_OBJECTS_GEOMETRY_FILE_TAG "locgeom"
 #define REGIONS_INDEX_FILE_TAG "regidx"
 #define INDEX_GENERATOR_DATA_VERSION_FILE_TAG "index_data_version"
 #define BORDERS_FILE_TAG "borders"
@@ -7,6 +7,7 @@
 #include "generator/utils.hpp"
 
 #include "indexer/covered_object.hpp"
+#include "indexer/covered_objects_geometry.hpp"
 #include "indexer/covering_index_builder.hpp"
 #include "indexer/data_header.hpp"
 #include "indexer/scales.hpp"
@@ -43,8 +44,11 @@ namespace generator
 class CoveredObjectBuilder
 {
 public:
-  CoveredObjectBuilder(base::thread_pool::computational::ThreadPool & threadPool)
+  // Areas are covered by their rings if |coverAreasByRings| is true, otherwise by triangles.
+  CoveredObjectBuilder(base::thread_pool::computational::ThreadPool & threadPool,
+                       bool coverAreasByRings)
     : m_threadPool(threadPool)
+    , m_coverAreasByRings(coverAreasByRings)
   {
     m_header.SetGeometryCodingParams(serial::GeometryCodingParams());
     m_header.SetScales({scales::GetUpperScale()});
@@ -52,6 +56,14 @@ public:
 
   boost::optional<indexer::CoveredObject const &> operator()(FeatureBuilder & fb)
   {
+    if (fb.IsArea() && m_coverAreasByRings)
+      return MakeRingsObject(fb);
+
+    // The object is reused, reset the geometry of the previous feature.
+    m_coveredObject.SetPoints({});
+    m_coveredObject.SetTriangles({});
+    m_coveredObject.SetRings({});
+
     auto && geometryHolder = MakeGeometryHolder(fb);
     if (!geometryHolder)
       return boost::none;
@@ -94,6 +106,31 @@ public:
   }
 
 private:
+  boost::optional<indexer::CoveredObject const &> MakeRingsObject(FeatureBuilder & fb)
+  {
+    // A closed ring has at least four points.
+    size_t constexpr kMinRingSize = 4;
+
+    vector<vector<m2::PointD>> rings;
+    m2::SquaredDistanceFromSegmentToPoint<m2::PointD> distFn;
+    for (auto const & polygon : fb.GetGeometry())
+    {
+      vector<m2::PointD> ring;
+      SimplifyPoints(distFn, scales::GetUpperScale(), polygon, ring);
+      if (ring.size() >= kMinRingSize)
+        rings.push_back(move(ring));
+    }
+
+    if (rings.empty())
+      return boost::none;
+
+    m_coveredObject.SetId(fb.GetMostGenericOsmId().GetEncodedId());
+    m_coveredObject.SetPoints({});
+    m_coveredObject.SetTriangles({});
+    m_coveredObject.SetRings(move(rings));
+    return {m_coveredObject};
+  }
+
   boost::optional<GeometryHolder> MakeGeometryHolder(FeatureBuilder & fb)
   {
     // Do not limit inner triangles number to save all geometry without additional sections.
@@ -153,29 +190,38 @@ private:
   indexer::CoveredObject m_coveredObject;
   buffer_vector<m2::PointD, 32> m_pointsBuffer;
   base::thread_pool::computational::ThreadPool & m_threadPool;
+  bool m_coverAreasByRings;
 };
 
 template <typename FeatureFilter, typename IndexBuilder>
 void CoverFeatures(
     std::string const & featuresFile, FeatureFilter && featureFilter,
     IndexBuilder && indexBuilder, unsigned int threadsCount, uint64_t chunkFeaturesCount,
-    base::thread_pool::computational::ThreadPool & threadPool,
-    covering::ObjectsCovering & objectsCovering)
+    bool coverAreasByRings, base::thread_pool::computational::ThreadPool & threadPool,
+    covering::ObjectsCovering & objectsCovering,
+    indexer::CoveredObjectsGeometryBuilder * objectsGeometry = nullptr)
 {
   std::list<covering::ObjectsCovering> coveringsParts{};
+  std::list<indexer::CoveredObjectsGeometryBuilder> geometryParts{};
   auto makeProcessor = [&] {
     coveringsParts.emplace_back();
     auto & covering = coveringsParts.back();
+    geometryParts.emplace_back();
+    auto * geometry = objectsGeometry ? &geometryParts.back() : nullptr;
 
-    CoveredObjectBuilder localityObjectBuilder{threadPool};
-    auto processor = [featureFilter, &indexBuilder, &covering, localityObjectBuilder]
+    CoveredObjectBuilder localityObjectBuilder{threadPool, coverAreasByRings};
+    auto processor = [featureFilter, &indexBuilder, &covering, geometry, localityObjectBuilder]
                      (FeatureBuilder & fb, uint64_t /* currPos */) mutable
     {
       if (!featureFilter(fb))
         return;
 
       if (auto && localityObject = localityObjectBuilder(fb))
+      {
         indexBuilder.Cover(*localityObject, covering);
+        if (geometry)
+          geometry->Put(*localityObject);
+      }
     };
 
     return processor;
@@ -193,6 +239,12 @@ void CoverFeatures(
     objectsCovering.insert(objectsCovering.end(), part.begin(), part.end());
     coveringsParts.pop_back();
   }
+
+  if (objectsGeometry)
+  {
+    for (auto & part : geometryParts)
+      objectsGeometry->Append(std::move(part));
+  }
   LOG(LINFO, ("Finish merging of geometry coverings of features from ", featuresFile));
 }
 
@@ -227,6 +279,27 @@ bool ParseNodes(string nodesFile, set<uint64_t> & nodeIds)
   }
   return true;
 }
+
+bool WriteObjectsGeometry(string const & outPath,
+                          indexer::CoveredObjectsGeometryBuilder & geometry)
+{
+  try
+  {
+    vector<char> buffer;
+    MemWriter<vector<char>> writer{buffer};
+    geometry.Freeze(writer);
+
+    FilesContainerW(outPath, FileWriter::OP_WRITE_EXISTING)
+        .Write(buffer, COVERED_OBJECTS_GEOMETRY_FILE_TAG);
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Error writing objects geometry:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
 }  // namespace
 
 bool GenerateRegionsIndex(std::string const & outPath, std::string const & featuresFile,
@@ -238,7 +311,8 @@ bool GenerateRegionsIndex(std::string const & outPath, std::string const & featu
   auto const featuresFilter = [](FeatureBuilder & fb) { return fb.IsArea(); };
   covering::ObjectsCovering objectsCovering;
   CoverFeatures(featuresFile, featuresFilter, indexBuilder, threadsCount,
-                1 /* chunkFeaturesCount */, threadPool, objectsCovering);
+                1 /* chunkFeaturesCount */, true /* coverAreasByRings */, threadPool,
+                objectsCovering);
 
   LOG(LINFO, ("Build locality index..."));
   if (!indexBuilder.BuildCoveringIndex(std::move(objectsCovering), outPath))
@@ -251,10 +325,12 @@ bool GenerateGeoObjectsIndex(
     std::string const & outPath, std::string const & geoObjectsFeaturesFile,
     unsigned int threadsCount,
     boost::optional<std::string> const & nodesFile,
-    boost::optional<std::string> const & streetsFeaturesFile)
+    boost::optional<std::string> const & streetsFeaturesFile, bool withObjectsGeometry)
 {
   base::thread_pool::computational::ThreadPool threadPool{threadsCount};
   covering::ObjectsCovering objectsCovering;
+  indexer::CoveredObjectsGeometryBuilder objectsGeometry;
+  auto * const geometry = withObjectsGeometry ? &objectsGeometry : nullptr;
   indexer::GeoObjectsIndexBuilder indexBuilder{threadPool};
 
   set<uint64_t> nodeIds;
@@ -274,7 +350,8 @@ bool GenerateGeoObjectsIndex(
   };
 
   CoverFeatures(geoObjectsFeaturesFile, geoObjectsFilter, indexBuilder, threadsCount,
-                10 /* chunkFeaturesCount */, threadPool, objectsCovering);
+                10 /* chunkFeaturesCount */, false /* coverAreasByRings */, threadPool,
+                objectsCovering, geometry);
 
   if (streetsFeaturesFile)
   {
@@ -284,13 +361,22 @@ bool GenerateGeoObjectsIndex(
     };
 
     CoverFeatures(*streetsFeaturesFile, streetsFilter, indexBuilder, threadsCount,
-                  1 /* chunkFeaturesCount */, threadPool, objectsCovering);
+                  1 /* chunkFeaturesCount */, false /* coverAreasByRings */, threadPool,
+                  objectsCovering, geometry);
   }
 
   LOG(LINFO, ("Build objects index..."));
   if (!indexBuilder.BuildCoveringIndex(std::move(objectsCovering), outPath))
     return false;
   LOG(LINFO, ("Finish objects index building", outPath));
+
+  if (withObjectsGeometry)
+  {
+    LOG(LINFO, ("Write objects geometry..."));
+    if (!WriteObjectsGeometry(outPath, objectsGeometry))
+      return false;
+    LOG(LINFO, ("Finish objects geometry writing", outPath));
+  }
   return true;
 }
 
@@ -9,11 +9,14 @@ namespace generator
 bool GenerateRegionsIndex(
     std::string const & outPath, std::string const & featuresFile, unsigned int threadsCount);
 
+// Geometry of the indexed objects is stored next to the index if |withObjectsGeometry| is true,
+// it is needed by CoveringIndex::ForNearestToPoint().
 bool GenerateGeoObjectsIndex(
     std::string const & outPath, std::string const & geoObjectsFeaturesFile,
     unsigned int threadsCount,
     boost::optional<std::string> const & nodesFile = {},
-    boost::optional<std::string> const & streetsFeaturesFile = {});
+    boost::optional<std::string> const & streetsFeaturesFile = {},
+    bool withObjectsGeometry = false);
 
 // Generates borders section for server-side reverse geocoder from input feature-dat-files.
 bool GenerateBorders(std::string const & outPath, std::string const & featuresDir);
@@ -2,15 +2,20 @@
 
 #include "platform/platform_tests_support/scoped_file.hpp"
 
+#include "generator/covering_index_generator.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/generator_tests/common.hpp"
 #include "generator/geo_objects/geo_objects_filter.hpp"
 #include "generator/geo_objects/geo_objects_generator.hpp"
 #include "generator/geo_objects/geo_objects_maintainer.hpp"
+#include "generator/geo_objects/region_address_cache.hpp"
+#include "generator/json_streaming_writer.hpp"
 
 #include "indexer/classificator_loader.hpp"
 
+#include "base/math.hpp"
+
 
 using namespace generator_tests;
 using namespace platform::tests_support;
@@ -226,6 +231,60 @@ UNIT_TEST(GenerateGeoObjects_AddNullBuildingPointToPoint)
   TestFindReverse(osmElements, {}, {base::MakeOsmNode(1)});
 }
 
+UNIT_TEST(GenerateGeoObjects_NearestObjectsByIndexGeometry)
+{
+  std::vector<OsmElementData> const osmElements{
+      {1, {{"building", "yes"}}, RectArea{{1.0, 1.0}, {1.1, 1.1}}, {}},
+      {2, {{"building", "yes"}}, RectArea{{1.2, 1.2}, {1.3, 1.3}}, {}},
+      {3, {{"building", "yes"}}, RectArea{{2, 2}, {3, 3}}, {}}};
+
+  classificator::Load();
+  ScopedDir const dataTmpDir{"tmp"};
+  ScopedFile const geoObjectsFeatures{"tmp/geo_objects_features.mwm",
+                                      ScopedFile::Mode::DoNotCreate};
+  CollectFeatures(osmElements, geoObjectsFeatures, [](FeatureBuilder const &) { return true; });
+
+  // Geometry is not stored by default.
+  auto const tempIndex = MakeTempGeoObjectsIndex(geoObjectsFeatures.GetFullPath(),
+                                                 1 /* threadsCount */);
+  TEST(tempIndex, ("Temporary index build failed"));
+  TEST(!tempIndex->HasGeometry(), ());
+
+  ScopedFile const geoObjectsIndexFile{"tmp/geo_objects" LOC_IDX_FILE_EXTENSION,
+                                       ScopedFile::Mode::DoNotCreate};
+  TEST(GenerateGeoObjectsIndex(geoObjectsIndexFile.GetFullPath(),
+                               geoObjectsFeatures.GetFullPath(), 1 /* threadsCount */,
+                               {} /* nodesFile */, {} /* streetsFeaturesFile */,
+                               true /* withObjectsGeometry */),
+       ());
+  auto const geoObjectsIndex =
+      indexer::ReadIndex<indexer::GeoObjectsIndexBox<IndexReader>, MmapReader>(
+          geoObjectsIndexFile.GetFullPath());
+  TEST(geoObjectsIndex.HasGeometry(), ());
+
+  std::vector<std::pair<GeoObjectId, double>> nearest;
+  auto const findNearest = [&](m2::PointD const & center, uint32_t k) {
+    nearest.clear();
+    geoObjectsIndex.ForNearestToPoint(
+        [&](GeoObjectId const & id, double distanceM) { nearest.emplace_back(id, distanceM); },
+        center, MercatorBounds::DistanceOnEarth(center, {0.0, 0.0}), k);
+  };
+
+  auto const center = m2::PointD{1.9, 1.9};
+  findNearest(center, 2 /* k */);
+  TEST_EQUAL(nearest.size(), 2, ());
+  TEST_EQUAL(nearest[0].first, MakeOsmWay(3), ());
+  TEST_NEAR(nearest[0].second, MercatorBounds::DistanceOnEarth(center, {2, 2}), 1.0, ());
+  TEST_EQUAL(nearest[1].first, MakeOsmWay(2), ());
+  TEST_NEAR(nearest[1].second, MercatorBounds::DistanceOnEarth(center, {1.3, 1.3}), 1.0, ());
+
+  // Points inside of buildings are at zero distance.
+  findNearest({1.25, 1.22}, 1 /* k */);
+  TEST_EQUAL(nearest.size(), 1, ());
+  TEST_EQUAL(nearest[0].first, MakeOsmWay(2), ());
+  TEST_EQUAL(nearest[0].second, 0.0, ());
+}
+
 void TestPoiHasAddress(std::vector<OsmElementData> const & osmElements)
 {
   classificator::Load();
@@ -269,3 +328,57 @@ UNIT_TEST(GenerateGeoObjects_CheckPoiEnrichedWithAddress)
 
   TestPoiHasAddress(osmElements);
 }
+
+UNIT_TEST(GeoObjects_WriteAddressFromRegionFragments)
+{
+  auto const region = std::make_shared<JsonValue>(LoadFromString(
+      R"({
+           "type": "Feature",
+           "geometry": {"type": "Point", "coordinates": [-77.263927, 26.6210869]},
+           "properties": {
+             "locales": {
+               "default": {"address": {"country": "Bahamas", "locality": "Leisure Lee"},
+                           "name": "Leisure Lee"},
+               "ru": {"address": {"country": "Багамы"}}
+             },
+             "kind": "town",
+             "rank": 4,
+             "dref": "C00000000039A088",
+             "code": "BS"
+           }
+         })"));
+  auto const regionId = MakeOsmRelation(1).GetEncodedId();
+  StringUtf8Multilang name;
+  name.AddString("default", "Leisure Shop");
+  name.AddString("en", "Leisure Shop");
+  m2::PointD const point{-77.26, 30.62};
+
+  RegionAddressCache cache;
+  auto const fragments = cache.Get(regionId, [&region] { return region; });
+  TEST(fragments, ());
+  TEST_EQUAL(cache.Get(regionId, [] { return std::shared_ptr<JsonValue>{}; }), fragments, ());
+
+  for (auto const & house : {std::string{"5"}, std::string{}})
+  {
+    JsonStreamingWriter writer;
+    WriteAddress(writer, "Main Street", house, point, name, *fragments);
+    auto const streamed = LoadFromString(std::string{writer.GetString(), writer.GetSize()});
+    auto const expected = AddAddress("Main Street", house, point, name, {regionId, region});
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+      TEST(base::AlmostEqualAbs(
+               json_real_value(json_array_get(
+                   GetJSONObligatoryFieldByPath(streamed.get(), "geometry", "coordinates"), i)),
+               json_real_value(json_array_get(
+                   GetJSONObligatoryFieldByPath(expected.get(), "geometry", "coordinates"), i)),
+               1e-7),
+           ());
+    }
+
+    json_object_del(GetJSONObligatoryField(streamed.get(), "geometry"), "coordinates");
+    json_object_del(GetJSONObligatoryField(expected.get(), "geometry"), "coordinates");
+    TEST(json_equal(streamed.get(), expected.get()),
+         (KeyValueStorage::Serialize(streamed), KeyValueStorage::Serialize(expected)));
+  }
+}
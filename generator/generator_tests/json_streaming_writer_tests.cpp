@@ -0,0 +1,61 @@
+#include "testing/testing.hpp"
+
+#include "generator/json_streaming_writer.hpp"
+
+#include <string>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace generator;
+
+UNIT_TEST(JsonStreamingWriter_Values)
+{
+  JsonStreamingWriter writer;
+  writer.StartObject();
+  writer.Key("name");
+  writer.String("Arbat \"Street\"");
+  writer.Key("rank");
+  writer.Int(30);
+  writer.Key("pin");
+  writer.StartArray();
+  writer.Double(37.5);
+  writer.Double(55.0);
+  writer.Double(1.0000000001);
+  writer.EndArray();
+  writer.Key("dref");
+  writer.Null();
+  writer.EndObject();
+
+  TEST_EQUAL(std::string(writer.GetString(), writer.GetSize()),
+             R"({"name":"Arbat \"Street\"","rank":30,"pin":[37.5,55.0,1.0],"dref":null})", ());
+}
+
+UNIT_TEST(JsonStreamingWriter_MembersAndJanssonValues)
+{
+  auto const region = base::LoadFromString(
+      R"({"address": {"country": "Russia", "rank": 1, "area": 0.5, "tags": [true, null]}})");
+  auto const address = base::GetJSONObligatoryField(region.get(), "address");
+
+  auto const members = JsonStreamingWriter::MakeMembers([address](auto & writer) {
+    writer.Key("address");
+    writer.Value(address);
+  });
+  TEST_EQUAL(members,
+             R"("address":{"country":"Russia","rank":1,"area":0.5,"tags":[true,null]})", ());
+
+  JsonStreamingWriter writer;
+  writer.StartObject();
+  writer.Members(members);
+  writer.Members({});
+  writer.Key("street");
+  writer.String("Arbat");
+  writer.EndObject();
+  TEST_EQUAL(std::string(writer.GetString(), writer.GetSize()), "{" + members + R"(,"street":"Arbat"})",
+             ());
+
+  writer.Clear();
+  writer.StartObject();
+  writer.Members(members);
+  writer.EndObject();
+  TEST_EQUAL(std::string(writer.GetString(), writer.GetSize()), "{" + members + "}", ());
+}
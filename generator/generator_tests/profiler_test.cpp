@@ -0,0 +1,123 @@
+#include "testing/testing.hpp"
+
+#include "generator/profiler.hpp"
+
+#include "base/scope_guard.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace generator::profiler;
+
+UNIT_TEST(Profiler_CountersAndPhases)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Enable();
+  profiler.Clear();
+  SCOPE_GUARD(profilerGuard, [&profiler] {
+    profiler.Disable();
+    profiler.Clear();
+  });
+
+  {
+    ScopedPhase outer("outer");
+    {
+      ScopedPhase inner("inner");
+      Add(Counter::NodeCacheHits, 3);
+      Add(Counter::NodeCacheMisses);
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+    {
+      threads.emplace_back([]() {
+        for (size_t j = 0; j < 1000; ++j)
+          Add(Counter::ElementsRead);
+      });
+    }
+    for (auto & thread : threads)
+      thread.join();
+  }
+
+  TEST_EQUAL(profiler.GetCounter(Counter::ElementsRead), 4000, ());
+  TEST_EQUAL(profiler.GetCounter(Counter::NodeCacheHits), 3, ());
+  TEST_EQUAL(profiler.GetCounter(Counter::NodeCacheMisses), 1, ());
+  TEST_EQUAL(profiler.GetCounter(Counter::BorderTests), 0, ());
+
+  auto const phases = profiler.GetPhases();
+  TEST_EQUAL(phases.size(), 2, ());
+  TEST_EQUAL(phases[0].m_name, "inner", ());
+  TEST_EQUAL(phases[0].m_depth, 1, ());
+  TEST_EQUAL(phases[1].m_name, "outer", ());
+  TEST_EQUAL(phases[1].m_depth, 0, ());
+  TEST_LESS_OR_EQUAL(phases[1].m_startSeconds, phases[0].m_startSeconds, ());
+  TEST_LESS_OR_EQUAL(phases[0].m_seconds, phases[1].m_seconds, ());
+  TEST_GREATER(phases[1].m_peakRssKb, 0, ());
+
+  auto const json = base::LoadFromString(profiler.ToJson());
+  auto const counters = base::GetJSONObligatoryField(json.get(), "counters");
+  TEST_EQUAL(FromJSONObject<int64_t>(counters, "elements_read"), 4000, ());
+  auto const jsonPhases = base::GetJSONObligatoryField(json.get(), "phases");
+  TEST_EQUAL(json_array_size(jsonPhases), 2, ());
+
+  profiler.Clear();
+  TEST_EQUAL(profiler.GetCounter(Counter::ElementsRead), 0, ());
+  TEST(profiler.GetPhases().empty(), ());
+
+  profiler.Disable();
+  Add(Counter::ElementsRead);
+  {
+    ScopedPhase phase("disabled");
+  }
+  TEST_EQUAL(profiler.GetCounter(Counter::ElementsRead), 0, ());
+  TEST(profiler.GetPhases().empty(), ());
+}
+
+UNIT_TEST(Profiler_PhasePeakRss)
+{
+  auto & profiler = Profiler::Instance();
+  profiler.Enable();
+  profiler.Clear();
+  SCOPE_GUARD(profilerGuard, [&profiler] {
+    profiler.Disable();
+    profiler.Clear();
+  });
+
+  size_t const kBufferSize = 64 * 1024 * 1024;
+  {
+    ScopedPhase outer("outer");
+    {
+      ScopedPhase allocation("allocation");
+      auto buffer = std::make_unique<char[]>(kBufferSize);
+      std::memset(buffer.get(), 1, kBufferSize);
+    }
+    {
+      ScopedPhase afterAllocation("after_allocation");
+    }
+  }
+
+  auto const phases = profiler.GetPhases();
+  TEST_EQUAL(phases.size(), 3, ());
+  auto const allocationPeak = phases[0].m_peakRssKb;
+  auto const afterAllocationPeak = phases[1].m_peakRssKb;
+  TEST_GREATER_OR_EQUAL(allocationPeak, kBufferSize / 1024, ());
+  TEST_GREATER_OR_EQUAL(phases[2].m_peakRssKb, allocationPeak, ());
+#if defined(__linux__)
+  // The peak of a phase does not include the peaks of the previous phases.
+  TEST_LESS(afterAllocationPeak + kBufferSize / 2048, allocationPeak, ());
+#else
+  TEST_LESS_OR_EQUAL(afterAllocationPeak, allocationPeak, ());
+#endif
+
+  // The peak of the process is kept after the high-water mark resets.
+  TEST_GREATER_OR_EQUAL(profiler.GetTotalPeakRssKb(), allocationPeak, ());
+  auto const json = base::LoadFromString(profiler.ToJson());
+  TEST_GREATER_OR_EQUAL(FromJSONObject<int64_t>(json.get(), "peak_rss_kb"),
+                        static_cast<int64_t>(allocationPeak), ());
+}
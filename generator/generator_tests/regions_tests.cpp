@@ -6,6 +6,7 @@
 #include "generator/osm_element.hpp"
 #include "generator/regions/collector_region_info.hpp"
 #include "generator/regions/place_point.hpp"
+#include "generator/regions/prepared_polygon.hpp"
 #include "generator/regions/regions_builder.hpp"
 #include "generator/translator_region.hpp"
 
@@ -16,9 +17,11 @@
 
 
 #include "base/macros.hpp"
+#include "base/math.hpp"
 #include "base/scope_guard.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <sstream>
@@ -671,3 +674,101 @@ UNIT_TEST(RegionsFilterTest_EnclaveWayIgnoring)
   TEST(regionsFilter.IsAccepted(usa), ());
   TEST(!regionsFilter.IsAccepted(hawai), ());
 }
+
+// Prepared polygon tests --------------------------------------------------------------------------
+namespace
+{
+std::shared_ptr<BoostPolygon const> MakeBoostPolygon(std::vector<BoostPoint> const & outer,
+                                                     std::vector<BoostPoint> const & inner = {})
+{
+  auto polygon = std::make_shared<BoostPolygon>();
+  polygon->outer().assign(outer.begin(), outer.end());
+  if (!inner.empty())
+    polygon->inners().emplace_back(inner.begin(), inner.end());
+  boost::geometry::correct(*polygon);
+  return polygon;
+}
+}  // namespace
+
+UNIT_TEST(PreparedPolygonTest_Locate)
+{
+  auto const polygon = MakeBoostPolygon({{0, 0}, {0, 10}, {10, 10}, {10, 0}, {0, 0}},
+                                        {{4, 4}, {6, 4}, {6, 6}, {4, 6}, {4, 4}});
+  PreparedPolygon const prepared{polygon};
+
+  using Location = PreparedPolygon::Location;
+  TEST(prepared.Locate({1, 1}) == Location::Inside, ());
+  TEST(prepared.Locate({5, 5}) == Location::Outside, ());
+  TEST(prepared.Locate({11, 5}) == Location::Outside, ());
+  TEST(prepared.Locate({0, 5}) == Location::Ambiguous, ());
+  TEST(prepared.Locate({4, 5}) == Location::Ambiguous, ());
+
+  for (double x = -0.5; x < 11; x += 0.25)
+  {
+    for (double y = -0.5; y < 11; y += 0.3)
+    {
+      BoostPoint const point{x, y};
+      auto const location = prepared.Locate(point);
+      if (location != Location::Ambiguous)
+      {
+        auto const expected = boost::geometry::covered_by(point, prepared.GetRect()) &&
+                              boost::geometry::covered_by(point, *polygon);
+        TEST_EQUAL(location == Location::Inside, expected, (x, y));
+      }
+    }
+  }
+}
+
+UNIT_TEST(PreparedPolygonTest_Covers)
+{
+  PreparedPolygon const big{MakeBoostPolygon({{0, 0}, {0, 10}, {10, 10}, {10, 0}, {0, 0}},
+                                             {{4, 4}, {6, 4}, {6, 6}, {4, 6}, {4, 4}})};
+  PreparedPolygon const small{MakeBoostPolygon({{1, 1}, {1, 3}, {3, 3}, {3, 1}, {1, 1}})};
+  PreparedPolygon const aroundHole{MakeBoostPolygon({{3, 3}, {3, 7}, {7, 7}, {7, 3}, {3, 3}})};
+  PreparedPolygon const crossing{MakeBoostPolygon({{8, 8}, {8, 12}, {12, 12}, {12, 8}, {8, 8}})};
+
+  TEST(big.Covers(small) == true, ());
+  TEST(small.Covers(big) == false, ());
+  TEST(!big.Covers(aroundHole) || !*big.Covers(aroundHole), ());
+  TEST(!big.Covers(crossing) || !*big.Covers(crossing), ());
+}
+
+UNIT_TEST(PreparedPolygonTest_CalculateIntersectionArea)
+{
+  PreparedPolygon const big{MakeBoostPolygon({{0, 0}, {0, 10}, {10, 10}, {10, 0}, {0, 0}})};
+  PreparedPolygon const small{MakeBoostPolygon({{1, 1}, {1, 3}, {3, 3}, {3, 1}, {1, 1}})};
+  PreparedPolygon const far{MakeBoostPolygon({{20, 20}, {20, 23}, {23, 23}, {23, 20}, {20, 20}})};
+  PreparedPolygon const crossing{MakeBoostPolygon({{8, 8}, {8, 12}, {12, 12}, {12, 8}, {8, 8}})};
+
+  TEST(big.CalculateIntersectionArea(small) == 4.0, ());
+  TEST(small.CalculateIntersectionArea(big) == 4.0, ());
+  TEST(big.CalculateIntersectionArea(far) == 0.0, ());
+  TEST(!big.CalculateIntersectionArea(crossing), ());
+}
+
+UNIT_TEST(PreparedPolygonTest_MakeApproximation)
+{
+  std::vector<BoostPoint> circle;
+  size_t const pointsCount = 2000;
+  for (size_t i = 0; i < pointsCount; ++i)
+  {
+    auto const angle = math::twicePi * i / pointsCount;
+    circle.emplace_back(10 * std::cos(angle), 10 * std::sin(angle));
+  }
+  circle.push_back(circle.front());
+  PreparedPolygon const prepared{MakeBoostPolygon(circle)};
+
+  auto const outer = MakeApproximation(prepared, 0.02);
+  TEST(outer, ());
+  TEST_LESS(outer->GetPolygon().outer().size(), circle.size(), ());
+  TEST(outer->Covers(prepared) == true, ());
+
+  auto const inner = MakeApproximation(prepared, -0.02);
+  TEST(inner, ());
+  TEST_LESS(inner->GetPolygon().outer().size(), circle.size(), ());
+  TEST(prepared.Covers(*inner) == true, ());
+
+  using Location = PreparedPolygon::Location;
+  TEST(inner->Locate({0, 0}) == Location::Inside, ());
+  TEST(outer->Locate({9, 9}) == Location::Outside, ());
+}
@@ -2,8 +2,13 @@
 
 #include "generator/streets/street_regions_tracing.hpp"
 
+#include "geometry/point2d.hpp"
+
 #include "base/geo_object_id.hpp"
 
+#include <algorithm>
+#include <vector>
+
 using namespace generator::streets;
 using generator::KeyValue;
 
@@ -62,3 +67,35 @@ UNIT_TEST(StreetRegionTracingTest_StreetWithTransitRegion)
   TEST_EQUAL(segments[1].m_region.first, 2, ());
   TEST_EQUAL(segments[2].m_region.first, 1, ());
 }
+
+UNIT_TEST(StreetRegionTracingTest_ExactBorderCrossings)
+{
+  size_t lookupsCount = 0;
+  auto regionGetter = [&lookupsCount] (auto && point) {
+    ++lookupsCount;
+    if (0.5 <= point.x && point.x <= 0.501)
+      return KeyValue{2, {}};
+    return KeyValue{1, {}};
+  };
+  auto crossingsGetter = [] (auto && a, auto && b) {
+    std::vector<double> crossings;
+    for (auto const x : {0.5, 0.501})
+    {
+      if (std::min(a.x, b.x) < x && x < std::max(a.x, b.x))
+        crossings.push_back((x - a.x) / (b.x - a.x));
+    }
+    return crossings;
+  };
+  auto && tracing = StreetRegionsTracing{{{0.0, 0.0}, {0.3, 0.0}, {1.0, 0.0}}, regionGetter,
+                                         crossingsGetter};
+  auto && segments = tracing.StealPathSegments();
+
+  TEST_EQUAL(segments.size(), 3, ());
+  TEST_EQUAL(segments[0].m_region.first, 1, ());
+  TEST_EQUAL(segments[1].m_region.first, 2, ());
+  TEST_EQUAL(segments[2].m_region.first, 1, ());
+  TEST(base::AlmostEqualAbs(segments[0].m_path.back(), m2::PointD{0.5, 0.0}, 1e-12), ());
+  TEST(base::AlmostEqualAbs(segments[1].m_path.back(), m2::PointD{0.501, 0.0}, 1e-12), ());
+  TEST_EQUAL(segments[0].m_path.size(), 3, ());
+  TEST_EQUAL(lookupsCount, 3, ());
+}
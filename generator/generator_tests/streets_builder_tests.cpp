@@ -82,6 +82,41 @@ UNIT_TEST(StreetsBuilderTest_AggregatedStreetsInKv)
   TEST(streetsStorage.Find(MakeOsmWay(3).GetEncodedId()), ());
 }
 
+UNIT_TEST(StreetsBuilderTest_StreetValueWithRegionAddress)
+{
+  auto const osmElements = std::vector<OsmElementData>{
+      {1, {{"name", "Arbat Street"}, {"highway", "residential"}}, {{1.001, 2.001}, {1.002, 2.001}},
+       {}}};
+  ScopedFile const streetsFeatures{"streets.mwm", ScopedFile::Mode::DoNotCreate};
+  WriteFeatures(osmElements, streetsFeatures);
+
+  StreetsBuilder streetsBuilder{RussiaFinder()};
+  streetsBuilder.AssembleStreets(streetsFeatures.GetFullPath());
+  ScopedFile const streetsJsonlFile{"streets.jsonl", ScopedFile::Mode::DoNotCreate};
+  std::ofstream streetsJsonlStream(streetsJsonlFile.GetFullPath());
+  streetsBuilder.SaveStreetsKv(RussiaGetter, streetsJsonlStream);
+  streetsJsonlStream.flush();
+
+  KeyValueStorage streetsStorage{streetsJsonlFile.GetFullPath()};
+  auto const street = streetsStorage.Find(MakeOsmWay(1).GetEncodedId());
+  TEST(street, ());
+
+  auto const properties = GetJSONObligatoryField(*street, "properties");
+  TEST_EQUAL(FromJSONToString(GetJSONObligatoryField(properties, "kind")), "street", ());
+  TEST_EQUAL(FromJSONToString(GetJSONObligatoryField(properties, "dref")),
+             KeyValueStorage::SerializeDref(MakeOsmNode(424314830).GetEncodedId()), ());
+
+  auto const locale = GetJSONObligatoryFieldByPath(properties, "locales", "default");
+  TEST_EQUAL(FromJSONToString(GetJSONObligatoryField(locale, "name")), "Arbat Street", ());
+  auto const address = GetJSONObligatoryField(locale, "address");
+  TEST_EQUAL(FromJSONToString(GetJSONObligatoryField(address, "country")), "Russia", ());
+  TEST_EQUAL(FromJSONToString(GetJSONObligatoryField(address, "street")), "Arbat Street", ());
+
+  auto const pin = GetJSONObligatoryField(*street, "pin");
+  TEST_EQUAL(json_array_size(pin), 2, ());
+  TEST_EQUAL(json_array_size(GetJSONObligatoryField(*street, "bbox")), 4, ());
+}
+
 UNIT_TEST(StreetsBuilderTest_AggregatedStreetsInFeatures)
 {
   auto const osmElements = std::vector<OsmElementData>{
@@ -111,3 +146,51 @@ UNIT_TEST(StreetsBuilderTest_AggregatedStreetsInFeatures)
         ());
   TEST(featureIds.find(MakeOsmWay(3)) != featureIds.end(), ());
 }
+
+UNIT_TEST(StreetsBuilderTest_AggregatedStreetsInKvByThreads)
+{
+  auto const osmElements = std::vector<OsmElementData>{
+      {1, {{"name", "Arbat Street"}, {"highway", "residential"}}, {{1.001, 2.001}, {1.002, 2.001}},
+       {}},
+      {2, {{"name", "Arbat Street"}, {"highway", "residential"}}, {{1.002, 2.001}, {1.002, 2.002}},
+       {}},
+      {3, {{"name", "New Arbat Street"}, {"highway", "residential"}},
+       {{1.001, 2.002}, {1.002, 2.002}}, {}}};
+  ScopedFile const streetsFeatures{"streets.mwm", ScopedFile::Mode::DoNotCreate};
+  WriteFeatures(osmElements, streetsFeatures);
+
+  StreetsBuilder streetsBuilder{RussiaFinder(), 4 /* threadsCount */};
+  streetsBuilder.AssembleStreets(streetsFeatures.GetFullPath());
+  streetsBuilder.RegenerateAggregatedStreetsFeatures(streetsFeatures.GetFullPath());
+  ScopedFile const streetsJsonlFile{"streets.jsonl", ScopedFile::Mode::DoNotCreate};
+  std::ofstream streetsJsonlStream(streetsJsonlFile.GetFullPath());
+  streetsBuilder.SaveStreetsKv(RussiaGetter, streetsJsonlStream);
+  streetsJsonlStream.flush();
+
+  KeyValueStorage streetsStorage{streetsJsonlFile.GetFullPath()};
+  TEST_EQUAL(streetsStorage.Size(), 2, ());
+  TEST(streetsStorage.Find(MakeOsmWay(3).GetEncodedId()), ());
+
+  size_t featuresCount = 0;
+  feature::ForEachFromDatRawFormat(
+      streetsFeatures.GetFullPath(),
+      [&](feature::FeatureBuilder const &, uint64_t /* currPos */) { ++featuresCount; });
+  TEST_EQUAL(featuresCount, 3, ());
+}
+
+UNIT_TEST(StreetsBuilderTest_EmptyStreetsByThreads)
+{
+  ScopedFile const streetsFeatures{"streets.mwm", ScopedFile::Mode::DoNotCreate};
+  WriteFeatures({}, streetsFeatures);
+
+  StreetsBuilder streetsBuilder{RussiaFinder(), 4 /* threadsCount */};
+  streetsBuilder.AssembleStreets(streetsFeatures.GetFullPath());
+  streetsBuilder.RegenerateAggregatedStreetsFeatures(streetsFeatures.GetFullPath());
+  TEST(Platform::IsFileExistsByFullPath(streetsFeatures.GetFullPath()), ());
+
+  size_t featuresCount = 0;
+  feature::ForEachFromDatRawFormat(
+      streetsFeatures.GetFullPath(),
+      [&](feature::FeatureBuilder const &, uint64_t /* currPos */) { ++featuresCount; });
+  TEST_EQUAL(featuresCount, 0, ());
+}
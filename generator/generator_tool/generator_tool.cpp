@@ -4,6 +4,7 @@
 #include "generator/geo_objects/geo_objects_generator.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/processor_factory.hpp"
+#include "generator/profiler.hpp"
 #include "generator/raw_generator.hpp"
 #include "generator/regions/collector_region_info.hpp"
 #include "generator/regions/regions.hpp"
@@ -22,6 +23,7 @@
 #include "coding/endianness.hpp"
 
 #include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
 
 #include <boost/optional.hpp>
 #include <boost/program_options.hpp>
@@ -68,11 +70,13 @@ struct CliCommandOptions
   std::string m_geo_objects_features;
   std::string m_geo_objects_index;
   std::string m_key_value;
+  std::string m_profile_out;
   bool m_preprocess = false;
   bool m_generate_region_features = false;
   bool m_generate_features = false;
   bool m_generate_regions = false;
   bool m_generate_geo_objects_index = false;
+  bool m_geo_objects_index_geometry = false;
   bool m_generate_regions_kv = false;
   bool m_generate_streets_features = false;
   bool m_generate_geo_objects_features = false;
@@ -120,6 +124,9 @@ CliCommandOptions DefineOptions(int argc, char * argv[])
      ("generate_geo_objects_index",
          po::value(&o.m_generate_geo_objects_index)->default_value(false),
          "Generate objects and index for server-side reverse geocoder.")
+     ("geo_objects_index_geometry",
+         po::value(&o.m_geo_objects_index_geometry)->default_value(false),
+         "Store geometry of objects in geo objects index for nearest objects lookups.")
      ("generate_regions",
          po::value(&o.m_generate_regions)->default_value(false),
          "Generate regions index and borders for server-side reverse geocoder.")
@@ -162,6 +169,9 @@ CliCommandOptions DefineOptions(int argc, char * argv[])
      ("verbose",
          po::value(&o.m_verbose)->default_value(false),
          "Provide more detailed output.")
+     ("profile_out",
+         po::value(&o.m_profile_out)->default_value(""),
+         "Output json file with per-phase timings, peak RSS and counters of the run.")
      ("version", "get version")
      ("help", "produce help message");
 
@@ -195,6 +205,13 @@ int GeneratorToolMain(int argc, char ** argv)
 
   options = DefineOptions(argc, argv);
 
+  if (!options.m_profile_out.empty())
+    profiler::Profiler::Instance().Enable();
+  SCOPE_GUARD(dumpProfile, [&options]() {
+    if (!options.m_profile_out.empty())
+      profiler::Profiler::Instance().DumpJson(options.m_profile_out);
+  });
+
   Platform & pl = GetPlatform();
 
   if (options.m_user_resource_path.empty())
@@ -246,6 +263,7 @@ int GeneratorToolMain(int argc, char ** argv)
   // Generate intermediate files.
   if (options.m_preprocess)
   {
+    profiler::ScopedPhase phase("preprocess");
     DataVersion{options.m_osm_file_name}.DumpToPath(genInfo.m_dataPath);
 
     LOG(LINFO, ("Generating intermediate data ...."));
@@ -257,6 +275,7 @@ int GeneratorToolMain(int argc, char ** argv)
   if (options.m_generate_features || options.m_generate_region_features ||
       options.m_generate_streets_features || options.m_generate_geo_objects_features)
   {
+    profiler::ScopedPhase phase("generate_features");
     RawGenerator rawGenerator(genInfo);
     if (options.m_generate_region_features)
       rawGenerator.GenerateRegionFeatures(options.m_regions_features, regionsInfoPath);
@@ -271,6 +290,7 @@ int GeneratorToolMain(int argc, char ** argv)
 
   if (!options.m_streets_key_value.empty())
   {
+    profiler::ScopedPhase phase("generate_streets");
     streets::GenerateStreets(options.m_regions_index, options.m_regions_key_value,
                              options.m_streets_features, options.m_geo_objects_features,
                              options.m_streets_key_value, options.m_verbose,
@@ -279,6 +299,7 @@ int GeneratorToolMain(int argc, char ** argv)
 
   if (!options.m_geo_objects_key_value.empty())
   {
+    profiler::ScopedPhase phase("generate_geo_objects");
     if (!geo_objects::GenerateGeoObjects(
             options.m_regions_index, options.m_regions_key_value, options.m_geo_objects_features,
             options.m_ids_without_addresses, options.m_geo_objects_key_value, options.m_verbose,
@@ -299,9 +320,11 @@ int GeneratorToolMain(int argc, char ** argv)
     auto const streetsFeaturesPath =
         boost::make_optional(!options.m_streets_features.empty(), options.m_streets_features);
 
+    profiler::ScopedPhase phase("generate_geo_objects_index");
     LOG(LINFO, ("Saving geo objects index to", options.m_geo_objects_index));
     if (!GenerateGeoObjectsIndex(options.m_geo_objects_index, options.m_geo_objects_features,
-                                 genInfo.m_threadsCount, nodesListPath, streetsFeaturesPath))
+                                 genInfo.m_threadsCount, nodesListPath, streetsFeaturesPath,
+                                 options.m_geo_objects_index_geometry))
     {
       LOG(LCRITICAL, ("Error generating geo objects index."));
       return EXIT_FAILURE;
@@ -319,6 +342,7 @@ int GeneratorToolMain(int argc, char ** argv)
       return EXIT_FAILURE;
     }
 
+    profiler::ScopedPhase phase("generate_regions_index");
     LOG(LINFO, ("Saving regions index to", options.m_regions_index));
     if (!GenerateRegionsIndex(options.m_regions_index, options.m_regions_features,
                               genInfo.m_threadsCount))
@@ -340,6 +364,7 @@ int GeneratorToolMain(int argc, char ** argv)
 
   if (options.m_generate_regions_kv)
   {
+    profiler::ScopedPhase phase("generate_regions_kv");
     regions::GenerateRegions(options.m_regions_features, regionsInfoPath,
                              options.m_regions_key_value, options.m_verbose,
                              genInfo.m_threadsCount);
@@ -1,14 +1,15 @@
+#include "generator/geo_objects/geo_objects.hpp"
+
 #include "generator/covering_index_generator.hpp"
 #include "generator/data_version.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
-#include "generator/key_value_concurrent_writer.hpp"
-#include "generator/key_value_storage.hpp"
-
-#include "generator/geo_objects/geo_objects.hpp"
 #include "generator/geo_objects/geo_objects_filter.hpp"
 #include "generator/geo_objects/geo_objects_maintainer.hpp"
-
+#include "generator/geo_objects/region_address_cache.hpp"
+#include "generator/json_streaming_writer.hpp"
+#include "generator/key_value_concurrent_writer.hpp"
+#include "generator/key_value_storage.hpp"
 #include "generator/regions/region_base.hpp"
 
 #include "indexer/classificator.hpp"
@@ -27,6 +28,7 @@
 #include <cstdint>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -162,11 +164,14 @@ private:
   private:
     void WriteIntoKv(FeatureBuilder & fb, KeyValue const & regionKeyValue)
     {
-      auto const id = fb.GetMostGenericOsmId();
-      auto jsonValue = AddAddress(fb.GetParams().GetStreet(), fb.GetParams().house.Get(),
-                                  fb.GetKeyPoint(), fb.GetMultilangName(), regionKeyValue);
-
-      m_kvWriter.Write(id, JsonValue{std::move(jsonValue)});
+      auto const region = m_regionAddressCache.Get(
+          regionKeyValue.first, [&regionKeyValue] { return regionKeyValue.second; });
+      CHECK(region, (regionKeyValue.first));
+
+      m_valueWriter->Clear();
+      WriteAddress(*m_valueWriter, fb.GetParams().GetStreet(), fb.GetParams().house.Get(),
+                   fb.GetKeyPoint(), fb.GetMultilangName(), *region);
+      m_kvWriter.Write(fb.GetMostGenericOsmId(), *m_valueWriter);
     }
 
     void CacheGeoData(FeatureBuilder & fb, KeyValue const & regionKeyValue)
@@ -179,6 +184,8 @@ private:
 
     BuildingsAndHousesGenerator & m_generator;
     KeyValueConcurrentWriter m_kvWriter;
+    RegionAddressCache m_regionAddressCache;
+    std::unique_ptr<JsonStreamingWriter> m_valueWriter = std::make_unique<JsonStreamingWriter>();
     BufferedCuncurrentUnorderedMapUpdater<base::GeoObjectId, GeoObjectData> m_geoDataCache;
   };
 
@@ -447,6 +454,8 @@ public:
   }
 
 private:
+  using GeoObjectData = GeoObjectMaintainer::GeoObjectData;
+
   class Processor
   {
   public:
@@ -472,28 +481,27 @@ private:
       if (GeoObjectsFilter::IsBuilding(fb) || GeoObjectsFilter::HasHouse(fb))
         return;
 
-      // No name and coordinates here, we will take it from fb in MakeJsonValueWithNameFromFeature
-      auto house = FindHouse(fb);
+      auto const house = FindHouse(fb);
       if (!house)
         return;
 
-      WriteIntoKv(fb, house);
+      auto const region = GetRegion(*house);
+      if (!region)
+        return;
+
+      WriteIntoKv(fb, *house, *region);
 
       auto const id = fb.GetMostGenericOsmId();
       m_localityIndexedPoiIds << id << "\n";
     }
 
   private:
-    JsonValue FindHouse(FeatureBuilder const & fb)
+    boost::optional<GeoObjectData> FindHouse(FeatureBuilder const & fb)
     {
-      base::JSONPtr house =
-          m_goObjectsView.GetFullGeoObject(
-              fb.GetKeyPoint(), [](GeoObjectMaintainer::GeoObjectData const & data)
-          {
-            return !data.m_house.empty();
-          });
-      if (house)
-        return JsonValue{std::move(house)};
+      auto const house = m_goObjectsView.SearchGeoData(
+          fb.GetKeyPoint(), [](GeoObjectData const & data) { return !data.m_house.empty(); });
+      if (house && GetRegion(*house))
+        return house;
 
       auto && potentialIds = m_goObjectsView.SearchObjectsInIndex(fb.GetKeyPoint());
 
@@ -502,36 +510,35 @@ private:
       {
         auto const it = buildings2AddressPoints.find(id);
         if (it != buildings2AddressPoints.end())
-          return JsonValue{m_goObjectsView.GetFullGeoObjectWithoutNameAndCoordinates(it->second)};
+          return m_goObjectsView.GetGeoData(it->second);
       }
 
-      return JsonValue{};
+      return {};
     }
 
-    JsonValue MakeJsonValueWithNameFromFeature(FeatureBuilder const & fb, JsonValue const & json)
+    RegionAddressFragments const * GetRegion(GeoObjectData const & house)
     {
-      auto jsonWithAddress = json.MakeDeepCopyJson();
-
-      auto properties = json_object_get(jsonWithAddress.get(), "properties");
-      Localizator localizator(*properties);
-      localizator.SetLocale("name", Localizator::EasyObjectWithTranslation(fb.GetMultilangName()));
-
-      UpdateCoordinates(fb.GetKeyPoint(), jsonWithAddress);
-      return JsonValue{std::move(jsonWithAddress)};
+      return m_regionAddressCache.Get(house.m_regionId.GetEncodedId(), [&] {
+        return m_goObjectsView.GetRegion(house.m_regionId);
+      });
     }
 
-    void WriteIntoKv(FeatureBuilder & fb, JsonValue const & house)
+    // House address with the name and coordinates of the POI.
+    void WriteIntoKv(FeatureBuilder & fb, GeoObjectData const & house,
+                     RegionAddressFragments const & region)
     {
-      auto const id = fb.GetMostGenericOsmId();
-      auto jsonValue = MakeJsonValueWithNameFromFeature(fb, house);
-
-      m_kvWriter.Write(id, JsonValue{std::move(jsonValue)});
+      m_valueWriter->Clear();
+      WriteAddress(*m_valueWriter, house.m_street, house.m_house, fb.GetKeyPoint(),
+                   fb.GetMultilangName(), region);
+      m_kvWriter.Write(fb.GetMostGenericOsmId(), *m_valueWriter);
       ++m_poisAddressEnrichedStat;
     }
 
     GeoObjectMaintainer::GeoObjectsView m_goObjectsView;
     NullBuildingsInfo const & m_buildingsInfo;
     KeyValueConcurrentWriter m_kvWriter;
+    RegionAddressCache m_regionAddressCache;
+    std::unique_ptr<JsonStreamingWriter> m_valueWriter = std::make_unique<JsonStreamingWriter>();
     std::ofstream m_localityIndexedPoiIds;
     std::atomic_size_t & m_poisAddressEnrichedStat;
   };
@@ -1,24 +1,13 @@
 #include "generator/geo_objects/geo_objects_generator.hpp"
 
+#include "generator/profiler.hpp"
+
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 #include "base/timer.hpp"
 
 #include <future>
 
-namespace
-{
-template <class Activist>
-auto Measure(std::string activity, Activist && activist)
-{
-  LOG(LINFO, ("Start", activity));
-  auto timer = base::Timer();
-  SCOPE_GUARD(_, [&]() { LOG(LINFO, ("Finish", activity, timer.ElapsedSeconds(), "seconds.")); });
-
-  return activist();
-}
-}  // namespace
-
 namespace generator
 {
 namespace geo_objects
@@ -41,33 +30,47 @@ GeoObjectsGenerator::GeoObjectsGenerator(
 
 bool GeoObjectsGenerator::GenerateGeoObjects()
 {
-  return Measure("generating geo objects", [&]() { return GenerateGeoObjectsPrivate(); });
-}
+  LOG(LINFO, ("Start generating geo objects."));
+  auto timer = base::Timer();
+  SCOPE_GUARD(finishGeneratingGeoObjects, [&timer]() {
+    LOG(LINFO, ("Finish generating geo objects.", timer.ElapsedSeconds(), "seconds."));
+  });
 
-bool GeoObjectsGenerator::GenerateGeoObjectsPrivate()
-{
   // Index buidling requires a lot of memory (~140GB).
   // Build index when there is a lot of memory,
   // before AddBuildingsAndThingsWithHousesThenEnrichAllWithRegionAddresses().
-  auto geoObjectIndex = MakeTempGeoObjectsIndex(m_pathInGeoObjectsTmpMwm, m_threadsCount);
-  if (!geoObjectIndex)
-    return false;
-  LOG(LINFO, ("Index was built."));
-  m_geoObjectMaintainer.SetIndex(std::move(*geoObjectIndex));
-
-  AddBuildingsAndThingsWithHousesThenEnrichAllWithRegionAddresses(
-      m_pathOutGeoObjectsKv, m_geoObjectMaintainer, m_pathInGeoObjectsTmpMwm, m_regionInfoLocater,
-      m_verbose, m_threadsCount);
-  LOG(LINFO, ("Geo objects with addresses were built."));
+  {
+    profiler::ScopedPhase phase("geo_objects_index");
+    auto geoObjectIndex = MakeTempGeoObjectsIndex(m_pathInGeoObjectsTmpMwm, m_threadsCount);
+    if (!geoObjectIndex)
+      return false;
+    LOG(LINFO, ("Index was built."));
+    m_geoObjectMaintainer.SetIndex(std::move(*geoObjectIndex));
+  }
+
+  {
+    profiler::ScopedPhase phase("geo_objects_with_addresses");
+    AddBuildingsAndThingsWithHousesThenEnrichAllWithRegionAddresses(
+        m_pathOutGeoObjectsKv, m_geoObjectMaintainer, m_pathInGeoObjectsTmpMwm,
+        m_regionInfoLocater, m_verbose, m_threadsCount);
+    LOG(LINFO, ("Geo objects with addresses were built."));
+  }
 
   LOG(LINFO, ("Enrich address points with outer null building geometry."));
-  NullBuildingsInfo const & buildingInfo = EnrichPointsWithOuterBuildingGeometry(
-      m_geoObjectMaintainer, m_pathInGeoObjectsTmpMwm, m_threadsCount);
-
-  AddPoisEnrichedWithHouseAddresses(m_geoObjectMaintainer, buildingInfo,
-                                    m_pathOutGeoObjectsKv, m_pathInGeoObjectsTmpMwm,
-                                    m_pathOutPoiIdsToAddToCoveringIndex,
-                                    m_verbose, m_threadsCount);
+  NullBuildingsInfo buildingInfo;
+  {
+    profiler::ScopedPhase phase("null_buildings");
+    buildingInfo = EnrichPointsWithOuterBuildingGeometry(m_geoObjectMaintainer,
+                                                         m_pathInGeoObjectsTmpMwm, m_threadsCount);
+  }
+
+  {
+    profiler::ScopedPhase phase("pois_with_house_addresses");
+    AddPoisEnrichedWithHouseAddresses(m_geoObjectMaintainer, buildingInfo,
+                                      m_pathOutGeoObjectsKv, m_pathInGeoObjectsTmpMwm,
+                                      m_pathOutPoiIdsToAddToCoveringIndex,
+                                      m_verbose, m_threadsCount);
+  }
 
   LOG(LINFO, ("Geo objects without addresses were built."));
   LOG(LINFO, ("Geo objects key-value storage saved to", m_pathOutGeoObjectsKv));
@@ -36,8 +36,6 @@ public:
   }
 
 private:
-  bool GenerateGeoObjectsPrivate();
-
   std::string m_pathInGeoObjectsTmpMwm;
   std::string m_pathOutPoiIdsToAddToCoveringIndex;
   std::string m_pathOutGeoObjectsKv;
@@ -4,12 +4,19 @@
 #include "generator/key_value_storage.hpp"
 #include "generator/translation.hpp"
 
+#include <map>
+#include <string>
 #include <utility>
 
 namespace generator
 {
 namespace geo_objects
 {
+namespace
+{
+int const kHouseOrPoiRank = 30;
+}  // namespace
+
 GeoObjectMaintainer::GeoObjectMaintainer(RegionIdGetter && regionIdGetter)
   : m_regionIdGetter(std::move(regionIdGetter))
 {
@@ -48,7 +55,6 @@ base::JSONPtr AddAddress(std::string const & street, std::string const & house,
   Localizator localizator(*properties);
   localizator.SetLocale("name", Localizator::EasyObjectWithTranslation(name));
 
-  int const kHouseOrPoiRank = 30;
   ToJSONObject(*properties, "kind", "building");
   ToJSONObject(*properties, "rank", kHouseOrPoiRank);
 
@@ -56,10 +62,127 @@ base::JSONPtr AddAddress(std::string const & street, std::string const & house,
   return result;
 }
 
+void WriteAddress(JsonStreamingWriter & writer, std::string const & street,
+                  std::string const & house, m2::PointD point, StringUtf8Multilang const & name,
+                  RegionAddressFragments const & region)
+{
+  std::map<std::string, std::string> names;
+  Localizator::ForEachLocaleName(
+      Localizator::EasyObjectWithTranslation(name),
+      [&names](std::string const & language, std::string const & localeName) {
+        names.emplace(language, localeName);
+      });
+
+  writer.StartObject();
+  writer.Members(region.m_members);
+
+  if (region.m_geometry)
+  {
+    writer.Key("geometry");
+    writer.StartObject();
+    writer.Members(*region.m_geometry);
+    if (region.m_hasPointCoordinates)
+    {
+      auto const latLon = MercatorBounds::ToLatLon(point);
+      writer.Key("coordinates");
+      writer.StartArray();
+      writer.Double(latLon.m_lon);
+      writer.Double(latLon.m_lat);
+      writer.EndArray();
+    }
+    writer.EndObject();
+  }
+
+  writer.Key("properties");
+  writer.StartObject();
+  writer.Key("locales");
+  writer.StartObject();
+  for (auto const & locale : region.m_locales)
+  {
+    writer.Key(locale.first);
+    writer.StartObject();
+    writer.Members(locale.second.m_members);
+
+    auto const localeName = names.find(locale.first);
+    if (localeName != names.end())
+    {
+      writer.Key("name");
+      writer.String(localeName->second);
+    }
+
+    auto const isDefault = locale.first == "default";
+    if (isDefault || locale.second.m_address)
+    {
+      writer.Key("address");
+      writer.StartObject();
+      if (locale.second.m_address)
+        writer.Members(*locale.second.m_address);
+      if (isDefault)
+      {
+        if (!street.empty())
+        {
+          writer.Key("street");
+          writer.String(street);
+        }
+
+        // By writing home null in the field we can understand that the house has no address.
+        writer.Key("building");
+        if (!house.empty())
+          writer.String(house);
+        else
+          writer.Null();
+      }
+      writer.EndObject();
+    }
+
+    writer.EndObject();
+  }
+  for (auto const & localeName : names)
+  {
+    if (region.m_locales.count(localeName.first))
+      continue;
+
+    writer.Key(localeName.first);
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(localeName.second);
+    writer.EndObject();
+  }
+  writer.EndObject();
+
+  writer.Key("kind");
+  writer.String("building");
+  writer.Key("rank");
+  writer.Int(kHouseOrPoiRank);
+  writer.Key("dref");
+  writer.String(region.m_dref);
+  writer.Members(region.m_properties);
+  writer.EndObject();
+
+  writer.EndObject();
+}
+
 // GeoObjectMaintainer::GeoObjectsView
 base::JSONPtr GeoObjectMaintainer::GeoObjectsView::GetFullGeoObject(
     m2::PointD point,
     std::function<bool(GeoObjectMaintainer::GeoObjectData const &)> && pred) const
+{
+  auto const geoData = SearchGeoData(point, std::move(pred));
+  if (!geoData)
+    return {};
+
+  auto const & regionJsonValue = m_regionIdGetter(geoData->m_regionId);
+  if (!regionJsonValue)
+    return {};
+
+  return AddAddress(geoData->m_street, geoData->m_house, point, StringUtf8Multilang(),
+                    KeyValue(geoData->m_regionId.GetEncodedId(), regionJsonValue));
+}
+
+boost::optional<GeoObjectMaintainer::GeoObjectData>
+GeoObjectMaintainer::GeoObjectsView::SearchGeoData(
+    m2::PointD point,
+    std::function<bool(GeoObjectMaintainer::GeoObjectData const &)> && pred) const
 {
   auto const ids = SearchGeoObjectIdsByPoint(m_geoIndex, point);
   for (auto const & id : ids)
@@ -68,17 +191,8 @@ base::JSONPtr GeoObjectMaintainer::GeoObjectsView::GetFullGeoObject(
     if (it == m_geoId2GeoData.end())
       continue;
 
-    auto const geoData = it->second;
-    if (!pred(geoData))
-      continue;
-
-
-    auto const & regionJsonValue = m_regionIdGetter(geoData.m_regionId);
-    if (!regionJsonValue)
-      return {};
-
-    return AddAddress(geoData.m_street, geoData.m_house, point, StringUtf8Multilang(),
-                      KeyValue(geoData.m_regionId.GetEncodedId(), regionJsonValue));
+    if (pred(it->second))
+      return it->second;
   }
 
   return {};
@@ -1,11 +1,11 @@
 #pragma once
 
+#include "generator/feature_builder.hpp"
+#include "generator/geo_objects/region_address_cache.hpp"
+#include "generator/json_streaming_writer.hpp"
 #include "generator/key_value_storage.hpp"
-
 #include "generator/regions/region_info_getter.hpp"
 
-#include "generator/feature_builder.hpp"
-
 #include "indexer/covering_index.hpp"
 
 #include "coding/reader.hpp"
@@ -30,6 +30,10 @@ namespace geo_objects
 void UpdateCoordinates(m2::PointD const & point, base::JSONPtr & json);
 base::JSONPtr AddAddress(std::string const & street, std::string const & house, m2::PointD point,
                          StringUtf8Multilang const & name, KeyValue const & regionKeyValue);
+// Writes the same value as AddAddress() does from fragments of the region.
+void WriteAddress(JsonStreamingWriter & writer, std::string const & street,
+                  std::string const & house, m2::PointD point, StringUtf8Multilang const & name,
+                  RegionAddressFragments const & region);
 
 class GeoObjectMaintainer
 {
@@ -60,6 +64,14 @@ public:
         m2::PointD const & point, std::function<bool(base::GeoObjectId)> && pred) const;
 
     boost::optional<GeoObjectData> GetGeoData(base::GeoObjectId id) const;
+    boost::optional<GeoObjectData> SearchGeoData(
+        m2::PointD point,
+        std::function<bool(GeoObjectMaintainer::GeoObjectData const &)> && pred) const;
+
+    std::shared_ptr<JsonValue> GetRegion(base::GeoObjectId regionId) const
+    {
+      return m_regionIdGetter(regionId);
+    }
 
     std::vector<base::GeoObjectId> SearchObjectsInIndex(m2::PointD const & point) const
     {
@@ -0,0 +1,54 @@
+#include "generator/geo_objects/region_address_cache.hpp"
+
+#include "generator/json_streaming_writer.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+namespace generator
+{
+namespace geo_objects
+{
+RegionAddressFragments MakeRegionAddressFragments(uint64_t regionId, JsonValue const & region)
+{
+  RegionAddressFragments fragments;
+  fragments.m_members = JsonStreamingWriter::MakeMembers(region, {"geometry", "properties"});
+
+  auto const geometry = base::GetJSONOptionalField(region, "geometry");
+  if (geometry && json_is_object(geometry))
+  {
+    auto const coordinates = base::GetJSONOptionalField(geometry, "coordinates");
+    fragments.m_hasPointCoordinates = coordinates && json_array_size(coordinates) == 2;
+    fragments.m_geometry = JsonStreamingWriter::MakeMembers(
+        geometry, fragments.m_hasPointCoordinates ? std::vector<std::string>{"coordinates"}
+                                                  : std::vector<std::string>{});
+  }
+
+  auto const properties = base::GetJSONObligatoryField(region, "properties");
+  fragments.m_properties =
+      JsonStreamingWriter::MakeMembers(properties, {"locales", "kind", "rank", "dref"});
+
+  // Iteration API of jansson takes non-const objects.
+  auto const locales =
+      const_cast<json_t *>(base::GetJSONObligatoryField(properties, "locales"));
+  char const * language;
+  json_t * locale;
+  json_object_foreach(locales, language, locale)
+  {
+    auto & localeFragments = fragments.m_locales[language];
+    localeFragments.m_members = JsonStreamingWriter::MakeMembers(locale, {"name", "address"});
+
+    auto const address = base::GetJSONOptionalField(locale, "address");
+    if (!address || base::JSONIsNull(address))
+      continue;
+
+    auto const isDefault = std::string{language} == "default";
+    localeFragments.m_address = JsonStreamingWriter::MakeMembers(
+        address, isDefault ? std::vector<std::string>{"street", "building"}
+                           : std::vector<std::string>{});
+  }
+
+  fragments.m_dref = KeyValueStorage::SerializeDref(regionId);
+  return fragments;
+}
+}  // namespace geo_objects
+}  // namespace generator
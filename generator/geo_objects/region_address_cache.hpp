@@ -0,0 +1,66 @@
+#pragma once
+
+#include "generator/key_value_storage.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+namespace generator
+{
+namespace geo_objects
+{
+// Parts of a region value serialized once for all geo objects of the region.
+struct RegionAddressFragments
+{
+  struct Locale
+  {
+    // Members besides "name" and "address".
+    std::string m_members;
+    // Address members, the default locale ones are without "street" and "building".
+    boost::optional<std::string> m_address;
+  };
+
+  // Root members besides "geometry" and "properties".
+  std::string m_members;
+  // Geometry members, without "coordinates" when they are a point replaced by objects.
+  boost::optional<std::string> m_geometry;
+  bool m_hasPointCoordinates = false;
+  // Properties members besides "locales", "kind", "rank" and "dref".
+  std::string m_properties;
+  std::map<std::string, Locale> m_locales;
+  std::string m_dref;
+};
+
+RegionAddressFragments MakeRegionAddressFragments(uint64_t regionId, JsonValue const & region);
+
+// No thread-safety: keep one cache per worker.
+class RegionAddressCache
+{
+public:
+  // Returns nullptr if |regionGetter| called on a cache miss finds no region.
+  template <typename RegionGetter>
+  RegionAddressFragments const * Get(uint64_t regionId, RegionGetter && regionGetter)
+  {
+    auto it = m_fragments.find(regionId);
+    if (it == m_fragments.end())
+    {
+      std::shared_ptr<JsonValue> const region = regionGetter();
+      if (!region)
+        return nullptr;
+
+      it = m_fragments.emplace(regionId, MakeRegionAddressFragments(regionId, *region)).first;
+    }
+
+    return &it->second;
+  }
+
+private:
+  std::unordered_map<uint64_t, RegionAddressFragments> m_fragments;
+};
+}  // namespace geo_objects
+}  // namespace generator
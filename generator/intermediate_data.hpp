@@ -2,6 +2,7 @@
 
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_elements.hpp"
+#include "generator/profiler.hpp"
 
 #include "coding/buffered_file_writer.hpp"
 #include "coding/file_reader.hpp"
@@ -250,7 +251,12 @@ public:
   IntermediateDataReader(feature::GenerateInfo const & info);
 
   // TODO |GetNode()|, |lat|, |lon| are used as y, x in real.
-  bool GetNode(Key id, double & lat, double & lon) const { return m_nodes->GetPoint(id, lat, lon); }
+  bool GetNode(Key id, double & lat, double & lon) const
+  {
+    bool const found = m_nodes->GetPoint(id, lat, lon);
+    profiler::Add(found ? profiler::Counter::NodeCacheHits : profiler::Counter::NodeCacheMisses);
+    return found;
+  }
   bool GetWay(Key id, WayElement & e) const { return m_ways.Read(id, e); }
 
   template <typename ToDo>
@@ -0,0 +1,126 @@
+#include "generator/json_streaming_writer.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace generator
+{
+JsonStreamingWriter::JsonStreamingWriter(uint32_t precision) : m_precision{precision} {}
+
+void JsonStreamingWriter::Key(std::string const & key)
+{
+  m_writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+}
+
+void JsonStreamingWriter::String(std::string const & value)
+{
+  m_writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
+}
+
+void JsonStreamingWriter::Double(double value)
+{
+  CHECK(std::isfinite(value), (value));
+
+  char buffer[32];
+  auto length = std::snprintf(buffer, sizeof(buffer), "%.*g", static_cast<int>(m_precision), value);
+  CHECK(length > 0 && static_cast<size_t>(length) + 2 < sizeof(buffer), ());
+
+  // Keep the value real for readers, like jansson does.
+  if (!std::strpbrk(buffer, ".e"))
+  {
+    buffer[length++] = '.';
+    buffer[length++] = '0';
+  }
+
+  m_writer.RawValue(buffer, static_cast<size_t>(length), rapidjson::kNumberType);
+}
+
+void JsonStreamingWriter::Value(json_t const * value)
+{
+  switch (json_typeof(value))
+  {
+  case JSON_OBJECT:
+  {
+    m_writer.StartObject();
+    char const * key;
+    json_t * member;
+    json_object_foreach(const_cast<json_t *>(value), key, member)
+    {
+      m_writer.Key(key);
+      Value(member);
+    }
+    m_writer.EndObject();
+    return;
+  }
+  case JSON_ARRAY:
+    m_writer.StartArray();
+    for (size_t i = 0; i < json_array_size(value); ++i)
+      Value(json_array_get(value, i));
+    m_writer.EndArray();
+    return;
+  case JSON_STRING:
+    m_writer.String(json_string_value(value),
+                    static_cast<rapidjson::SizeType>(json_string_length(value)));
+    return;
+  case JSON_INTEGER: Int(json_integer_value(value)); return;
+  case JSON_REAL: Double(json_real_value(value)); return;
+  case JSON_TRUE: Bool(true); return;
+  case JSON_FALSE: Bool(false); return;
+  case JSON_NULL: Null(); return;
+  }
+  UNREACHABLE();
+}
+
+// static
+std::string JsonStreamingWriter::MakeMembers(json_t const * object,
+                                             std::vector<std::string> const & skippedKeys)
+{
+  CHECK(json_is_object(object), ());
+  return MakeMembers([object, &skippedKeys](JsonStreamingWriter & writer) {
+    char const * key;
+    json_t * value;
+    json_object_foreach(const_cast<json_t *>(object), key, value)
+    {
+      if (std::find(skippedKeys.begin(), skippedKeys.end(), key) != skippedKeys.end())
+        continue;
+
+      writer.Key(key);
+      writer.Value(value);
+    }
+  });
+}
+
+void JsonStreamingWriter::Members(std::string const & members)
+{
+  m_writer.RawMembers(members.data(), members.size());
+}
+
+void JsonStreamingWriter::Clear()
+{
+  m_buffer.Clear();
+  m_writer.Reset(m_buffer);
+}
+
+// JsonStreamingWriter::Writer ---------------------------------------------------------------------
+void JsonStreamingWriter::Writer::RawMembers(char const * json, size_t length)
+{
+  CHECK(!level_stack_.Empty(), ());
+  auto & level = *level_stack_.template Top<Level>();
+  CHECK(!level.inArray && level.valueCount % 2 == 0, ("Members are allowed only in place of key"));
+
+  if (length == 0)
+    return;
+
+  if (level.valueCount > 0)
+    os_->Put(',');
+  for (size_t i = 0; i < length; ++i)
+    os_->Put(json[i]);
+
+  // Spliced members count as a key-value pair for separators of the following members.
+  level.valueCount += 2;
+}
+}  // namespace generator
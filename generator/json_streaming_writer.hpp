@@ -0,0 +1,74 @@
+#pragma once
+
+#include "generator/key_value_storage.hpp"
+
+#include "coding/json.hpp"
+
+#include "3party/rapidjson/stringbuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "3party/jansson/myjansson.hpp"
+
+namespace generator
+{
+// Streaming json writer for key-value storage values. Fields are emitted straight into the buffer
+// without building a jansson DOM, pre-serialized object members can be spliced in by Members().
+class JsonStreamingWriter
+{
+public:
+  explicit JsonStreamingWriter(uint32_t precision = KeyValueStorage::kDefaultPrecision);
+
+  void StartObject() { m_writer.StartObject(); }
+  void EndObject() { m_writer.EndObject(); }
+  void StartArray() { m_writer.StartArray(); }
+  void EndArray() { m_writer.EndArray(); }
+
+  void Key(std::string const & key);
+  void String(std::string const & value);
+  void Null() { m_writer.Null(); }
+  void Bool(bool value) { m_writer.Bool(value); }
+  void Int(int64_t value) { m_writer.Int64(value); }
+  // Writes |value| with the same format and precision as jansson dumps of the storage.
+  void Double(double value);
+  // Writes jansson |value| as is.
+  void Value(json_t const * value);
+  // Splices |members| rendered by MakeMembers() into the current object.
+  void Members(std::string const & members);
+
+  char const * GetString() const { return m_buffer.GetString(); }
+  size_t GetSize() const { return m_buffer.GetSize(); }
+  void Clear();
+
+  // Renders object members written by |fn| without enclosing braces.
+  template <typename Fn>
+  static std::string MakeMembers(Fn && fn)
+  {
+    JsonStreamingWriter writer;
+    writer.StartObject();
+    fn(writer);
+    writer.EndObject();
+    return {writer.GetString() + 1, writer.GetSize() - 2};
+  }
+
+  // Renders members of jansson |object| besides |skippedKeys|.
+  static std::string MakeMembers(json_t const * object,
+                                 std::vector<std::string> const & skippedKeys);
+
+private:
+  class Writer : public rapidjson::Writer<rapidjson::StringBuffer>
+  {
+  public:
+    using rapidjson::Writer<rapidjson::StringBuffer>::Writer;
+
+    void RawMembers(char const * json, size_t length);
+  };
+
+  rapidjson::StringBuffer m_buffer;
+  Writer m_writer{m_buffer};
+  uint32_t m_precision;
+};
+}  // namespace generator
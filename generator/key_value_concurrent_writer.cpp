@@ -1,6 +1,7 @@
 #include "generator/key_value_concurrent_writer.hpp"
 
 #include "generator/key_value_storage.hpp"
+#include "generator/profiler.hpp"
 
 #include <cstring>
 #include <stdexcept>
@@ -62,6 +63,18 @@ void KeyValueConcurrentWriter::Write(base::GeoObjectId const & id, JsonValue con
     FlushBuffer();
 }
 
+void KeyValueConcurrentWriter::Write(base::GeoObjectId const & id,
+                                     JsonStreamingWriter const & jsonValue)
+{
+  CHECK(jsonValue.GetSize() != 0, ());
+  m_keyValueBuffer << KeyValueStorage::SerializeDref(id.GetEncodedId()) << " ";
+  m_keyValueBuffer.write(jsonValue.GetString(), jsonValue.GetSize());
+  m_keyValueBuffer << "\n";
+
+  if (static_cast<size_t>(m_keyValueBuffer.tellp()) + 1'000 >= m_bufferSize)
+    FlushBuffer();
+}
+
 void KeyValueConcurrentWriter::FlushBuffer()
 {
   auto const & data = m_keyValueBuffer.str();
@@ -71,6 +84,7 @@ void KeyValueConcurrentWriter::FlushBuffer()
   auto writed = ::write(m_keyValueFile, data.data(), data.size());
   // Error if ::write() interrupted by a signal.
   CHECK(static_cast<size_t>(writed) == data.size(), ());
+  profiler::Add(profiler::Counter::BytesWritten, data.size());
   m_keyValueBuffer.str({});
 }
 }  // namespace generator
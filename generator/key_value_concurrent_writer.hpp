@@ -1,3 +1,4 @@
+#include "generator/json_streaming_writer.hpp"
 #include "generator/key_value_storage.hpp"
 
 #include "base/geo_object_id.hpp"
@@ -19,6 +20,7 @@ public:
 
   // No thread-safety.
   void Write(base::GeoObjectId const & id, JsonValue const & jsonValue);
+  void Write(base::GeoObjectId const & id, JsonStreamingWriter const & jsonValue);
 
 private:
   int m_keyValueFile{-1};
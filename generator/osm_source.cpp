@@ -3,6 +3,7 @@
 #include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/profiler.hpp"
 #include "generator/towns_dumper.hpp"
 #include "generator/translator_factory.hpp"
 
@@ -306,7 +307,13 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
     auto const chunkId = m_elementCounter / m_chunkSize;
     auto const chunkTaskId = chunkId % m_taskCount;
     if (chunkTaskId == m_taskId)
-      return Read(element);
+    {
+      if (!Read(element))
+        return false;
+
+      profiler::Add(profiler::Counter::ElementsRead);
+      return true;
+    }
 
     ++m_pos;
     ++m_elementCounter;
@@ -385,6 +392,7 @@ bool ProcessorOsmElementsFromXml::TryReadFromQueue(OsmElement & element)
 
   element = m_queue.front();
   m_queue.pop();
+  profiler::Add(profiler::Counter::ElementsRead);
   return true;
 }
 
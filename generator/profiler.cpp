@@ -0,0 +1,270 @@
+#include "generator/profiler.hpp"
+
+#include "generator/json_streaming_writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include <sys/resource.h>
+
+namespace generator
+{
+namespace profiler
+{
+namespace
+{
+// Profiles are read by humans and scripts, microseconds are precise enough.
+uint32_t constexpr kJsonPrecision = 9;
+
+thread_local size_t g_phaseDepth = 0;
+
+// RSS high-water mark since the last reset in kilobytes.
+uint64_t GetRssHighWaterMarkKb()
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, std::strlen("VmHWM:"), "VmHWM:") == 0)
+      return std::stoull(line.substr(std::strlen("VmHWM:")));
+  }
+  return GetPeakRssKb();
+}
+
+// Resets the RSS high-water mark of the process to the current RSS.
+void ResetRssHighWaterMark()
+{
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+}
+}  // namespace
+
+std::string DebugPrint(Counter counter)
+{
+  switch (counter)
+  {
+  case Counter::ElementsRead: return "elements_read";
+  case Counter::FeaturesEmitted: return "features_emitted";
+  case Counter::BytesWritten: return "bytes_written";
+  case Counter::NodeCacheHits: return "node_cache_hits";
+  case Counter::NodeCacheMisses: return "node_cache_misses";
+  case Counter::BorderTests: return "border_tests";
+  case Counter::Count: break;
+  }
+  UNREACHABLE();
+}
+
+// static
+Profiler & Profiler::Instance()
+{
+  static Profiler instance;
+  return instance;
+}
+
+void Profiler::Enable()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (IsEnabled())
+    return;
+
+  m_timer.Reset();
+  m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::Disable()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_enabled.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::GetCounter(Counter counter) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t sum = 0;
+  for (auto const & counters : m_threadCounters)
+    sum += (*counters)[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+  return sum;
+}
+
+std::vector<Phase> Profiler::GetPhases() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_phases;
+}
+
+void Profiler::AddPhase(Phase && phase)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_phases.emplace_back(std::move(phase));
+}
+
+size_t Profiler::StartRssPeak()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // The high-water mark is reset, so the peak reached so far is kept for the running trackings.
+  auto const highWaterMarkKb = GetRssHighWaterMarkKb();
+  for (auto & peak : m_rssPeaksKb)
+    peak.second = std::max(peak.second, highWaterMarkKb);
+  m_peakRssKb = std::max(m_peakRssKb, highWaterMarkKb);
+  ResetRssHighWaterMark();
+
+  auto const peakId = m_nextRssPeakId++;
+  m_rssPeaksKb.emplace(peakId, 0);
+  return peakId;
+}
+
+uint64_t Profiler::FinishRssPeak(size_t peakId)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto peak = GetRssHighWaterMarkKb();
+  auto const it = m_rssPeaksKb.find(peakId);
+  CHECK(it != m_rssPeaksKb.end(), (peakId));
+  peak = std::max(peak, it->second);
+  m_rssPeaksKb.erase(it);
+  return peak;
+}
+
+uint64_t Profiler::GetTotalPeakRssKb() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto peak = std::max(m_peakRssKb, GetRssHighWaterMarkKb());
+  for (auto const & phase : m_phases)
+    peak = std::max(peak, phase.m_peakRssKb);
+  return peak;
+}
+
+void Profiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto & counters : m_threadCounters)
+  {
+    for (auto & value : *counters)
+      value.store(0, std::memory_order_relaxed);
+  }
+  m_phases.clear();
+  m_peakRssKb = 0;
+}
+
+std::string Profiler::ToJson() const
+{
+  auto const phases = GetPhases();
+
+  JsonStreamingWriter writer(kJsonPrecision);
+  writer.StartObject();
+
+  writer.Key("seconds");
+  writer.Double(GetElapsedSeconds());
+  writer.Key("peak_rss_kb");
+  writer.Int(static_cast<int64_t>(GetTotalPeakRssKb()));
+
+  writer.Key("phases");
+  writer.StartArray();
+  for (auto const & phase : phases)
+  {
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(phase.m_name);
+    writer.Key("depth");
+    writer.Int(static_cast<int64_t>(phase.m_depth));
+    writer.Key("start_seconds");
+    writer.Double(phase.m_startSeconds);
+    writer.Key("seconds");
+    writer.Double(phase.m_seconds);
+    writer.Key("peak_rss_kb");
+    writer.Int(static_cast<int64_t>(phase.m_peakRssKb));
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  writer.Key("counters");
+  writer.StartObject();
+  for (size_t i = 0; i < kCountersCount; ++i)
+  {
+    auto const counter = static_cast<Counter>(i);
+    writer.Key(DebugPrint(counter));
+    writer.Int(static_cast<int64_t>(GetCounter(counter)));
+  }
+  writer.EndObject();
+
+  writer.EndObject();
+  return {writer.GetString(), writer.GetSize()};
+}
+
+bool Profiler::DumpJson(std::string const & path) const
+{
+  std::ofstream stream(path);
+  if (!stream)
+  {
+    LOG(LERROR, ("Cannot open", path, "for the profile."));
+    return false;
+  }
+
+  stream << ToJson() << "\n";
+  return static_cast<bool>(stream);
+}
+
+Profiler::ThreadCounters & Profiler::GetThreadCounters()
+{
+  thread_local ThreadCounters * counters = nullptr;
+  if (counters)
+    return *counters;
+
+  auto block = std::make_unique<ThreadCounters>();
+  for (auto & value : *block)
+    value.store(0, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  counters = block.get();
+  m_threadCounters.emplace_back(std::move(block));
+  return *counters;
+}
+
+uint64_t GetPeakRssKb()
+{
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#if defined(__APPLE__)
+  // macOS reports bytes.
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+}
+
+ScopedPhase::ScopedPhase(std::string const & name)
+  : m_enabled(Profiler::Instance().IsEnabled())
+{
+  if (!m_enabled)
+    return;
+
+  m_name = name;
+  m_depth = g_phaseDepth++;
+  m_startSeconds = Profiler::Instance().GetElapsedSeconds();
+  m_rssPeakId = Profiler::Instance().StartRssPeak();
+  m_timer.Reset();
+}
+
+ScopedPhase::~ScopedPhase()
+{
+  if (!m_enabled)
+    return;
+
+  --g_phaseDepth;
+
+  Phase phase;
+  phase.m_name = std::move(m_name);
+  phase.m_depth = m_depth;
+  phase.m_startSeconds = m_startSeconds;
+  phase.m_seconds = m_timer.ElapsedSeconds();
+  phase.m_peakRssKb = Profiler::Instance().FinishRssPeak(m_rssPeakId);
+  Profiler::Instance().AddPhase(std::move(phase));
+}
+}  // namespace profiler
+}  // namespace generator
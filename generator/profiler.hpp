@@ -0,0 +1,130 @@
+#pragma once
+
+#include "base/timer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+namespace profiler
+{
+enum class Counter : uint8_t
+{
+  ElementsRead,
+  FeaturesEmitted,
+  BytesWritten,
+  NodeCacheHits,
+  NodeCacheMisses,
+  BorderTests,
+
+  Count
+};
+
+std::string DebugPrint(Counter counter);
+
+struct Phase
+{
+  std::string m_name;
+  // Nesting level of the phase, top-level phases have zero depth.
+  size_t m_depth = 0;
+  double m_startSeconds = 0.0;
+  double m_seconds = 0.0;
+  // Peak RSS of the process during the phase.
+  uint64_t m_peakRssKb = 0;
+};
+
+// Collects phase timings and counters of the generator. Counters are accumulated in per-thread
+// blocks so hot paths do not contend on shared cache lines. While disabled every update costs
+// a single relaxed load.
+class Profiler
+{
+public:
+  static Profiler & Instance();
+
+  void Enable();
+  // Stops collecting, collected counters and phases are kept until Clear().
+  void Disable();
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  void Add(Counter counter, uint64_t value)
+  {
+    if (!IsEnabled())
+      return;
+
+    auto & slot = GetThreadCounters()[static_cast<size_t>(counter)];
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  // Sum of |counter| over all threads.
+  uint64_t GetCounter(Counter counter) const;
+  std::vector<Phase> GetPhases() const;
+
+  void AddPhase(Phase && phase);
+
+  // Starts tracking of peak RSS from the current RSS and returns the id of the tracking. The RSS
+  // high-water mark of the process is reset on Linux, elsewhere peaks are process-wide.
+  size_t StartRssPeak();
+  // Stops the tracking |peakId| and returns its peak RSS in kilobytes.
+  uint64_t FinishRssPeak(size_t peakId);
+  // Peak RSS of the process since the last Clear() in kilobytes.
+  uint64_t GetTotalPeakRssKb() const;
+  double GetElapsedSeconds() const { return m_timer.ElapsedSeconds(); }
+
+  // Zeroes counters and the peak RSS, drops recorded phases.
+  void Clear();
+
+  std::string ToJson() const;
+  bool DumpJson(std::string const & path) const;
+
+private:
+  static auto constexpr kCountersCount = static_cast<size_t>(Counter::Count);
+  using ThreadCounters = std::array<std::atomic<uint64_t>, kCountersCount>;
+
+  Profiler() = default;
+
+  ThreadCounters & GetThreadCounters();
+
+  std::atomic<bool> m_enabled{false};
+  base::Timer m_timer;
+
+  mutable std::mutex m_mutex;
+  // Blocks are never freed: threads keep pointers to them for their lifetime.
+  std::vector<std::unique_ptr<ThreadCounters>> m_threadCounters;
+  std::vector<Phase> m_phases;
+  // Peaks of the running trackings up to the last reset of the RSS high-water mark.
+  std::map<size_t, uint64_t> m_rssPeaksKb;
+  size_t m_nextRssPeakId = 0;
+  // Peak RSS up to the last reset of the RSS high-water mark.
+  uint64_t m_peakRssKb = 0;
+};
+
+inline void Add(Counter counter, uint64_t value = 1) { Profiler::Instance().Add(counter, value); }
+
+// Peak resident set size of the process in kilobytes.
+uint64_t GetPeakRssKb();
+
+// Records wall time of the enclosing scope as a phase of the profiler.
+class ScopedPhase
+{
+public:
+  explicit ScopedPhase(std::string const & name);
+  ~ScopedPhase();
+
+private:
+  bool m_enabled;
+  std::string m_name;
+  size_t m_depth = 0;
+  double m_startSeconds = 0.0;
+  size_t m_rssPeakId = 0;
+  base::Timer m_timer;
+};
+}  // namespace profiler
+}  // namespace generator
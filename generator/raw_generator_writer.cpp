@@ -1,5 +1,7 @@
 #include "generator/raw_generator_writer.hpp"
 
+#include "generator/profiler.hpp"
+
 #include "coding/varint.hpp"
 
 #include "base/file_name_utils.hpp"
@@ -67,6 +69,8 @@ void RawGeneratorWriter::Write(std::vector<ProcessedData> const & vecChunks)
       auto const & buffer = chunk.m_buffer;
       WriteVarUint(*writer, static_cast<uint32_t>(buffer.size()));
       writer->Write(buffer.data(), buffer.size());
+      profiler::Add(profiler::Counter::FeaturesEmitted);
+      profiler::Add(profiler::Counter::BytesWritten, buffer.size());
     }
   }
 }
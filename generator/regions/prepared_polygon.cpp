@@ -0,0 +1,364 @@
+#include "generator/regions/prepared_polygon.hpp"
+
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/simplification.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/geometry.hpp>
+
+namespace generator
+{
+namespace regions
+{
+namespace
+{
+// Relative tolerance of orientation tests. Results within it are considered ambiguous.
+double constexpr kRelativeEps = 1e-9;
+size_t constexpr kMaxGridSize = 256;
+
+// Returns sign of orientation of |c| relative to the line |a|, |b| or 0 if |c| is too close
+// to the line.
+int Orientation(BoostPoint const & a, BoostPoint const & b, BoostPoint const & c)
+{
+  auto const lhs = (b.get<0>() - a.get<0>()) * (c.get<1>() - a.get<1>());
+  auto const rhs = (b.get<1>() - a.get<1>()) * (c.get<0>() - a.get<0>());
+  auto const eps = kRelativeEps * (std::fabs(lhs) + std::fabs(rhs));
+  auto const cross = lhs - rhs;
+  if (cross > eps)
+    return 1;
+  if (cross < -eps)
+    return -1;
+  return 0;
+}
+
+bool AreBoxesIntersected(BoostPoint const & a1, BoostPoint const & a2, BoostPoint const & b1,
+                         BoostPoint const & b2)
+{
+  return std::max(a1.get<0>(), a2.get<0>()) >= std::min(b1.get<0>(), b2.get<0>()) &&
+         std::max(b1.get<0>(), b2.get<0>()) >= std::min(a1.get<0>(), a2.get<0>()) &&
+         std::max(a1.get<1>(), a2.get<1>()) >= std::min(b1.get<1>(), b2.get<1>()) &&
+         std::max(b1.get<1>(), b2.get<1>()) >= std::min(a1.get<1>(), a2.get<1>());
+}
+
+// Returns true if segments intersect or touch. Nearly touching segments are also reported as
+// intersected, so false result is reliable.
+bool MayIntersect(BoostPoint const & a1, BoostPoint const & a2, BoostPoint const & b1,
+                  BoostPoint const & b2)
+{
+  if (!AreBoxesIntersected(a1, a2, b1, b2))
+    return false;
+
+  auto const o1 = Orientation(a1, a2, b1);
+  auto const o2 = Orientation(a1, a2, b2);
+  auto const o3 = Orientation(b1, b2, a1);
+  auto const o4 = Orientation(b1, b2, a2);
+  return o1 * o2 <= 0 && o3 * o4 <= 0;
+}
+
+template <typename Ring, typename Fn>
+void ForEachRingEdge(Ring const & ring, Fn && fn)
+{
+  for (size_t i = 1; i < ring.size(); ++i)
+    fn(ring[i - 1], ring[i]);
+}
+
+template <typename Fn>
+void ForEachPolygonEdge(BoostPolygon const & polygon, Fn && fn)
+{
+  ForEachRingEdge(polygon.outer(), fn);
+  for (auto const & inner : polygon.inners())
+    ForEachRingEdge(inner, fn);
+}
+
+template <typename Ring>
+Ring SimplifyRing(Ring const & ring, double tolerance)
+{
+  std::vector<m2::PointD> points;
+  points.reserve(ring.size());
+  for (auto const & p : ring)
+    points.emplace_back(p.template get<0>(), p.template get<1>());
+
+  Ring simplified;
+  auto const addPoint = [&simplified](m2::PointD const & p) {
+    boost::geometry::append(simplified, BoostPoint{p.x, p.y});
+  };
+  SimplifyDP(points.begin(), points.end(), tolerance * tolerance,
+             m2::SquaredDistanceFromSegmentToPoint<m2::PointD>(), addPoint);
+  // SimplifyDP() does not add the last point.
+  if (!points.empty())
+    addPoint(points.back());
+  return simplified;
+}
+}  // namespace
+
+PreparedPolygon::PreparedPolygon(std::shared_ptr<BoostPolygon const> const & polygon)
+  : m_polygon(polygon)
+{
+  CHECK(m_polygon, ());
+  boost::geometry::envelope(*m_polygon, m_rect);
+  m_area = boost::geometry::area(*m_polygon);
+  ForEachPolygonEdge(*m_polygon, [&](BoostPoint const & a, BoostPoint const & b) {
+    m_edges.emplace_back(a, b);
+  });
+  BuildIndex();
+}
+
+void PreparedPolygon::BuildIndex()
+{
+  auto const gridSize = static_cast<size_t>(std::sqrt(static_cast<double>(m_edges.size())));
+  m_gridSize = base::clamp(gridSize, size_t{1}, kMaxGridSize);
+  m_cellWidth = (m_rect.max_corner().get<0>() - m_rect.min_corner().get<0>()) / m_gridSize;
+  m_cellHeight = (m_rect.max_corner().get<1>() - m_rect.min_corner().get<1>()) / m_gridSize;
+
+  auto const forEachEdgeSpan = [&](auto && fn) {
+    for (size_t i = 0; i < m_edges.size(); ++i)
+    {
+      auto const & edge = m_edges[i];
+      auto const minColumn = GetColumn(std::min(edge.first.get<0>(), edge.second.get<0>()));
+      auto const maxColumn = GetColumn(std::max(edge.first.get<0>(), edge.second.get<0>()));
+      auto const minRow = GetRow(std::min(edge.first.get<1>(), edge.second.get<1>()));
+      auto const maxRow = GetRow(std::max(edge.first.get<1>(), edge.second.get<1>()));
+      fn(static_cast<uint32_t>(i), minColumn, maxColumn, minRow, maxRow);
+    }
+  };
+
+  // Lists are filled in two passes: counting and placing.
+  auto const fill = [&](IndexLists & lists, size_t listsCount, auto && forEachList) {
+    lists.m_offsets.assign(listsCount + 1, 0);
+    forEachEdgeSpan([&](uint32_t, size_t minColumn, size_t maxColumn, size_t minRow,
+                        size_t maxRow) {
+      forEachList(minColumn, maxColumn, minRow, maxRow,
+                  [&](size_t list) { ++lists.m_offsets[list + 1]; });
+    });
+    for (size_t i = 1; i < lists.m_offsets.size(); ++i)
+      lists.m_offsets[i] += lists.m_offsets[i - 1];
+
+    auto positions = lists.m_offsets;
+    lists.m_items.resize(lists.m_offsets.back());
+    forEachEdgeSpan([&](uint32_t edge, size_t minColumn, size_t maxColumn, size_t minRow,
+                        size_t maxRow) {
+      forEachList(minColumn, maxColumn, minRow, maxRow,
+                  [&](size_t list) { lists.m_items[positions[list]++] = edge; });
+    });
+  };
+
+  fill(m_rows, m_gridSize,
+       [](size_t, size_t, size_t minRow, size_t maxRow, auto && fn) {
+         for (auto row = minRow; row <= maxRow; ++row)
+           fn(row);
+       });
+  fill(m_cells, m_gridSize * m_gridSize,
+       [&](size_t minColumn, size_t maxColumn, size_t minRow, size_t maxRow, auto && fn) {
+         for (auto row = minRow; row <= maxRow; ++row)
+         {
+           for (auto column = minColumn; column <= maxColumn; ++column)
+             fn(row * m_gridSize + column);
+         }
+       });
+}
+
+size_t PreparedPolygon::GetRow(double y) const
+{
+  if (m_cellHeight <= 0.0)
+    return 0;
+
+  auto const row = (y - m_rect.min_corner().get<1>()) / m_cellHeight;
+  return base::clamp(static_cast<size_t>(std::max(row, 0.0)), size_t{0}, m_gridSize - 1);
+}
+
+size_t PreparedPolygon::GetColumn(double x) const
+{
+  if (m_cellWidth <= 0.0)
+    return 0;
+
+  auto const column = (x - m_rect.min_corner().get<0>()) / m_cellWidth;
+  return base::clamp(static_cast<size_t>(std::max(column, 0.0)), size_t{0}, m_gridSize - 1);
+}
+
+PreparedPolygon::Location PreparedPolygon::Locate(BoostPoint const & point) const
+{
+  if (!boost::geometry::covered_by(point, m_rect))
+    return Location::Outside;
+
+  auto const x = point.get<0>();
+  auto const y = point.get<1>();
+  auto const row = GetRow(y);
+  bool inside = false;
+  for (auto i = m_rows.m_offsets[row]; i < m_rows.m_offsets[row + 1]; ++i)
+  {
+    auto const & a = m_edges[m_rows.m_items[i]].first;
+    auto const & b = m_edges[m_rows.m_items[i]].second;
+    if (AreBoxesIntersected(a, b, point, point) && Orientation(a, b, point) == 0)
+      return Location::Ambiguous;
+
+    if ((a.get<1>() > y) == (b.get<1>() > y))
+      continue;
+
+    // Crossing of the edge and the horizontal ray from |point| to the right.
+    auto const crossX = a.get<0>() + (y - a.get<1>()) * (b.get<0>() - a.get<0>()) /
+                                         (b.get<1>() - a.get<1>());
+    if (x < crossX)
+      inside = !inside;
+  }
+
+  return inside ? Location::Inside : Location::Outside;
+}
+
+bool PreparedPolygon::IntersectsBoundary(PreparedPolygon const & other) const
+{
+  for (auto const & edge : other.m_edges)
+  {
+    auto const & a = edge.first;
+    auto const & b = edge.second;
+    if (!AreBoxesIntersected(a, b, m_rect.min_corner(), m_rect.max_corner()))
+      continue;
+
+    auto const minColumn = GetColumn(std::min(a.get<0>(), b.get<0>()));
+    auto const maxColumn = GetColumn(std::max(a.get<0>(), b.get<0>()));
+    auto const minRow = GetRow(std::min(a.get<1>(), b.get<1>()));
+    auto const maxRow = GetRow(std::max(a.get<1>(), b.get<1>()));
+    for (auto row = minRow; row <= maxRow; ++row)
+    {
+      for (auto column = minColumn; column <= maxColumn; ++column)
+      {
+        auto const cell = row * m_gridSize + column;
+        for (auto i = m_cells.m_offsets[cell]; i < m_cells.m_offsets[cell + 1]; ++i)
+        {
+          auto const & e = m_edges[m_cells.m_items[i]];
+          if (MayIntersect(a, b, e.first, e.second))
+            return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+bool PreparedPolygon::HasHolesInside(PreparedPolygon const & other) const
+{
+  for (auto const & inner : m_polygon->inners())
+  {
+    if (inner.empty())
+      continue;
+
+    if (other.Locate(inner.front()) != Location::Outside)
+      return true;
+  }
+
+  return false;
+}
+
+boost::optional<bool> PreparedPolygon::Covers(PreparedPolygon const & other) const
+{
+  if (!boost::geometry::covered_by(other.m_rect, m_rect))
+    return false;
+
+  bool ambiguous = false;
+  for (auto const & edge : other.m_edges)
+  {
+    auto const location = Locate(edge.first);
+    if (location == Location::Outside)
+      return false;
+    if (location == Location::Ambiguous)
+      ambiguous = true;
+  }
+
+  if (ambiguous || IntersectsBoundary(other))
+    return {};
+
+  // Boundaries do not intersect and all vertices of |other| are inside, so |other| is covered
+  // unless some hole of the polygon is inside |other|.
+  if (HasHolesInside(other))
+    return {};
+
+  return true;
+}
+
+boost::optional<double> PreparedPolygon::CalculateIntersectionArea(
+    PreparedPolygon const & other) const
+{
+  if (!boost::geometry::intersects(other.m_rect, m_rect))
+    return 0.0;
+
+  if (IntersectsBoundary(other))
+    return {};
+
+  // Boundaries do not intersect, so each ring lies entirely either inside or outside of
+  // the other polygon.
+  if (m_edges.empty() || other.m_edges.empty())
+    return {};
+
+  auto const otherLocation = Locate(other.m_edges.front().first);
+  auto const location = other.Locate(m_edges.front().first);
+  if (otherLocation == Location::Outside && location == Location::Outside)
+    return 0.0;
+
+  if (otherLocation == Location::Inside && !HasHolesInside(other))
+    return other.m_area;
+
+  if (location == Location::Inside && !other.HasHolesInside(*this))
+    return m_area;
+
+  return {};
+}
+
+std::unique_ptr<PreparedPolygon> MakeApproximation(PreparedPolygon const & polygon,
+                                                   double distance)
+{
+  // A closed ring has at least four points.
+  size_t constexpr kMinRingSize = 4;
+
+  auto const tolerance = std::fabs(distance);
+  auto const & source = polygon.GetPolygon();
+  BoostPolygon simplified;
+  simplified.outer() = SimplifyRing(source.outer(), tolerance);
+  if (simplified.outer().size() < kMinRingSize)
+    return {};
+
+  for (auto const & inner : source.inners())
+  {
+    auto simplifiedInner = SimplifyRing(inner, tolerance);
+    if (simplifiedInner.size() >= kMinRingSize)
+      simplified.inners().push_back(std::move(simplifiedInner));
+  }
+
+  boost::geometry::correct(simplified);
+  if (!boost::geometry::is_valid(simplified))
+    return {};
+
+  namespace buffer = boost::geometry::strategy::buffer;
+  boost::geometry::model::multi_polygon<BoostPolygon> buffered;
+  boost::geometry::buffer(simplified, buffered, buffer::distance_symmetric<double>(2 * distance),
+                          buffer::side_straight(), buffer::join_miter(), buffer::end_flat(),
+                          buffer::point_square());
+  if (buffered.empty())
+    return {};
+
+  // A shrunk polygon may fall apart, any of its parts is still covered by the source polygon.
+  auto const largest = std::max_element(
+      std::begin(buffered), std::end(buffered), [](auto const & l, auto const & r) {
+        return boost::geometry::area(l) < boost::geometry::area(r);
+      });
+  if (distance > 0 && buffered.size() != 1)
+    return {};
+
+  auto approximation = std::make_unique<PreparedPolygon>(
+      std::make_shared<BoostPolygon const>(std::move(*largest)));
+
+  // Simplification and buffering have no strict guarantees, so the result is checked.
+  auto const isConservative = distance > 0 ? approximation->Covers(polygon)
+                                           : polygon.Covers(*approximation);
+  if (!isConservative || !*isConservative)
+    return {};
+
+  return approximation;
+}
+}  // namespace regions
+}  // namespace generator
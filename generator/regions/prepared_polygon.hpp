@@ -0,0 +1,78 @@
+#pragma once
+
+#include "generator/regions/region_base.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+namespace generator
+{
+namespace regions
+{
+// PreparedPolygon keeps an index of polygon edges to answer repeated point and polygon
+// containment queries without boost::geometry, which rebuilds its sections on every call.
+// The index consists of horizontal bands for point location and a uniform grid of cells
+// for edge intersection tests. Queries return boost::none when a geometry is too close
+// to the border to decide robustly, and the caller must fall back to exact algorithms.
+class PreparedPolygon
+{
+public:
+  enum class Location
+  {
+    Inside,
+    Outside,
+    Ambiguous
+  };
+
+  explicit PreparedPolygon(std::shared_ptr<BoostPolygon const> const & polygon);
+
+  BoostPolygon const & GetPolygon() const { return *m_polygon; }
+  BoostRect const & GetRect() const { return m_rect; }
+  double GetArea() const { return m_area; }
+
+  // Points out of the polygon rect are located outside without any tolerance.
+  Location Locate(BoostPoint const & point) const;
+  // Returns whether |other| is covered by the polygon.
+  boost::optional<bool> Covers(PreparedPolygon const & other) const;
+  // Returns area of intersection of the polygon and |other|.
+  boost::optional<double> CalculateIntersectionArea(PreparedPolygon const & other) const;
+
+private:
+  using Segment = std::pair<BoostPoint, BoostPoint>;
+
+  // Compressed lists of edge indexes: edges of list i are in
+  // m_items[m_offsets[i], m_offsets[i + 1]).
+  struct IndexLists
+  {
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_items;
+  };
+
+  void BuildIndex();
+  size_t GetRow(double y) const;
+  size_t GetColumn(double x) const;
+  bool IntersectsBoundary(PreparedPolygon const & other) const;
+  bool HasHolesInside(PreparedPolygon const & other) const;
+
+  std::shared_ptr<BoostPolygon const> m_polygon;
+  BoostRect m_rect;
+  double m_area = 0.0;
+  std::vector<Segment> m_edges;
+  size_t m_gridSize = 1;
+  double m_cellWidth = 0.0;
+  double m_cellHeight = 0.0;
+  IndexLists m_rows;
+  IndexLists m_cells;
+};
+
+// Makes a simplified polygon that covers |polygon| if |distance| is positive or is covered by it
+// if |distance| is negative. The polygon is simplified with the tolerance |distance| and then
+// buffered by 2 * |distance|. Returns nullptr if the approximation is not reliable.
+std::unique_ptr<PreparedPolygon> MakeApproximation(PreparedPolygon const & polygon,
+                                                   double distance);
+}  // namespace regions
+}  // namespace generator
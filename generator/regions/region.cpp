@@ -19,10 +19,27 @@ namespace generator
 {
 namespace regions
 {
+namespace
+{
+// Polygons with less points are tested precisely at once.
+size_t constexpr kMinApproximatedPolygonSize = 1000;
+// Approximation tolerance relative to the polygon rect size.
+double constexpr kApproximationRelativeTolerance = 1e-3;
+
+size_t GetPointsCount(BoostPolygon const & polygon)
+{
+  auto count = polygon.outer().size();
+  for (auto const & inner : polygon.inners())
+    count += inner.size();
+  return count;
+}
+}  // namespace
+
 Region::Region(FeatureBuilder const & fb, RegionDataProxy const & rd)
   : RegionWithName(fb.GetParams().name)
   , RegionWithData(rd)
   , m_polygon(std::make_shared<BoostPolygon>())
+  , m_preparedPolygon(std::make_shared<PreparedPolygonHolder>())
 {
   FillPolygon(fb);
   boost::geometry::envelope(*m_polygon, m_rect);
@@ -115,19 +132,65 @@ bool Region::IsLocality() const { return GetPlaceType() >= PlaceType::City; }
 void Region::SetPolygon(std::shared_ptr<BoostPolygon> const & polygon)
 {
   m_polygon = polygon;
+  m_preparedPolygon = std::make_shared<PreparedPolygonHolder>();
   m_rect = {};
   boost::geometry::envelope(*m_polygon, m_rect);
   m_area = boost::geometry::area(*m_polygon);
   CHECK_GREATER_OR_EQUAL(m_area, 0.0, ());
 }
 
+Region::PreparedPolygonHolder const & Region::GetPreparedPolygonHolder() const
+{
+  CHECK(m_polygon, ());
+  CHECK(m_preparedPolygon, ());
+
+  auto & holder = *m_preparedPolygon;
+  std::call_once(holder.m_prepareFlag, [&] {
+    holder.m_polygon = std::make_unique<PreparedPolygon>(m_polygon);
+    if (GetPointsCount(*m_polygon) < kMinApproximatedPolygonSize)
+      return;
+
+    auto const rectSize = std::max(m_rect.max_corner().get<0>() - m_rect.min_corner().get<0>(),
+                                   m_rect.max_corner().get<1>() - m_rect.min_corner().get<1>());
+    auto const tolerance = kApproximationRelativeTolerance * rectSize;
+    holder.m_outer = MakeApproximation(*holder.m_polygon, tolerance);
+    holder.m_inner = MakeApproximation(*holder.m_polygon, -tolerance);
+  });
+  return holder;
+}
+
 bool Region::Contains(Region const & smaller) const
 {
   CHECK(m_polygon, ());
   CHECK(smaller.m_polygon, ());
 
-  return boost::geometry::covered_by(smaller.m_rect, m_rect) &&
-         boost::geometry::covered_by(*smaller.m_polygon, *m_polygon);
+  if (!boost::geometry::covered_by(smaller.m_rect, m_rect))
+    return false;
+
+  auto const & holder = GetPreparedPolygonHolder();
+  auto const & smallerHolder = smaller.GetPreparedPolygonHolder();
+  if (holder.m_inner)
+  {
+    auto const & smallerOuter = smallerHolder.m_outer ? *smallerHolder.m_outer
+                                                      : *smallerHolder.m_polygon;
+    auto const covers = holder.m_inner->Covers(smallerOuter);
+    if (covers && *covers)
+      return true;
+  }
+
+  if (holder.m_outer)
+  {
+    auto const & smallerInner = smallerHolder.m_inner ? *smallerHolder.m_inner
+                                                      : *smallerHolder.m_polygon;
+    auto const covers = holder.m_outer->Covers(smallerInner);
+    if (covers && !*covers)
+      return false;
+  }
+
+  if (auto const covers = holder.m_polygon->Covers(*smallerHolder.m_polygon))
+    return *covers;
+
+  return boost::geometry::covered_by(*smaller.m_polygon, *m_polygon);
 }
 
 double Region::CalculateOverlapPercentage(Region const & other) const
@@ -138,10 +201,21 @@ double Region::CalculateOverlapPercentage(Region const & other) const
   if (!boost::geometry::intersects(other.m_rect, m_rect))
     return 0.0;
 
+  auto const & holder = GetPreparedPolygonHolder();
+  auto const & otherHolder = other.GetPreparedPolygonHolder();
+  if (holder.m_outer && otherHolder.m_outer)
+  {
+    auto const area = holder.m_outer->CalculateIntersectionArea(*otherHolder.m_outer);
+    if (area && *area == 0.0)
+      return 0.0;
+  }
+
+  auto const min = std::min(other.m_area, m_area);
+  if (auto const area = holder.m_polygon->CalculateIntersectionArea(*otherHolder.m_polygon))
+    return (*area / min) * 100;
+
   std::vector<BoostPolygon> coll;
   boost::geometry::intersection(*other.m_polygon, *m_polygon, coll);
-  auto const min =
-      std::min(boost::geometry::area(*other.m_polygon), boost::geometry::area(*m_polygon));
   auto const binOp = [](double x, BoostPolygon const & y) { return x + boost::geometry::area(y); };
   auto const sum = std::accumulate(std::begin(coll), std::end(coll), 0., binOp);
   return (sum / min) * 100;
@@ -173,8 +247,23 @@ bool Region::Contains(BoostPoint const & point) const
 {
   CHECK(m_polygon, ());
 
-  return boost::geometry::covered_by(point, m_rect) &&
-         boost::geometry::covered_by(point, *m_polygon);
+  if (!boost::geometry::covered_by(point, m_rect))
+    return false;
+
+  auto const & holder = GetPreparedPolygonHolder();
+  if (holder.m_outer && holder.m_outer->Locate(point) == PreparedPolygon::Location::Outside)
+    return false;
+  if (holder.m_inner && holder.m_inner->Locate(point) == PreparedPolygon::Location::Inside)
+    return true;
+
+  switch (holder.m_polygon->Locate(point))
+  {
+  case PreparedPolygon::Location::Inside: return true;
+  case PreparedPolygon::Location::Outside: return false;
+  case PreparedPolygon::Location::Ambiguous: break;
+  }
+
+  return boost::geometry::covered_by(point, *m_polygon);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2,9 +2,11 @@
 
 #include "generator/feature_builder.hpp"
 #include "generator/regions/place_point.hpp"
+#include "generator/regions/prepared_polygon.hpp"
 #include "generator/regions/region_base.hpp"
 
 #include <memory>
+#include <mutex>
 
 namespace feature
 {
@@ -54,10 +56,26 @@ public:
   double GetArea() const { return m_area; }
 
 private:
+  // Polygons prepared for repeated containment queries. They are built on first use and shared
+  // by copies of the region.
+  struct PreparedPolygonHolder
+  {
+    std::once_flag m_prepareFlag;
+    std::unique_ptr<PreparedPolygon> m_polygon;
+    // Simplified approximations of a big polygon: |m_outer| covers the polygon and |m_inner| is
+    // covered by it. They decide most containment tests far from the border. They are null for
+    // small polygons or if the approximation failed.
+    std::unique_ptr<PreparedPolygon> m_outer;
+    std::unique_ptr<PreparedPolygon> m_inner;
+  };
+
+  PreparedPolygonHolder const & GetPreparedPolygonHolder() const;
+
   void FillPolygon(feature::FeatureBuilder const & fb);
 
   boost::optional<PlacePoint> m_placeLabel;
   std::shared_ptr<BoostPolygon> m_polygon;
+  std::shared_ptr<PreparedPolygonHolder> m_preparedPolygon;
   BoostRect m_rect;
   double m_area;
 };
@@ -1,20 +1,98 @@
 #include "generator/regions/region_info_getter.hpp"
 
+#include "generator/profiler.hpp"
+
 #include "coding/mmap_reader.hpp"
 
 #include "base/logging.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 namespace generator
 {
 namespace regions
 {
+namespace
+{
+// Adds positions on the segment [a, b] where it intersects the segment [p, q].
+void AddIntersections(m2::PointD const & a, m2::PointD const & b, m2::PointD const & p,
+                      m2::PointD const & q, std::vector<double> & positions)
+{
+  double constexpr kEps = 1e-12;
+
+  auto const ab = b - a;
+  auto const pq = q - p;
+  auto const ap = p - a;
+  auto const denominator = m2::CrossProduct(ab, pq);
+  auto const abLength2 = ab.SquaredLength();
+  if (abLength2 == 0.0)
+    return;
+
+  auto const scale = std::sqrt(abLength2 * pq.SquaredLength());
+  if (std::fabs(denominator) <= kEps * scale)
+  {
+    // Parallel segments intersect only if they are collinear.
+    if (std::fabs(m2::CrossProduct(ap, ab)) > kEps * abLength2)
+      return;
+
+    auto const tp = m2::DotProduct(ap, ab) / abLength2;
+    auto const tq = m2::DotProduct(q - a, ab) / abLength2;
+    auto const from = std::max(0.0, std::min(tp, tq));
+    auto const to = std::min(1.0, std::max(tp, tq));
+    if (from <= to)
+    {
+      positions.push_back(from);
+      positions.push_back(to);
+    }
+    return;
+  }
+
+  auto const t = m2::CrossProduct(ap, pq) / denominator;
+  auto const u = m2::CrossProduct(ap, ab) / denominator;
+  if (t < -kEps || t > 1.0 + kEps || u < -kEps || u > 1.0 + kEps)
+    return;
+
+  positions.push_back(base::clamp(t, 0.0, 1.0));
+}
+}  // namespace
+
+struct RegionInfoGetter::BorderEdgesIndex
+{
+  using Edge = std::pair<m2::PointD, m2::PointD>;
+  using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+  using Box = boost::geometry::model::box<Point>;
+  using Tree = boost::geometry::index::rtree<std::pair<Box, size_t>,
+                                             boost::geometry::index::rstar<16>>;
+
+  static Box MakeBox(m2::PointD const & a, m2::PointD const & b)
+  {
+    return {{std::min(a.x, b.x), std::min(a.y, b.y)}, {std::max(a.x, b.x), std::max(a.y, b.y)}};
+  }
+
+  std::once_flag m_buildFlag;
+  std::vector<Edge> m_edges;
+  Tree m_tree;
+};
+
 RegionInfoGetter::RegionInfoGetter(std::string const & indexPath, std::string const & kvPath)
     : m_index{indexer::ReadIndex<indexer::RegionsIndexBox<IndexReader>, MmapReader>(indexPath)}
+    , m_borderEdgesIndex{std::make_unique<BorderEdgesIndex>()}
     , m_storage(kvPath)
 {
   m_borders.Deserialize(indexPath);
 }
 
+RegionInfoGetter::RegionInfoGetter(RegionInfoGetter &&) = default;
+
+RegionInfoGetter::~RegionInfoGetter() = default;
+
 boost::optional<KeyValue> RegionInfoGetter::FindDeepest(m2::PointD const & point) const
 {
   return FindDeepest(point, [] (...) { return true; });
@@ -60,8 +138,12 @@ boost::optional<KeyValue> RegionInfoGetter::GetDeepest(m2::PointD const & point,
   {
     auto & kv = i->second;
     auto regionId = kv.first;
-    if (regionId != borderCheckSkipRegionId && !m_borders.IsPointInside(regionId, point))
-      continue;
+    if (regionId != borderCheckSkipRegionId)
+    {
+      profiler::Add(profiler::Counter::BorderTests);
+      if (!m_borders.IsPointInside(regionId, point))
+        continue;
+    }
 
     if (selector(kv))
       return std::move(kv);
@@ -95,6 +177,50 @@ boost::optional<uint64_t> RegionInfoGetter::GetDref(JsonValue const & json) cons
   return dref;
 }
 
+std::vector<double> RegionInfoGetter::FindBorderCrossings(m2::PointD const & a,
+                                                          m2::PointD const & b) const
+{
+  auto const & index = GetBorderEdgesIndex();
+
+  std::vector<double> crossings;
+  auto const box = BorderEdgesIndex::MakeBox(a, b);
+  for (auto it = index.m_tree.qbegin(boost::geometry::index::intersects(box));
+       it != index.m_tree.qend(); ++it)
+  {
+    auto const & edge = index.m_edges[it->second];
+    AddIntersections(a, b, edge.first, edge.second, crossings);
+  }
+
+  std::sort(crossings.begin(), crossings.end());
+  crossings.erase(std::unique(crossings.begin(), crossings.end()), crossings.end());
+  return crossings;
+}
+
+RegionInfoGetter::BorderEdgesIndex const & RegionInfoGetter::GetBorderEdgesIndex() const
+{
+  auto & index = *m_borderEdgesIndex;
+  std::call_once(index.m_buildFlag, [&] {
+    m_borders.ForEachRing([&](uint64_t /* id */, std::vector<m2::PointD> const & ring) {
+      for (size_t i = 0; i < ring.size(); ++i)
+      {
+        auto const & next = ring[(i + 1) % ring.size()];
+        if (ring[i] != next)
+          index.m_edges.emplace_back(ring[i], next);
+      }
+    });
+
+    std::vector<std::pair<BorderEdgesIndex::Box, size_t>> boxes;
+    boxes.reserve(index.m_edges.size());
+    for (size_t i = 0; i < index.m_edges.size(); ++i)
+    {
+      auto const & edge = index.m_edges[i];
+      boxes.emplace_back(BorderEdgesIndex::MakeBox(edge.first, edge.second), i);
+    }
+    index.m_tree = BorderEdgesIndex::Tree{boxes};
+  });
+  return index;
+}
+
 KeyValueStorage const & RegionInfoGetter::GetStorage() const noexcept
 {
   return m_storage;
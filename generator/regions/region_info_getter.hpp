@@ -11,6 +11,7 @@
 
 #include "base/geo_object_id.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,13 +33,21 @@ public:
   using Selector = std::function<bool(KeyValue const & json)>;
 
   RegionInfoGetter(std::string const & indexPath, std::string const & kvPath);
+  RegionInfoGetter(RegionInfoGetter &&);
+  ~RegionInfoGetter();
 
   boost::optional<KeyValue> FindDeepest(m2::PointD const & point) const;
   boost::optional<KeyValue> FindDeepest(m2::PointD const & point, Selector const & selector) const;
+  // Returns sorted positions on the segment from |a| (position 0) to |b| (position 1) where it
+  // crosses or touches any region border. The borders edges index is built on the first call.
+  std::vector<double> FindBorderCrossings(m2::PointD const & a, m2::PointD const & b) const;
   KeyValueStorage const & GetStorage() const noexcept;
 
 private:
   using IndexReader = ReaderPtr<Reader>;
+  struct BorderEdgesIndex;
+
+  BorderEdgesIndex const & GetBorderEdgesIndex() const;
 
   std::vector<base::GeoObjectId> SearchObjectsInIndex(m2::PointD const & point) const;
   boost::optional<KeyValue> GetDeepest(m2::PointD const & point, std::vector<base::GeoObjectId> const & ids,
@@ -49,6 +58,7 @@ private:
 
   indexer::RegionsIndex<IndexReader> m_index;
   indexer::Borders m_borders;
+  std::unique_ptr<BorderEdgesIndex> m_borderEdgesIndex;
   KeyValueStorage m_storage;
 };
 }  // namespace regions
@@ -177,6 +177,7 @@ std::list<RegionsBuilder::ParentChildPairs> RegionsBuilder::FindParentChildPairs
                                    size_t{m_taskProcessingThreadPool.Size()});
 
   CHECK(!nodes.empty(), ());
+  auto const nodesIndex = MakeNodesIndex(nodes);
   std::atomic_size_t unprocessedIndex{1};
   auto task = [&] {
     ParentChildPairs parentChildPairs;
@@ -190,7 +191,8 @@ std::list<RegionsBuilder::ParentChildPairs> RegionsBuilder::FindParentChildPairs
 
       auto itemIterator = nodes.begin() + i;
       auto itemReverseIterator = std::make_reverse_iterator(std::next(itemIterator));
-      if (auto && parent = ChooseParent(nodes, itemReverseIterator, countrySpecifier))
+      if (auto && parent =
+              ChooseParent(nodes, nodesIndex, itemReverseIterator, countrySpecifier))
         parentChildPairs.emplace_back(parent, *itemIterator);
     }
 
@@ -209,8 +211,22 @@ std::list<RegionsBuilder::ParentChildPairs> RegionsBuilder::FindParentChildPairs
   return parentChildPairs;
 }
 
+// static
+RegionsBuilder::NodesIndex RegionsBuilder::MakeNodesIndex(
+    std::vector<Node::Ptr> const & nodesInAreaOrder)
+{
+  std::vector<NodesIndex::value_type> values;
+  values.reserve(nodesInAreaOrder.size());
+  for (size_t i = 0; i < nodesInAreaOrder.size(); ++i)
+    values.emplace_back(nodesInAreaOrder[i]->GetData().GetRect(), i);
+
+  // Packing construction builds a well-balanced tree at once.
+  return NodesIndex{values};
+}
+
 // static
 Node::Ptr RegionsBuilder::ChooseParent(std::vector<Node::Ptr> const & nodesInAreaOrder,
+                                       NodesIndex const & nodesIndex,
                                        std::vector<Node::Ptr>::const_reverse_iterator forItem,
                                        CountrySpecifier const & countrySpecifier)
 {
@@ -219,11 +235,25 @@ Node::Ptr RegionsBuilder::ChooseParent(std::vector<Node::Ptr> const & nodesInAre
 
   auto const from = FindAreaLowerBoundRely(nodesInAreaOrder, forItem);
   CHECK(from <= forItem, ());
+  auto const fromPosition =
+      static_cast<size_t>(std::distance(from, std::crend(nodesInAreaOrder))) - 1;
+
+  // A parent rect either covers the region rect or contains the region center.
+  auto searchRect = region.GetRect();
+  boost::geometry::expand(searchRect, region.GetCenter());
+
+  std::vector<NodesIndex::value_type> candidates;
+  nodesIndex.query(boost::geometry::index::intersects(searchRect),
+                   std::back_inserter(candidates));
+  base::EraseIf(candidates, [&](auto const & item) { return item.second > fromPosition; });
+  // Visit candidates in the same order as the area ordered list is visited from |from|.
+  std::sort(std::begin(candidates), std::end(candidates),
+            [](auto const & l, auto const & r) { return l.second > r.second; });
 
   Node::Ptr parent;
-  for (auto i = from, end = std::crend(nodesInAreaOrder); i != end; ++i)
+  for (auto const & item : candidates)
   {
-    auto const & candidate = *i;
+    auto const & candidate = nodesInAreaOrder[item.second];
     auto const & candidateRegion = candidate->GetData();
 
     if (parent)
@@ -236,7 +266,7 @@ Node::Ptr RegionsBuilder::ChooseParent(std::vector<Node::Ptr> const & nodesInAre
     if (!candidateRegion.ContainsRect(region) && !candidateRegion.Contains(region.GetCenter()))
       continue;
 
-    if (i == forItem)
+    if (candidate == node)
       continue;
 
     auto const c = CompareAffiliation(candidateRegion, region, countrySpecifier);
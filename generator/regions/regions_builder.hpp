@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/optional.hpp>
 
 namespace generator
@@ -48,6 +49,9 @@ private:
   static constexpr double kAreaRelativeErrorPercent = 0.1;
 
   using ParentChildPairs = std::vector<std::pair<Node::Ptr, Node::Ptr>>;
+  // Index of node rects, a value holds the node position in the area ordered nodes list.
+  using NodesIndex = boost::geometry::index::rtree<std::pair<BoostRect, size_t>,
+                                                   boost::geometry::index::rstar<16>>;
 
   void MoveLabelPlacePoints(PlacePointsMap & placePointsMap, Regions & regions);
   Regions FormRegionsInAreaOrder(Regions && regions);
@@ -67,7 +71,9 @@ private:
       CountrySpecifier const & countrySpecifier) const;
   std::list<ParentChildPairs> FindParentChildPairs(
       std::vector<Node::Ptr> const & nodes, CountrySpecifier const & countrySpecifier) const;
+  static NodesIndex MakeNodesIndex(std::vector<Node::Ptr> const & nodesInAreaOrder);
   static Node::Ptr ChooseParent(std::vector<Node::Ptr> const & nodesInAreaOrder,
+                                NodesIndex const & nodesIndex,
                                 std::vector<Node::Ptr>::const_reverse_iterator forItem,
                                 CountrySpecifier const & countrySpecifier);
   static std::vector<Node::Ptr>::const_reverse_iterator FindAreaLowerBoundRely(
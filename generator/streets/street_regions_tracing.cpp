@@ -29,6 +29,16 @@ StreetRegionsTracing::StreetRegionsTracing(Path const & path,
   Trace();
 }
 
+StreetRegionsTracing::StreetRegionsTracing(Path const & path,
+                                           StreetRegionInfoGetter const & streetRegionInfoGetter,
+                                           BorderCrossingsGetter const & borderCrossingsGetter)
+  : m_path{path}, m_streetRegionInfoGetter{streetRegionInfoGetter}
+{
+  CHECK_GREATER_OR_EQUAL(m_path.size(), 2, ());
+
+  TraceByBorderCrossings(borderCrossingsGetter);
+}
+
 StreetRegionsTracing::PathSegments && StreetRegionsTracing::StealPathSegments()
 {
   return std::move(m_pathSegments);
@@ -46,6 +56,77 @@ void StreetRegionsTracing::Trace()
     ReleaseCurrentSegment();
 }
 
+void StreetRegionsTracing::TraceByBorderCrossings(
+    BorderCrossingsGetter const & borderCrossingsGetter)
+{
+  // The region is the same up to the next border crossing.
+  bool regionMayChange = true;
+  for (auto a = m_path.begin(), b = std::next(a); b != m_path.end(); ++a, ++b)
+  {
+    auto positions = borderCrossingsGetter(*a, *b);
+    positions.push_back(1.0);
+
+    auto from = 0.0;
+    auto fromPoint = *a;
+    for (auto const to : positions)
+    {
+      if (to <= from)
+      {
+        regionMayChange = true;
+        continue;
+      }
+
+      auto const toPoint = to < 1.0 ? *a + (*b - *a) * to : *b;
+      if (regionMayChange)
+      {
+        auto const region = m_streetRegionInfoGetter((fromPoint + toPoint) / 2.0);
+        if (!IsSameRegion(region))
+          SwitchRegion(region, fromPoint);
+        regionMayChange = false;
+      }
+
+      AddPathPoint(toPoint);
+      regionMayChange = to < 1.0;
+      from = to;
+      fromPoint = toPoint;
+    }
+  }
+
+  if (m_currentRegion)
+    ReleaseCurrentSegment();
+}
+
+void StreetRegionsTracing::SwitchRegion(boost::optional<KeyValue> const & region,
+                                        m2::PointD const & point)
+{
+  if (m_currentRegion)
+  {
+    auto & currentSegment = m_pathSegments.back();
+    if (currentSegment.m_path.back() != point)
+      AddPathPoint(point);
+    ReleaseCurrentSegment();
+  }
+
+  m_currentRegion = region;
+  m_currentPoint = point;
+  if (m_currentRegion)
+    StartNewSegment();
+}
+
+void StreetRegionsTracing::AddPathPoint(m2::PointD const & point)
+{
+  if (m_currentRegion)
+  {
+    CHECK(!m_pathSegments.empty(), ());
+    auto & currentSegment = m_pathSegments.back();
+    auto const & lastPoint = currentSegment.m_path.back();
+    currentSegment.m_pathLengthMeters += Meter{MercatorBounds::DistanceOnEarth(lastPoint, point)};
+    currentSegment.m_path.push_back(point);
+  }
+
+  m_currentPoint = point;
+}
+
 bool StreetRegionsTracing::TraceToNextCheckPointInCurrentRegion()
 {
   Meter distanceToCheckPoint{};
@@ -19,6 +19,10 @@ class StreetRegionsTracing final
 public:
   using Meter = m2::Meter;
   using StreetRegionInfoGetter = std::function<boost::optional<KeyValue>(m2::PointD const & pathPoint)>;
+  // Returns sorted positions on the segment from |a| (position 0) to |b| (position 1) where
+  // the segment crosses or touches region borders.
+  using BorderCrossingsGetter =
+      std::function<std::vector<double>(m2::PointD const & a, m2::PointD const & b)>;
   using Path = std::vector<m2::PointD>;
 
   constexpr static auto const kRegionCheckStepDistance = 100.0_m;
@@ -33,12 +37,20 @@ public:
 
   using PathSegments = std::vector<Segment>;
 
+  // Traces the path by fixed steps and approximates region boundaries.
   StreetRegionsTracing(Path const & path, StreetRegionInfoGetter const & streetRegionInfoGetter);
+  // Splits the path exactly at border crossings. The region is looked up only once after each
+  // crossing.
+  StreetRegionsTracing(Path const & path, StreetRegionInfoGetter const & streetRegionInfoGetter,
+                       BorderCrossingsGetter const & borderCrossingsGetter);
 
   PathSegments && StealPathSegments();
 
 private:
   void Trace();
+  void TraceByBorderCrossings(BorderCrossingsGetter const & borderCrossingsGetter);
+  void SwitchRegion(boost::optional<KeyValue> const & region, m2::PointD const & point);
+  void AddPathPoint(m2::PointD const & point);
   bool TraceToNextCheckPointInCurrentRegion();
   void TraceUpToNextRegion();
   void AdvanceTo(m2::PointD const toPoint, Meter distance, Path::const_iterator nextPathPoint);
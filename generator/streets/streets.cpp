@@ -1,5 +1,6 @@
 #include "generator/streets/streets.hpp"
 
+#include "generator/profiler.hpp"
 #include "generator/regions/region_info_getter.hpp"
 #include "generator/streets/streets_builder.hpp"
 
@@ -30,17 +31,30 @@ void GenerateStreets(std::string const & pathInRegionsIndex, std::string const &
   auto const regionFinder = [&regionInfoGetter] (auto && point, auto && selector) {
     return regionInfoGetter.FindDeepest(point, selector);
   };
-  StreetsBuilder streetsBuilder{regionFinder, threadsCount};
+  auto const borderCrossingsFinder = [&regionInfoGetter](auto && a, auto && b) {
+    return regionInfoGetter.FindBorderCrossings(a, b);
+  };
+  StreetsBuilder streetsBuilder{regionFinder, threadsCount, borderCrossingsFinder};
 
-  streetsBuilder.AssembleStreets(pathInStreetsTmpMwm);
-  LOG(LINFO, ("Streets were built."));
+  {
+    profiler::ScopedPhase phase("assemble_streets");
+    streetsBuilder.AssembleStreets(pathInStreetsTmpMwm);
+    LOG(LINFO, ("Streets were built."));
+  }
 
-  streetsBuilder.AssembleBindings(pathInGeoObjectsTmpMwm);
-  LOG(LINFO, ("Binding's streets were built."));
+  {
+    profiler::ScopedPhase phase("assemble_bindings");
+    streetsBuilder.AssembleBindings(pathInGeoObjectsTmpMwm);
+    LOG(LINFO, ("Binding's streets were built."));
+  }
 
-  streetsBuilder.RegenerateAggregatedStreetsFeatures(pathInStreetsTmpMwm);
-  LOG(LINFO, ("Streets features are aggreated into", pathInStreetsTmpMwm));
+  {
+    profiler::ScopedPhase phase("regenerate_streets_features");
+    streetsBuilder.RegenerateAggregatedStreetsFeatures(pathInStreetsTmpMwm);
+    LOG(LINFO, ("Streets features are aggreated into", pathInStreetsTmpMwm));
+  }
 
+  profiler::ScopedPhase phase("save_streets_kv");
   std::ofstream streamStreetsKv(pathOutStreetsKv);
   auto const regionGetter = [&regionStorage = regionInfoGetter.GetStorage()](uint64_t id) {
     return regionStorage.Find(id);
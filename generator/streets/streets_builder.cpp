@@ -15,7 +15,10 @@
 
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
+#include "base/thread_pool_computational.hpp"
 
+#include <future>
+#include <sstream>
 #include <utility>
 
 #include "3party/jansson/myjansson.hpp"
@@ -26,67 +29,177 @@ namespace generator
 {
 namespace streets
 {
-StreetsBuilder::StreetsBuilder(RegionFinder const & regionFinder,
-                               unsigned int threadsCount)
+StreetsBuilder::StreetsBuilder(RegionFinder const & regionFinder, unsigned int threadsCount,
+                               BorderCrossingsFinder const & borderCrossingsFinder)
   : m_regionsArenas(GetArenasCount(threadsCount))
   , m_featuresArenas{GetArenasCount(threadsCount)}
   , m_regionFinder{regionFinder}
+  , m_borderCrossingsFinder{borderCrossingsFinder}
   , m_threadsCount{threadsCount}
 {
+  for (auto & regionsArena : m_regionsArenas)
+    regionsArena.m_featuresStreets.resize(m_featuresArenas.size());
 }
 
 void StreetsBuilder::AssembleStreets(std::string const & pathInStreetsTmpMwm)
 {
-  auto const transform = [this](FeatureBuilder & fb, uint64_t /* currPos */) { AddStreet(fb); };
-  if (m_threadsCount == 1)
-    ForEachFromDatRawFormat(pathInStreetsTmpMwm, transform);
-  else
-    ForEachParallelFromDatRawFormat(m_threadsCount, pathInStreetsTmpMwm, transform);
+  auto const collector = [this](FeatureBuilder & fb, ArenasUpdates & updates) {
+    AddStreet(fb, updates);
+  };
+  Assemble(pathInStreetsTmpMwm, collector);
 }
 
 void StreetsBuilder::AssembleBindings(std::string const & pathInGeoObjectsTmpMwm)
 {
-  auto const transform = [this](FeatureBuilder & fb, uint64_t /* currPos */) {
+  auto const collector = [this](FeatureBuilder & fb, ArenasUpdates & updates) {
     std::string streetName = fb.GetParams().GetStreet();
     if (!streetName.empty())
     {
       // TODO maybe (lagrunge): add localizations on street:lang tags
       StringUtf8Multilang multilangName;
       multilangName.AddString(StringUtf8Multilang::kDefaultCode, streetName);
-      AddStreetBinding(std::move(streetName), fb, multilangName);
+      AddStreetBinding(std::move(streetName), fb, multilangName, updates);
     }
   };
+  Assemble(pathInGeoObjectsTmpMwm, collector);
+}
 
-  if (m_threadsCount == 1)
-    ForEachFromDatRawFormat(pathInGeoObjectsTmpMwm, transform);
-  else
-    ForEachParallelFromDatRawFormat(m_threadsCount, pathInGeoObjectsTmpMwm, transform);
+void StreetsBuilder::Assemble(std::string const & pathInTmpMwm,
+                              UpdatesCollector const & updatesCollector)
+{
+  std::vector<ArenasUpdates> workersUpdates(m_threadsCount,
+                                            ArenasUpdates(m_regionsArenas.size()));
+  size_t nextWorker = 0;
+  auto const processorMaker = [&] {
+    auto & updates = workersUpdates[nextWorker++];
+    return [&updates, &updatesCollector](FeatureBuilder & fb, uint64_t /* currPos */) {
+      updatesCollector(fb, updates);
+    };
+  };
+  ProcessParallelFromDatRawFormat(m_threadsCount, pathInTmpMwm, processorMaker);
+
+  ApplyUpdates(workersUpdates);
+  LinkFeaturesToStreets();
+}
+
+void StreetsBuilder::ApplyUpdates(std::vector<ArenasUpdates> & workersUpdates)
+{
+  base::thread_pool::computational::ThreadPool threadPool{m_threadsCount};
+  std::vector<std::future<void>> tasks;
+  for (size_t i = 0; i < m_regionsArenas.size(); ++i)
+  {
+    tasks.push_back(threadPool.Submit([&, i] {
+      for (auto & updates : workersUpdates)
+        ApplyArenaUpdates(i, updates[i]);
+    }));
+  }
+
+  for (auto & task : tasks)
+    task.get();
+}
+
+void StreetsBuilder::ApplyArenaUpdates(size_t arenaIndex, std::vector<StreetUpdate> & updates)
+{
+  if (updates.empty())
+    return;
+
+  auto & regionsArena = m_regionsArenas[arenaIndex];
+  std::lock_guard<std::mutex> lock{regionsArena.m_updatesMutex};
+  for (auto & update : updates)
+    ApplyUpdate(regionsArena, std::move(update));
+  updates.clear();
+}
+
+void StreetsBuilder::ApplyUpdate(RegionsArena & regionsArena, StreetUpdate && update)
+{
+  auto & street = regionsArena.InsertStreet(update.m_regionId, std::move(update.m_name),
+                                            update.m_multilangName);
+  auto & geometry = street.m_geometry;
+  switch (update.m_type)
+  {
+  case StreetUpdate::Type::HighwayLine:
+    geometry.AddHighwayLine(update.m_osmId, update.m_path);
+    break;
+  case StreetUpdate::Type::HighwayArea:
+    geometry.AddHighwayArea(update.m_osmId, update.m_path);
+    break;
+  case StreetUpdate::Type::Pin:
+    geometry.SetPin({update.m_point, update.m_osmId});
+    break;
+  case StreetUpdate::Type::Binding:
+    geometry.AddBinding(update.m_osmId, update.m_point);
+    break;
+  }
+
+  if (update.m_featureId)
+  {
+    auto const featuresArenaIndex = GetFeaturesArenaIndex(*update.m_featureId);
+    regionsArena.m_featuresStreets[featuresArenaIndex].emplace_back(*update.m_featureId, &street);
+  }
+}
+
+void StreetsBuilder::LinkFeaturesToStreets()
+{
+  base::thread_pool::computational::ThreadPool threadPool{m_threadsCount};
+  std::vector<std::future<void>> tasks;
+  for (size_t i = 0; i < m_featuresArenas.size(); ++i)
+  {
+    tasks.push_back(threadPool.Submit([&, i] {
+      auto & featuresArena = m_featuresArenas[i];
+      for (auto & regionsArena : m_regionsArenas)
+      {
+        auto & featuresStreets = regionsArena.m_featuresStreets[i];
+        featuresArena.m_streetFeatures2Streets.insert(featuresStreets.begin(),
+                                                      featuresStreets.end());
+        featuresStreets = {};
+      }
+    }));
+  }
+
+  for (auto & task : tasks)
+    task.get();
 }
 
 void StreetsBuilder::RegenerateAggregatedStreetsFeatures(
     std::string const & pathStreetsTmpMwm)
 {
-  auto const aggregatedStreetsTmpFile = GetPlatform().TmpPathForFile();
-  SCOPE_GUARD(aggregatedStreetsTmpFileGuard,
-              std::bind(Platform::RemoveFileIfExists, aggregatedStreetsTmpFile));
-  FeaturesCollector collector(aggregatedStreetsTmpFile);
-
-  std::set<Street const *> processedStreets;
-  auto const transform = [&](FeatureBuilder & fb, uint64_t /* currPos */) {
-    auto const osmId = fb.GetMostGenericOsmId();
-    auto const & featuresArena = GetFeaturesArena(osmId);
-    auto street = featuresArena.m_streetFeatures2Streets.find(osmId);
-    if (street == featuresArena.m_streetFeatures2Streets.end())
+  // Each worker writes its own file, the files are concatenated at the end.
+  std::vector<std::string> aggregatedStreetsTmpFiles;
+  SCOPE_GUARD(aggregatedStreetsTmpFilesGuard, [&aggregatedStreetsTmpFiles] {
+    for (auto const & file : aggregatedStreetsTmpFiles)
+      Platform::RemoveFileIfExists(file);
+  });
+
+  std::vector<std::unique_ptr<FeaturesCollector>> collectors;
+  auto const processorMaker = [&] {
+    aggregatedStreetsTmpFiles.push_back(GetPlatform().TmpPathForFile());
+    collectors.push_back(std::make_unique<FeaturesCollector>(aggregatedStreetsTmpFiles.back()));
+    return [this, &collector = *collectors.back()](FeatureBuilder & fb, uint64_t /* currPos */) {
+      auto const osmId = fb.GetMostGenericOsmId();
+      auto const & featuresArena = GetFeaturesArena(osmId);
+      auto street = featuresArena.m_streetFeatures2Streets.find(osmId);
+      if (street == featuresArena.m_streetFeatures2Streets.end())
         return;
 
-    if (!processedStreets.insert(street->second).second)
-      return;
+      if (street->second->m_aggregated.exchange(true, std::memory_order_relaxed))
+        return;
 
-    WriteAsAggregatedStreet(fb, *street->second, collector);
+      WriteAsAggregatedStreet(fb, *street->second, collector);
+    };
   };
-  ForEachFromDatRawFormat(pathStreetsTmpMwm, transform);
+  ProcessParallelFromDatRawFormat(m_threadsCount, pathStreetsTmpMwm, processorMaker);
+  // Workers are not started for an empty input, the result is an empty features file then.
+  if (collectors.empty())
+    processorMaker();
+
+  for (auto & collector : collectors)
+    collector->Finish();
+  // Collectors flush their files on destruction.
+  collectors.clear();
 
-  collector.Finish();
+  auto const & aggregatedStreetsTmpFile = aggregatedStreetsTmpFiles.front();
+  for (size_t i = 1; i < aggregatedStreetsTmpFiles.size(); ++i)
+    base::AppendFileToFile(aggregatedStreetsTmpFiles[i], aggregatedStreetsTmpFile);
 
   CHECK(base::RenameFileX(aggregatedStreetsTmpFile, pathStreetsTmpMwm), ());
 }
@@ -136,168 +249,170 @@ void StreetsBuilder::WriteAsAggregatedStreet(FeatureBuilder & fb, Street const &
 void StreetsBuilder::SaveStreetsKv(RegionGetter const & regionGetter,
                                    std::ostream & streamStreetsKv)
 {
+  std::mutex streamMutex;
+  base::thread_pool::computational::ThreadPool threadPool{m_threadsCount};
+  std::vector<std::future<void>> tasks;
   for (auto const & regionsArena : m_regionsArenas)
   {
-    for (auto const & region : regionsArena.m_regions)
-    {
-      auto const & regionObject = regionGetter(region.first);
-      CHECK(regionObject, ());
-      SaveRegionStreetsKv(region.second, region.first, *regionObject, streamStreetsKv);
-    }
+    tasks.push_back(threadPool.Submit([&] {
+      SaveRegionsArenaKv(regionsArena, regionGetter, streamMutex, streamStreetsKv);
+    }));
   }
+
+  for (auto & task : tasks)
+    task.wait();
+}
+
+void StreetsBuilder::SaveRegionsArenaKv(RegionsArena const & regionsArena,
+                                        RegionGetter const & regionGetter,
+                                        std::mutex & streamMutex,
+                                        std::ostream & streamStreetsKv) const
+{
+  size_t constexpr kBufferSize = 1'000'000;
+
+  std::ostringstream buffer;
+  auto const flush = [&] {
+    auto const & data = buffer.str();
+    std::lock_guard<std::mutex> lock{streamMutex};
+    streamStreetsKv << data;
+    buffer.str({});
+  };
+
+  for (auto const & region : regionsArena.m_regions)
+  {
+    auto const & regionObject = regionGetter(region.first);
+    CHECK(regionObject, ());
+    SaveRegionStreetsKv(region.second, region.first, *regionObject, buffer);
+
+    if (static_cast<size_t>(buffer.tellp()) >= kBufferSize)
+      flush();
+  }
+
+  flush();
 }
 
 void StreetsBuilder::SaveRegionStreetsKv(RegionStreets const & streets, uint64_t regionId,
                                          JsonValue const & regionInfo,
-                                         std::ostream & streamStreetsKv)
+                                         std::ostream & streamStreetsKv) const
 {
+  auto const & regionLocales = MakeRegionLocales(regionInfo);
+
+  JsonStreamingWriter writer;
   for (auto const & street : streets)
   {
     auto const & bbox = street.second.m_geometry.GetBbox();
     auto const & pin = street.second.m_geometry.GetOrChoosePin();
 
-    auto const id = KeyValueStorage::SerializeDref(pin.m_osmId.GetEncodedId());
-    auto const & value =
-        MakeStreetValue(regionId, regionInfo, street.second.m_name, bbox, pin.m_position);
-    streamStreetsKv << id << " " << KeyValueStorage::Serialize(value) << "\n";
+    writer.Clear();
+    WriteStreetValue(writer, regionId, regionLocales, street.second.m_name, bbox, pin.m_position);
+
+    streamStreetsKv << KeyValueStorage::SerializeDref(pin.m_osmId.GetEncodedId()) << " ";
+    streamStreetsKv.write(writer.GetString(), writer.GetSize());
+    streamStreetsKv << "\n";
   }
 }
 
-void StreetsBuilder::AddStreet(FeatureBuilder & fb)
+void StreetsBuilder::AddStreet(FeatureBuilder & fb, ArenasUpdates & updates)
 {
   if (fb.IsArea())
-    return AddStreetArea(fb);
+    return AddStreetArea(fb, updates);
 
   if (fb.IsPoint())
-    return AddStreetPoint(fb);
+    return AddStreetPoint(fb, updates);
 
   CHECK(fb.IsLine(), ());
-  AddStreetHighway(fb);
+  AddStreetHighway(fb, updates);
 }
 
-void StreetsBuilder::AddStreetHighway(FeatureBuilder & fb)
+void StreetsBuilder::AddStreetHighway(FeatureBuilder & fb, ArenasUpdates & updates)
 {
   auto streetRegionInfoGetter = [this](auto const & pathPoint) {
     return this->FindStreetRegionOwner(pathPoint);
   };
-  StreetRegionsTracing regionsTracing(fb.GetOuterGeometry(), streetRegionInfoGetter);
+  StreetRegionsTracing::PathSegments pathSegments;
+  if (m_borderCrossingsFinder)
+  {
+    StreetRegionsTracing regionsTracing(fb.GetOuterGeometry(), streetRegionInfoGetter,
+                                        m_borderCrossingsFinder);
+    pathSegments = regionsTracing.StealPathSegments();
+  }
+  else
+  {
+    StreetRegionsTracing regionsTracing(fb.GetOuterGeometry(), streetRegionInfoGetter);
+    pathSegments = regionsTracing.StealPathSegments();
+  }
 
-  auto && pathSegments = regionsTracing.StealPathSegments();
+  auto const osmId = fb.GetMostGenericOsmId();
   for (auto & segment : pathSegments)
   {
-    auto && region = segment.m_region;
-
-    auto const osmId = fb.GetMostGenericOsmId();
     auto const streetId = pathSegments.size() == 1 ? osmId : NextOsmSurrogateId();
-    Street const * featureStreetPtr = nullptr;
-
-    {
-      auto & regionsArena = GetRegionsArena(region.first);
-      std::lock_guard<std::mutex> lock{regionsArena.m_updateMutex};
-
-      auto & street = regionsArena.InsertStreet(region.first, fb.GetName(), fb.GetMultilangName());
-      street.m_geometry.AddHighwayLine(streetId, std::move(segment.m_path));
-      featureStreetPtr = &street;
-    }
-
-    {
-      auto & featuresArena = GetFeaturesArena(osmId);
-      std::lock_guard<std::mutex> lock{featuresArena.m_updateMutex};
-
-      featuresArena.m_streetFeatures2Streets.emplace(osmId, featureStreetPtr);
-    }
+    AddUpdate({StreetUpdate::Type::HighwayLine, segment.m_region.first,
+               MakeStreetName(fb.GetName()), fb.GetMultilangName(), streetId, {},
+               std::move(segment.m_path), osmId},
+              updates);
   }
 }
 
-void StreetsBuilder::AddStreetArea(FeatureBuilder & fb)
+void StreetsBuilder::AddStreetArea(FeatureBuilder & fb, ArenasUpdates & updates)
 {
   auto && region = FindStreetRegionOwner(fb.GetGeometryCenter(), true);
   if (!region)
     return;
 
   auto const osmId = fb.GetMostGenericOsmId();
-  Street const * featureStreetPtr = nullptr;
-
-  {
-    auto & regionsArena = GetRegionsArena(region->first);
-    std::lock_guard<std::mutex> lock{regionsArena.m_updateMutex};
-
-    auto & street = regionsArena.InsertStreet(region->first, fb.GetName(), fb.GetMultilangName());
-    street.m_geometry.AddHighwayArea(osmId, fb.GetOuterGeometry());
-    featureStreetPtr = &street;
-  }
-
-  {
-    auto & featuresArena = GetFeaturesArena(osmId);
-    std::lock_guard<std::mutex> lock{featuresArena.m_updateMutex};
-
-    featuresArena.m_streetFeatures2Streets.emplace(osmId, featureStreetPtr);
-  }
+  AddUpdate({StreetUpdate::Type::HighwayArea, region->first, MakeStreetName(fb.GetName()),
+             fb.GetMultilangName(), osmId, {}, fb.GetOuterGeometry(), osmId},
+            updates);
 }
 
-void StreetsBuilder::AddStreetPoint(FeatureBuilder & fb)
+void StreetsBuilder::AddStreetPoint(FeatureBuilder & fb, ArenasUpdates & updates)
 {
   auto && region = FindStreetRegionOwner(fb.GetKeyPoint(), true);
   if (!region)
     return;
 
   auto const osmId = fb.GetMostGenericOsmId();
-  Street const * featureStreetPtr = nullptr;
-
-  {
-    auto & regionsArena = GetRegionsArena(region->first);
-    std::lock_guard<std::mutex> lock{regionsArena.m_updateMutex};
-
-    auto & street = regionsArena.InsertStreet(region->first, fb.GetName(), fb.GetMultilangName());
-    street.m_geometry.SetPin({fb.GetKeyPoint(), osmId});
-    featureStreetPtr = &street;
-  }
-
-  {
-    auto & featuresArena = GetFeaturesArena(osmId);
-    std::lock_guard<std::mutex> lock{featuresArena.m_updateMutex};
-
-    featuresArena.m_streetFeatures2Streets.emplace(osmId, featureStreetPtr);
-  }
+  AddUpdate({StreetUpdate::Type::Pin, region->first, MakeStreetName(fb.GetName()),
+             fb.GetMultilangName(), osmId, fb.GetKeyPoint(), {}, osmId},
+            updates);
 }
 
 void StreetsBuilder::AddStreetBinding(std::string && streetName, FeatureBuilder & fb,
-                                      StringUtf8Multilang const & multiLangName)
+                                      StringUtf8Multilang const & multiLangName,
+                                      ArenasUpdates & updates)
 {
   auto const region = FindStreetRegionOwner(fb.GetKeyPoint());
   if (!region)
     return;
 
-  auto const osmId = NextOsmSurrogateId();
-
-  {
-    auto & regionsArena = GetRegionsArena(region->first);
-    std::lock_guard<std::mutex> lock{regionsArena.m_updateMutex};
-
-    auto & street = regionsArena.InsertStreet(region->first, std::move(streetName), multiLangName);
-    street.m_geometry.AddBinding(osmId, fb.GetKeyPoint());
-  }
+  AddUpdate({StreetUpdate::Type::Binding, region->first, MakeStreetName(std::move(streetName)),
+             multiLangName, NextOsmSurrogateId(), fb.GetKeyPoint(), {}, {}},
+            updates);
 }
 
-StreetsBuilder::RegionsArena & StreetsBuilder::GetRegionsArena(uint64_t regionId)
+void StreetsBuilder::AddUpdate(StreetUpdate && update, ArenasUpdates & updates)
 {
-  return m_regionsArenas[std::hash<uint64_t>{}(regionId) % m_regionsArenas.size()];
+  auto const arenaIndex = GetRegionsArenaIndex(update.m_regionId);
+  auto & arenaUpdates = updates[arenaIndex];
+  arenaUpdates.push_back(std::move(update));
+  if (arenaUpdates.size() >= kMaxArenaUpdatesCount)
+    ApplyArenaUpdates(arenaIndex, arenaUpdates);
 }
 
-StreetsBuilder::RegionsArena const & StreetsBuilder::GetRegionsArena(uint64_t regionId) const
+size_t StreetsBuilder::GetRegionsArenaIndex(uint64_t regionId) const
 {
-  return m_regionsArenas[std::hash<uint64_t>{}(regionId) % m_regionsArenas.size()];
+  return std::hash<uint64_t>{}(regionId) % m_regionsArenas.size();
 }
 
-StreetsBuilder::FeaturesArena & StreetsBuilder::GetFeaturesArena(base::GeoObjectId const & osmId)
+size_t StreetsBuilder::GetFeaturesArenaIndex(base::GeoObjectId const & osmId) const
 {
-  return m_featuresArenas[std::hash<base::GeoObjectId>{}(osmId) % m_featuresArenas.size()];
+  return std::hash<base::GeoObjectId>{}(osmId) % m_featuresArenas.size();
 }
 
 StreetsBuilder::FeaturesArena const & StreetsBuilder::GetFeaturesArena(
     base::GeoObjectId const & osmId) const
 {
-  return m_featuresArenas[std::hash<base::GeoObjectId>{}(osmId) % m_featuresArenas.size()];
+  return m_featuresArenas[GetFeaturesArenaIndex(osmId)];
 }
 
 boost::optional<KeyValue> StreetsBuilder::FindStreetRegionOwner(m2::PointD const & point,
@@ -335,46 +450,126 @@ StringUtf8Multilang MergeNames(const StringUtf8Multilang & first,
 }
 
 StreetsBuilder::Street & StreetsBuilder::RegionsArena::InsertStreet(
-    uint64_t regionId, std::string && streetName, StringUtf8Multilang const & multilangName)
+    uint64_t regionId, StreetName && streetName, StringUtf8Multilang const & multilangName)
 {
+  auto const nextNameId = static_cast<StreetNameId>(m_streetNameIds.size());
+  auto const nameId = m_streetNameIds.emplace(std::move(streetName), nextNameId).first->second;
+
   auto & regionStreets = m_regions[regionId];
-  StreetsBuilder::Street & street = regionStreets[std::move(streetName)];
+  StreetsBuilder::Street & street = regionStreets[nameId];
   street.m_name = MergeNames(multilangName, street.m_name);
   return street;
 }
 
-base::JSONPtr StreetsBuilder::MakeStreetValue(uint64_t regionId, JsonValue const & regionObject,
-                                              StringUtf8Multilang const & streetName,
-                                              m2::RectD const & bbox, m2::PointD const & pinPoint)
+// static
+StreetsBuilder::RegionLocales StreetsBuilder::MakeRegionLocales(JsonValue const & regionObject)
 {
-  auto streetObject = base::NewJSONObject();
+  RegionLocales regionLocales;
+
+  // Iteration API of jansson takes non-const objects.
+  auto locales = const_cast<json_t *>(
+      base::GetJSONObligatoryFieldByPath(regionObject, "properties", "locales"));
+  char const * language;
+  json_t * locale;
+  json_object_foreach(locales, language, locale)
+  {
+    auto & regionLocale = regionLocales[language];
+    regionLocale.m_members = JsonStreamingWriter::MakeMembers(locale, {"name", "address"});
 
-  auto && regionLocales = base::GetJSONObligatoryFieldByPath(regionObject, "properties", "locales");
-  auto locales = base::JSONPtr{json_deep_copy(const_cast<json_t *>(regionLocales))};
-  auto properties = base::NewJSONObject();
-  ToJSONObject(*properties, "locales", std::move(locales));
+    auto address = base::GetJSONOptionalField(locale, "address");
+    if (address && !base::JSONIsNull(address))
+      regionLocale.m_address = JsonStreamingWriter::MakeMembers(address, {"street"});
+  }
 
-  Localizator localizator(*properties);
-  auto const & localizee = Localizator::EasyObjectWithTranslation(streetName);
-  localizator.SetLocale("name", localizee);
+  return regionLocales;
+}
 
-  localizator.SetLocale("street", localizee, "address");
+void StreetsBuilder::WriteStreetValue(JsonStreamingWriter & writer, uint64_t regionId,
+                                      RegionLocales const & regionLocales,
+                                      StringUtf8Multilang const & streetName,
+                                      m2::RectD const & bbox, m2::PointD const & pinPoint) const
+{
+  std::map<std::string, std::string> streetNames;
+  Localizator::ForEachLocaleName(
+      Localizator::EasyObjectWithTranslation(streetName),
+      [&streetNames](std::string const & language, std::string const & name) {
+        streetNames.emplace(language, name);
+      });
+
+  writer.StartObject();
+
+  writer.Key("properties");
+  writer.StartObject();
+  writer.Key("locales");
+  writer.StartObject();
+  for (auto const & regionLocale : regionLocales)
+  {
+    auto const name = streetNames.find(regionLocale.first);
+    WriteStreetLocale(writer, regionLocale.first, &regionLocale.second,
+                      name != streetNames.end() ? &name->second : nullptr);
+  }
+  for (auto const & name : streetNames)
+  {
+    if (!regionLocales.count(name.first))
+      WriteStreetLocale(writer, name.first, nullptr /* regionLocale */, &name.second);
+  }
+  writer.EndObject();
 
-  ToJSONObject(*properties, "kind", "street");
-  ToJSONObject(*properties, "dref", KeyValueStorage::SerializeDref(regionId));
-  ToJSONObject(*streetObject, "properties", std::move(properties));
+  writer.Key("kind");
+  writer.String("street");
+  writer.Key("dref");
+  writer.String(KeyValueStorage::SerializeDref(regionId));
+  writer.EndObject();
 
   auto const & leftBottom = MercatorBounds::ToLatLon(bbox.LeftBottom());
   auto const & rightTop = MercatorBounds::ToLatLon(bbox.RightTop());
-  auto const & bboxArray =
-      std::vector<double>{leftBottom.m_lon, leftBottom.m_lat, rightTop.m_lon, rightTop.m_lat};
-  ToJSONObject(*streetObject, "bbox", std::move(bboxArray));
+  writer.Key("bbox");
+  writer.StartArray();
+  for (auto const coordinate : {leftBottom.m_lon, leftBottom.m_lat, rightTop.m_lon, rightTop.m_lat})
+    writer.Double(coordinate);
+  writer.EndArray();
 
   auto const & pinLatLon = MercatorBounds::ToLatLon(pinPoint);
-  auto const & pinArray = std::vector<double>{pinLatLon.m_lon, pinLatLon.m_lat};
-  ToJSONObject(*streetObject, "pin", std::move(pinArray));
+  writer.Key("pin");
+  writer.StartArray();
+  writer.Double(pinLatLon.m_lon);
+  writer.Double(pinLatLon.m_lat);
+  writer.EndArray();
 
-  return streetObject;
+  writer.EndObject();
+}
+
+// static
+void StreetsBuilder::WriteStreetLocale(JsonStreamingWriter & writer, std::string const & language,
+                                       RegionLocale const * regionLocale,
+                                       std::string const * streetName)
+{
+  writer.Key(language);
+  writer.StartObject();
+
+  if (regionLocale)
+    writer.Members(regionLocale->m_members);
+  if (streetName)
+  {
+    writer.Key("name");
+    writer.String(*streetName);
+  }
+
+  if (streetName || (regionLocale && regionLocale->m_address))
+  {
+    writer.Key("address");
+    writer.StartObject();
+    if (regionLocale && regionLocale->m_address)
+      writer.Members(*regionLocale->m_address);
+    if (streetName)
+    {
+      writer.Key("street");
+      writer.String(*streetName);
+    }
+    writer.EndObject();
+  }
+
+  writer.EndObject();
 }
 
 base::GeoObjectId StreetsBuilder::NextOsmSurrogateId()
@@ -383,6 +578,13 @@ base::GeoObjectId StreetsBuilder::NextOsmSurrogateId()
   return base::GeoObjectId{base::GeoObjectId::Type::OsmSurrogate, id};
 }
 
+// static
+StreetsBuilder::StreetName StreetsBuilder::MakeStreetName(std::string && name)
+{
+  auto const hash = std::hash<std::string>{}(name);
+  return {std::move(name), hash};
+}
+
 // static
 bool StreetsBuilder::IsStreet(OsmElement const & element)
 {
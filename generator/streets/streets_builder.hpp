@@ -2,9 +2,11 @@
 
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
+#include "generator/json_streaming_writer.hpp"
 #include "generator/osm_element.hpp"
 #include "generator/regions/region_info_getter.hpp"
 #include "generator/streets/street_geometry.hpp"
+#include "generator/streets/street_regions_tracing.hpp"
 
 #include "coding/reader.hpp"
 
@@ -14,13 +16,15 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <ostream>
 #include <stdint.h>
 #include <string>
-#include <vector>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -34,8 +38,12 @@ public:
   using RegionFinder = std::function<boost::optional<KeyValue>(
       m2::PointD const & point, std::function<bool(KeyValue const & json)> const & selector)>;
   using RegionGetter = std::function<std::shared_ptr<JsonValue>(uint64_t key)>;
+  using BorderCrossingsFinder = StreetRegionsTracing::BorderCrossingsGetter;
 
-  explicit StreetsBuilder(RegionFinder const & regionFinder, unsigned int threadsCount = 1);
+  // Highways are split by regions exactly at border crossings if |borderCrossingsFinder| is set,
+  // otherwise region boundaries are searched by steps along highways.
+  explicit StreetsBuilder(RegionFinder const & regionFinder, unsigned int threadsCount = 1,
+                          BorderCrossingsFinder const & borderCrossingsFinder = {});
 
   void AssembleStreets(std::string const & pathInStreetsTmpMwm);
   void AssembleBindings(std::string const & pathInGeoObjectsTmpMwm);
@@ -55,54 +63,132 @@ private:
   {
     StringUtf8Multilang m_name;
     StreetGeometry m_geometry;
+    // Set by the worker that writes the street as aggregated features.
+    mutable std::atomic<bool> m_aggregated{false};
+  };
+
+  // Street name with the hash calculated once by the worker that finds the street region.
+  struct StreetName
+  {
+    bool operator==(StreetName const & other) const { return m_name == other.m_name; }
+
+    std::string m_name;
+    size_t m_hash;
+  };
+
+  struct StreetNameHash
+  {
+    size_t operator()(StreetName const & streetName) const { return streetName.m_hash; }
   };
 
-  using RegionStreets = std::unordered_map<std::string, Street>;
+  using StreetNameId = uint32_t;
+  using RegionStreets = std::unordered_map<StreetNameId, Street>;
 
+  // Street part bound to its region. It is added to the street by the owner of the region arena.
+  struct StreetUpdate
+  {
+    enum class Type
+    {
+      HighwayLine,
+      HighwayArea,
+      Pin,
+      Binding
+    };
+
+    Type m_type;
+    uint64_t m_regionId;
+    StreetName m_name;
+    StringUtf8Multilang m_multilangName;
+    base::GeoObjectId m_osmId;
+    // Position of a pin or a binding.
+    m2::PointD m_point;
+    // Path of a highway line or border of a highway area.
+    std::vector<m2::PointD> m_path;
+    // Feature which is aggregated into the street.
+    boost::optional<base::GeoObjectId> m_featureId;
+  };
+
+  // Updates of a single worker grouped by regions arenas. The worker hands the updates of an arena
+  // over to the arena as soon as |kMaxArenaUpdatesCount| of them are buffered.
+  using ArenasUpdates = std::vector<std::vector<StreetUpdate>>;
+  static size_t constexpr kMaxArenaUpdatesCount = 256;
+  using UpdatesCollector = std::function<void(feature::FeatureBuilder & fb,
+                                              ArenasUpdates & updates)>;
+
+  // Each regions arena owns a disjoint set of regions and is filled by one worker at a time.
   struct RegionsArena
   {
+    std::mutex m_updatesMutex;
     std::unordered_map<uint64_t, RegionStreets> m_regions;
-    std::mutex m_updateMutex;
+    // Street names are interned per arena, streets are keyed by the name ids.
+    std::unordered_map<StreetName, StreetNameId, StreetNameHash> m_streetNameIds;
+    // Streets of features grouped by features arenas.
+    std::vector<std::vector<std::pair<base::GeoObjectId, Street const *>>> m_featuresStreets;
 
-    Street & InsertStreet(uint64_t regionId, std::string && streetName,
+    Street & InsertStreet(uint64_t regionId, StreetName && streetName,
                           StringUtf8Multilang const & multilangName);
   };
 
   struct FeaturesArena
   {
     std::unordered_multimap<base::GeoObjectId, Street const *> m_streetFeatures2Streets;
-    std::mutex m_updateMutex;
   };
 
-  RegionsArena & GetRegionsArena(uint64_t regionsId);
-  RegionsArena const & GetRegionsArena(uint64_t regionId) const;
-  FeaturesArena & GetFeaturesArena(base::GeoObjectId const & osmId);
+  size_t GetRegionsArenaIndex(uint64_t regionId) const;
+  size_t GetFeaturesArenaIndex(base::GeoObjectId const & osmId) const;
   FeaturesArena const & GetFeaturesArena(base::GeoObjectId const & osmId) const;
   void WriteAsAggregatedStreet(feature::FeatureBuilder & fb, Street const & street,
                                feature::FeaturesCollector & collector) const;
 
-  void SaveRegionStreetsKv(RegionStreets const & streets, uint64_t regionId,
-                           JsonValue const & regionInfo, std::ostream & streamStreetsKv);
+  // Region locale members pre-serialized once for all streets of the region.
+  struct RegionLocale
+  {
+    // Members besides "name" and "address".
+    std::string m_members;
+    // Address members besides "street".
+    boost::optional<std::string> m_address;
+  };
+  using RegionLocales = std::map<std::string, RegionLocale>;
 
-  void AddStreet(feature::FeatureBuilder & fb);
-  void AddStreetHighway(feature::FeatureBuilder & fb);
-  void AddStreetArea(feature::FeatureBuilder & fb);
-  void AddStreetPoint(feature::FeatureBuilder & fb);
+  static RegionLocales MakeRegionLocales(JsonValue const & regionObject);
+  static void WriteStreetLocale(JsonStreamingWriter & writer, std::string const & language,
+                                RegionLocale const * regionLocale, std::string const * streetName);
+
+  void SaveRegionsArenaKv(RegionsArena const & regionsArena, RegionGetter const & regionGetter,
+                          std::mutex & streamMutex, std::ostream & streamStreetsKv) const;
+  void SaveRegionStreetsKv(RegionStreets const & streets, uint64_t regionId,
+                           JsonValue const & regionInfo, std::ostream & streamStreetsKv) const;
+
+  // Finds regions of features in parallel and fills each regions arena by batches of updates.
+  void Assemble(std::string const & pathInTmpMwm, UpdatesCollector const & updatesCollector);
+  void ApplyUpdates(std::vector<ArenasUpdates> & workersUpdates);
+  void ApplyArenaUpdates(size_t arenaIndex, std::vector<StreetUpdate> & updates);
+  void ApplyUpdate(RegionsArena & regionsArena, StreetUpdate && update);
+  void LinkFeaturesToStreets();
+
+  void AddStreet(feature::FeatureBuilder & fb, ArenasUpdates & updates);
+  void AddStreetHighway(feature::FeatureBuilder & fb, ArenasUpdates & updates);
+  void AddStreetArea(feature::FeatureBuilder & fb, ArenasUpdates & updates);
+  void AddStreetPoint(feature::FeatureBuilder & fb, ArenasUpdates & updates);
   void AddStreetBinding(std::string && streetName, feature::FeatureBuilder & fb,
-                        StringUtf8Multilang const & multiLangName);
+                        StringUtf8Multilang const & multiLangName, ArenasUpdates & updates);
+  void AddUpdate(StreetUpdate && update, ArenasUpdates & updates);
   boost::optional<KeyValue> FindStreetRegionOwner(m2::PointD const & point,
                                                   bool needLocality = false);
-  base::JSONPtr MakeStreetValue(uint64_t regionId, JsonValue const & regionObject,
-                                const StringUtf8Multilang & streetName, m2::RectD const & bbox,
-                                m2::PointD const & pinPoint);
+  void WriteStreetValue(JsonStreamingWriter & writer, uint64_t regionId,
+                        RegionLocales const & regionLocales,
+                        StringUtf8Multilang const & streetName, m2::RectD const & bbox,
+                        m2::PointD const & pinPoint) const;
   base::GeoObjectId NextOsmSurrogateId();
 
+  static StreetName MakeStreetName(std::string && name);
   static unsigned int GetArenasCount(unsigned int threadsCount);
 
   std::vector<RegionsArena> m_regionsArenas;
   std::vector<FeaturesArena> m_featuresArenas;
 
   RegionFinder m_regionFinder;
+  BorderCrossingsFinder m_borderCrossingsFinder;
   std::atomic<uint64_t> m_osmSurrogateCounter{0};
   unsigned int m_threadsCount;
 };
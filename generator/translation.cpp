@@ -76,5 +76,6 @@ std::string GetTranslatedOrTransliteratedName(StringUtf8Multilang const & name,
   return std::string();
 }
 
-Languages const & Localizator::LocaleLanguages() const { return kLocalelanguages; }
+// static
+Languages const & Localizator::LocaleLanguages() { return kLocalelanguages; }
 }  // namespace generator
@@ -76,6 +76,23 @@ public:
     }
   }
 
+  // Calls |fn(language, name)| for every non-empty name SetLocale() writes for |objectWithName|.
+  template <class Object, class Fn>
+  static void ForEachLocaleName(Object const & objectWithName, Fn && fn)
+  {
+    auto const & name = objectWithName.GetName();
+    if (!name.empty())
+      fn(DefaultLocaleName(), name);
+
+    for (std::string const & language : LocaleLanguages())
+    {
+      std::string const & translation = objectWithName.GetTranslatedOrTransliteratedName(
+          StringUtf8Multilang::GetLangIndex(language));
+      if (!translation.empty())
+        fn(language, translation);
+    }
+  }
+
   template <class Verboser>
   void AddVerbose(Verboser && verboser, std::string const & level)
   {
@@ -136,7 +153,7 @@ private:
     json_object_del(node, label.c_str());
   }
 
-  std::vector<std::string> const & LocaleLanguages() const;
+  static std::vector<std::string> const & LocaleLanguages();
 
   json_t & m_node;
 };
@@ -42,13 +42,19 @@ void Translator::SetFilter(std::shared_ptr<FilterInterface> const & filter)
   m_filter = filter;
 }
 
-void Translator::Emit(OsmElement & element)
+bool Translator::IsAccepted(OsmElement const & element)
 {
-  if (!m_filter->IsAccepted(element))
-    return;
+  return m_filter->IsAccepted(element);
+}
 
-  Preprocess(element);
+void Translator::Enrich(OsmElement & element)
+{
   m_tagsEnricher(element);
+}
+
+void Translator::EmitAccepted(OsmElement & element)
+{
+  Preprocess(element);
   m_collector->Collect(element);
   m_featureMaker->Add(element);
   FeatureBuilder feature;
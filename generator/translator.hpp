@@ -39,7 +39,9 @@ public:
   void SetFilter(std::shared_ptr<FilterInterface> const & filter);
 
   // TranslatorInterface overrides:
-  void Emit(OsmElement & element) override;
+  bool IsAccepted(OsmElement const & element) override;
+  void Enrich(OsmElement & element) override;
+  void EmitAccepted(OsmElement & element) override;
   void Finish() override;
   bool Save() override;
 
@@ -16,13 +16,39 @@ TranslatorCollection::Clone() const
   return p;
 }
 
-void TranslatorCollection::Emit(OsmElement /* const */ & element)
+bool TranslatorCollection::IsAccepted(OsmElement const & element)
 {
+  return std::any_of(std::begin(m_collection), std::end(m_collection), [&](auto & t) {
+    return t->IsAccepted(element);
+  });
+}
+
+void TranslatorCollection::EmitAccepted(OsmElement & element)
+{
+  Emit(element);
+}
+
+void TranslatorCollection::Emit(OsmElement & element)
+{
+  m_accepted.clear();
   for (auto & t : m_collection)
+  {
+    if (t->IsAccepted(element))
+      m_accepted.emplace_back(t.get());
+  }
+
+  if (m_accepted.empty())
+    return;
+
+  // Enrichment is the same for all translators, so it is done once by any of them.
+  m_accepted.front()->Enrich(element);
+  for (size_t i = 0; i + 1 < m_accepted.size(); ++i)
   {
     OsmElement copy = element;
-    t->Emit(copy);
+    m_accepted[i]->EmitAccepted(copy);
   }
+
+  m_accepted.back()->EmitAccepted(element);
 }
 
 void TranslatorCollection::Finish()
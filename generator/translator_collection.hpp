@@ -4,6 +4,7 @@
 #include "generator/translator_interface.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace generator
 {
@@ -14,12 +15,19 @@ public:
   // TranslatorInterface overrides:
   std::shared_ptr<TranslatorInterface> Clone() const override;
 
-  void Emit(OsmElement /* const */ & element) override;
+  bool IsAccepted(OsmElement const & element) override;
+  void EmitAccepted(OsmElement & element) override;
+  // Filters the raw element by every translator, enriches it once and copies it only for
+  // translators that are not the last to consume it.
+  void Emit(OsmElement & element) override;
 
   void Finish() override;
   bool Save() override;
 
   void Merge(TranslatorInterface const & other) override;
   void MergeInto(TranslatorCollection & other) const override;
+
+private:
+  std::vector<TranslatorInterface *> m_accepted;
 };
 }  // namespace generator
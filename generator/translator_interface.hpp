@@ -26,6 +26,13 @@ class TranslatorStreets;
 class TranslatorCollection;
 
 // Implementing this interface allows an object to create intermediate data from OsmElement.
+// Translation of an element is split into stages:
+//  - IsAccepted() decides whether the translator is interested in the raw element, it must not
+//    modify the element;
+//  - Enrich() runs mutating steps that are the same for all translators (e.g. adding tags of
+//    parent relations), so a group of translators may run it only once per element;
+//  - EmitAccepted() translates an accepted and enriched element. It may rewrite the element,
+//    so the caller passes a copy if it needs the element intact afterwards.
 class TranslatorInterface
 {
 public:
@@ -33,8 +40,20 @@ public:
 
   virtual std::shared_ptr<TranslatorInterface> Clone() const = 0;
 
+  virtual bool IsAccepted(OsmElement const &) { return true; }
+  virtual void Enrich(OsmElement &) {}
   virtual void Preprocess(OsmElement &) {}
-  virtual void Emit(OsmElement & element) = 0;
+  virtual void EmitAccepted(OsmElement & element) = 0;
+
+  virtual void Emit(OsmElement & element)
+  {
+    if (!IsAccepted(element))
+      return;
+
+    Enrich(element);
+    EmitAccepted(element);
+  }
+
   virtual void Finish() = 0;
   virtual bool Save() = 0;
 
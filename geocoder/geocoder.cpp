@@ -146,9 +146,44 @@ Type NextType(Type type)
   return static_cast<Type>(t + 1);
 }
 
-strings::UniString MakeHouseNumber(Tokens const & tokens)
+// Adds the lifetime of the object to |*seconds| unless |seconds| is null.
+class ScopedStageTimer
 {
-  return strings::MakeUniString(strings::JoinStrings(tokens, " "));
+public:
+  explicit ScopedStageTimer(double * seconds) : m_seconds(seconds)
+  {
+    if (m_seconds)
+      m_timer.Reset();
+  }
+
+  ~ScopedStageTimer()
+  {
+    if (m_seconds)
+      *m_seconds += m_timer.ElapsedSeconds();
+  }
+
+private:
+  double * m_seconds;
+  base::Timer m_timer{false /* start */};
+};
+
+double * StageSeconds(Geocoder::Stats * stats, double Geocoder::Stats::*stage)
+{
+  return stats ? &(stats->*stage) : nullptr;
+}
+
+// Joins the tokens [begin, end) of |ctx| with spaces into |houseNumber|.
+void MakeHouseNumber(Geocoder::Context const & ctx, size_t begin, size_t end,
+                     strings::UniString & houseNumber)
+{
+  houseNumber.clear();
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (i != begin)
+      houseNumber.push_back(' ');
+    auto const & token = ctx.GetToken(i);
+    utf8::unchecked::utf8to32(token.begin(), token.end(), back_inserter(houseNumber));
+  }
 }
 }  // namespace
 
@@ -171,20 +206,51 @@ void Geocoder::Layer::SetCandidates(std::vector<Candidate> && candidates)
 }
 
 // Geocoder::Context -------------------------------------------------------------------------------
-Geocoder::Context::Context(string const & query) : m_beam(kMaxResults)
+Geocoder::Context::Context() : m_beam(kMaxResults) {}
+
+Geocoder::Context::Context(string const & query) : Context() { Reset(query); }
+
+void Geocoder::Context::Reset(string const & query)
 {
-  search::NormalizeAndTokenizeAsUtf8(query, m_tokens);
-  m_tokenTypes.assign(m_tokens.size(), Type::Count);
+  search::Delimiters const delimiters;
+
+  // Same as search::NormalizeAndTokenizeAsUtf8() but the tokens are written over the tokens
+  // of the previous query.
+  search::NormalizeAndSimplifyString(query, m_normalizedQuery);
+  m_numTokens = 0;
+  auto it = m_normalizedQuery.begin();
+  auto const end = m_normalizedQuery.end();
+  while (true)
+  {
+    it = find_if(it, end, [&delimiters](strings::UniChar c) { return !delimiters(c); });
+    if (it == end)
+      break;
+
+    if (m_numTokens == m_tokens.size())
+      m_tokens.emplace_back();
+    auto & token = m_tokens[m_numTokens++];
+    token.clear();
+    for (; it != end && !delimiters(*it); ++it)
+      utf8::unchecked::append(*it, back_inserter(token));
+  }
+
+  m_tokenTypes.assign(m_numTokens, Type::Count);
   m_numUsedTokens = 0;
+  m_houseNumberPositionsInQuery.assign(m_numTokens, false);
+  m_numHouseNumberPositions = 0;
+  m_usedTokensPositions.clear();
+  m_beam.Clear();
+  while (!m_layers.empty())
+    PopLayer();
 }
 
 vector<Type> & Geocoder::Context::GetTokenTypes() { return m_tokenTypes; }
 
-size_t Geocoder::Context::GetNumTokens() const { return m_tokens.size(); }
+size_t Geocoder::Context::GetNumTokens() const { return m_numTokens; }
 
 size_t Geocoder::Context::GetNumUsedTokens() const
 {
-  CHECK_LESS_OR_EQUAL(m_numUsedTokens, m_tokens.size(), ());
+  CHECK_LESS_OR_EQUAL(m_numUsedTokens, m_numTokens, ());
   return m_numUsedTokens;
 }
 
@@ -196,13 +262,19 @@ Type Geocoder::Context::GetTokenType(size_t id) const
 
 string const & Geocoder::Context::GetToken(size_t id) const
 {
-  CHECK_LESS(id, m_tokens.size(), ());
+  CHECK_LESS(id, m_numTokens, ());
   return m_tokens[id];
 }
 
+Tokens::const_iterator Geocoder::Context::GetTokenIt(size_t id) const
+{
+  CHECK_LESS_OR_EQUAL(id, m_numTokens, ());
+  return m_tokens.cbegin() + id;
+}
+
 void Geocoder::Context::MarkToken(size_t id, Type type)
 {
-  CHECK_LESS(id, m_tokens.size(), ());
+  CHECK_LESS(id, m_numTokens, ());
   bool wasUsed = m_tokenTypes[id] != Type::Count;
   m_tokenTypes[id] = type;
   bool nowUsed = m_tokenTypes[id] != Type::Count;
@@ -215,34 +287,51 @@ void Geocoder::Context::MarkToken(size_t id, Type type)
 
 bool Geocoder::Context::IsTokenUsed(size_t id) const
 {
-  CHECK_LESS(id, m_tokens.size(), ());
+  CHECK_LESS(id, m_numTokens, ());
   return m_tokenTypes[id] != Type::Count;
 }
 
-bool Geocoder::Context::AllTokensUsed() const { return m_numUsedTokens == m_tokens.size(); }
+bool Geocoder::Context::AllTokensUsed() const { return m_numUsedTokens == m_numTokens; }
+
+Geocoder::Context::UsedTokens Geocoder::Context::SaveUsedTokens()
+{
+  UsedTokens usedTokens;
+  usedTokens.m_begin = static_cast<uint32_t>(m_usedTokensPositions.size());
+  for (size_t tokenPos = 0; tokenPos < m_tokenTypes.size(); ++tokenPos)
+  {
+    auto const t = m_tokenTypes[tokenPos];
+    if (t != Type::Count)
+    {
+      m_usedTokensPositions.push_back(tokenPos);
+      usedTokens.m_types |= 1u << static_cast<size_t>(t);
+    }
+  }
+  usedTokens.m_end = static_cast<uint32_t>(m_usedTokensPositions.size());
+  return usedTokens;
+}
 
 void Geocoder::Context::AddResult(base::GeoObjectId const & osmId, double certainty, Type type,
-                                  vector<size_t> const & tokensPositions,
-                                  vector<Type> const & allTypes, bool isOtherSimilar)
+                                  UsedTokens const & usedTokens, bool isOtherSimilar)
 {
-  m_beam.Add(BeamKey(osmId, type, tokensPositions, allTypes, isOtherSimilar), certainty);
+  m_beam.Add(BeamKey(osmId, type, usedTokens, isOtherSimilar), certainty);
 }
 
-void Geocoder::Context::FillResults(vector<Result> & results) const
+void Geocoder::Context::FillResults(vector<Result> & results)
 {
   results.clear();
   results.reserve(m_beam.GetEntries().size());
 
   auto normalizationCertainty = 0.0;
 
-  set<base::GeoObjectId> seen;
-  bool const hasPotentialHouseNumber = !m_houseNumberPositionsInQuery.empty();
+  m_seenResults.clear();
   for (auto const & e : m_beam.GetEntries())
   {
-    if (!seen.insert(e.m_key.m_osmId).second)
+    auto const seenIt = lower_bound(m_seenResults.begin(), m_seenResults.end(), e.m_key.m_osmId);
+    if (seenIt != m_seenResults.end() && *seenIt == e.m_key.m_osmId)
       continue;
+    m_seenResults.insert(seenIt, e.m_key.m_osmId);
 
-    if (hasPotentialHouseNumber && !IsGoodForPotentialHouseNumberAt(e.m_key, m_houseNumberPositionsInQuery))
+    if (m_numHouseNumberPositions != 0 && !IsGoodForPotentialHouseNumberAt(e.m_key))
       continue;
 
     if (!normalizationCertainty)
@@ -270,22 +359,52 @@ vector<Geocoder::Layer> & Geocoder::Context::GetLayers() { return m_layers; }
 
 vector<Geocoder::Layer> const & Geocoder::Context::GetLayers() const { return m_layers; }
 
-void Geocoder::Context::MarkHouseNumberPositionsInQuery(vector<size_t> const & tokensPositions)
+void Geocoder::Context::PopLayer()
 {
-  m_houseNumberPositionsInQuery.insert(tokensPositions.begin(), tokensPositions.end());
+  CHECK(!m_layers.empty(), ());
+  ReturnCandidatesBuffer(m_layers.back().TakeCandidates());
+  m_layers.pop_back();
 }
 
-bool Geocoder::Context::IsGoodForPotentialHouseNumberAt(
-    BeamKey const & beamKey, set<size_t> const & tokensPositions) const
+vector<Geocoder::Candidate> Geocoder::Context::TakeCandidatesBuffer()
 {
-  if (beamKey.m_tokensPositions.size() == m_tokens.size())
+  if (m_candidatesBuffers.empty())
+    return {};
+
+  auto candidates = move(m_candidatesBuffers.back());
+  m_candidatesBuffers.pop_back();
+  return candidates;
+}
+
+void Geocoder::Context::ReturnCandidatesBuffer(vector<Candidate> && candidates)
+{
+  candidates.clear();
+  m_candidatesBuffers.push_back(move(candidates));
+}
+
+void Geocoder::Context::MarkHouseNumberPositionsInQuery(Subquery const & subquery)
+{
+  for (auto pos = subquery.m_begin; pos < subquery.m_end; ++pos)
+  {
+    CHECK_LESS(pos, m_houseNumberPositionsInQuery.size(), ());
+    if (!m_houseNumberPositionsInQuery[pos])
+    {
+      m_houseNumberPositionsInQuery[pos] = true;
+      ++m_numHouseNumberPositions;
+    }
+  }
+}
+
+bool Geocoder::Context::IsGoodForPotentialHouseNumberAt(BeamKey const & beamKey) const
+{
+  if (beamKey.m_usedTokens.GetNumTokens() == m_numTokens)
     return true;
 
   if (IsBuildingWithAddress(beamKey))
     return true;
 
   // Pass street, locality or region with number in query address parts.
-  if (HasLocalityOrRegion(beamKey) && ContainsTokens(beamKey, tokensPositions))
+  if (HasLocalityOrRegion(beamKey) && ContainsHouseNumberTokens(beamKey))
     return true;
 
   return false;
@@ -296,37 +415,30 @@ bool Geocoder::Context::IsBuildingWithAddress(BeamKey const & beamKey) const
   if (beamKey.m_type != Type::Building)
     return false;
 
-  bool gotLocality = false;
-  bool gotStreet = false;
-  bool gotBuilding = false;
-  for (Type t : beamKey.m_allTypes)
-  {
-    if (t == Type::Region || t == Type::Subregion || t == Type::Locality)
-      gotLocality = true;
-    if (t == Type::Street)
-      gotStreet = true;
-    if (t == Type::Building)
-      gotBuilding = true;
-  }
+  auto const & usedTokens = beamKey.m_usedTokens;
+  bool const gotLocality = HasLocalityOrRegion(beamKey);
+  bool const gotStreet = usedTokens.HasType(Type::Street);
+  bool const gotBuilding = usedTokens.HasType(Type::Building);
   return gotLocality && gotStreet && gotBuilding;
 }
 
 bool Geocoder::Context::HasLocalityOrRegion(BeamKey const & beamKey) const
 {
-  for (Type t : beamKey.m_allTypes)
-  {
-    if (t == Type::Region || t == Type::Subregion || t == Type::Locality)
-      return true;
-  }
-
-  return false;
+  auto const & usedTokens = beamKey.m_usedTokens;
+  return usedTokens.HasType(Type::Region) || usedTokens.HasType(Type::Subregion) ||
+         usedTokens.HasType(Type::Locality);
 }
 
-bool Geocoder::Context::ContainsTokens(BeamKey const & beamKey, set<size_t> const & needTokensPostions) const
+bool Geocoder::Context::ContainsHouseNumberTokens(BeamKey const & beamKey) const
 {
-  auto const & tokensPositions = beamKey.m_tokensPositions;
-  return base::Includes(tokensPositions.begin(), tokensPositions.end(),
-                        needTokensPostions.begin(), needTokensPostions.end());
+  auto const & usedTokens = beamKey.m_usedTokens;
+  size_t numContained = 0;
+  for (auto i = usedTokens.m_begin; i < usedTokens.m_end; ++i)
+  {
+    if (m_houseNumberPositionsInQuery[m_usedTokensPositions[i]])
+      ++numContained;
+  }
+  return numContained == m_numHouseNumberPositions;
 }
 
 // Geocoder ----------------------------------------------------------------------------------------
@@ -395,8 +507,27 @@ void Geocoder::ProcessQuery(string const & query, vector<Result> & results) cons
   });
 #endif
 
-  Context ctx(query);
+  Context ctx;
+  ProcessQuery(query, results, ctx);
+}
+
+void Geocoder::ProcessQuery(string const & query, vector<Result> & results, Stats & stats) const
+{
+  Context ctx;
+  ctx.SetStats(&stats);
+  ProcessQuery(query, results, ctx);
+}
+
+void Geocoder::ProcessQuery(string const & query, vector<Result> & results, Context & ctx) const
+{
+  {
+    ScopedStageTimer tokenizeTimer(StageSeconds(ctx.GetStats(), &Stats::m_tokenizeSeconds));
+    ctx.Reset(query);
+  }
+
   Go(ctx, Type::Country);
+
+  ScopedStageTimer resultsTimer(StageSeconds(ctx.GetStats(), &Stats::m_resultsSeconds));
   ctx.FillResults(results);
 }
 
@@ -415,34 +546,31 @@ void Geocoder::Go(Context & ctx, Type type) const
   if (type == Type::Count)
     return;
 
-  Tokens subquery;
-  vector<size_t> subqueryTokensPositions;
   for (size_t i = 0; i < ctx.GetNumTokens(); ++i)
   {
-    subquery.clear();
-    subqueryTokensPositions.clear();
     for (size_t j = i; j < ctx.GetNumTokens(); ++j)
     {
       if (ctx.IsTokenUsed(j))
         break;
 
-      subquery.push_back(ctx.GetToken(j));
-      subqueryTokensPositions.push_back(j);
+      Subquery const subquery{i, j + 1};
 
       Layer curLayer{m_index, type};
 
       // Buildings are indexed separately.
       if (type == Type::Building)
       {
+        ScopedStageTimer layersTimer(StageSeconds(ctx.GetStats(), &Stats::m_layersSeconds));
         // House building parser has specific tokenizer.
         // Pass biggest house number token sequence to house number matcher.
-        if (IsValidHouseNumberWithNextUnusedToken(ctx, subquery, subqueryTokensPositions))
+        if (IsValidHouseNumberWithNextUnusedToken(ctx, subquery))
           continue;
 
-        FillBuildingsLayer(ctx, subquery, subqueryTokensPositions, curLayer);
+        FillBuildingsLayer(ctx, subquery, curLayer);
       }
       else
       {
+        ScopedStageTimer layersTimer(StageSeconds(ctx.GetStats(), &Stats::m_layersSeconds));
         FillRegularLayer(ctx, type, subquery, curLayer);
       }
 
@@ -455,10 +583,13 @@ void Geocoder::Go(Context & ctx, Type type) const
       if (type == Type::Street)
         MarkStreetSynonym(ctx, streetSynonymMark);
 
-      AddResults(ctx, curLayer.GetCandidatesByCertainty());
+      {
+        ScopedStageTimer beamTimer(StageSeconds(ctx.GetStats(), &Stats::m_beamSeconds));
+        AddResults(ctx, curLayer.GetCandidatesByCertainty());
+      }
 
       ctx.GetLayers().emplace_back(move(curLayer));
-      SCOPE_GUARD(pop, [&] { ctx.GetLayers().pop_back(); });
+      SCOPE_GUARD(pop, [&] { ctx.PopLayer(); });
 
       Go(ctx, NextType(type));
     }
@@ -467,17 +598,21 @@ void Geocoder::Go(Context & ctx, Type type) const
   Go(ctx, NextType(type));
 }
 
-void Geocoder::FillBuildingsLayer(
-    Context & ctx, Tokens const & subquery,
-    vector<size_t> const & subqueryTokensPositions, Layer & curLayer) const
+void Geocoder::FillBuildingsLayer(Context & ctx, Subquery const & subquery,
+                                  Layer & curLayer) const
 {
   if (ctx.GetLayers().empty())
     return;
 
-  auto const & subqueryHN = MakeHouseNumber(subquery);
+  auto & buffers = ctx.GetSubqueryBuffers();
+  auto const & subqueryHN = buffers.m_houseNumber;
+  MakeHouseNumber(ctx, subquery.m_begin, subquery.m_end, buffers.m_houseNumber);
 
-  if (!search::house_numbers::LooksLikeHouseNumber(subqueryHN, false /* isPrefix */))
+  if (!search::house_numbers::LooksLikeHouseNumber(subqueryHN, false /* isPrefix */,
+                                                   buffers.m_houseNumberParse))
+  {
     return;
+  }
 
   for (auto const & layer : boost::adaptors::reverse(ctx.GetLayers()))
   {
@@ -487,12 +622,15 @@ void Geocoder::FillBuildingsLayer(
     // We've already filled a street/location layer and now see something that resembles
     // a house number. While it still can be something else (a zip code, for example)
     // let's stay on the safer side and mark the tokens as potential house number.
-    ctx.MarkHouseNumberPositionsInQuery(subqueryTokensPositions);
+    ctx.MarkHouseNumberPositionsInQuery(subquery);
 
-    auto subqueryNumberParse = std::vector<search::house_numbers::Token>{};
+    auto & subqueryNumberParse = buffers.m_houseNumberParse;
+    subqueryNumberParse.clear();
     ParseQuery(subqueryHN, false /* queryIsPrefix */, subqueryNumberParse);
+    auto const & encodedSubqueryNumberParse = buffers.m_encodedHouseNumberParse;
+    search::house_numbers::EncodeParse(subqueryNumberParse, buffers.m_encodedHouseNumberParse);
 
-    auto candidates = std::vector<Candidate>{};
+    auto candidates = ctx.TakeCandidatesBuffer();
 
     auto const & lastLayer = ctx.GetLayers().back();
     auto const forSublocalityLayer =
@@ -500,42 +638,45 @@ void Geocoder::FillBuildingsLayer(
     for (auto const & buildingOwnerCandidate : layer.GetCandidatesByCertainty())
     {
       auto const & docId = buildingOwnerCandidate.m_entry;
-      m_index.ForEachRelatedBuilding(docId, [&](Index::DocId const & buildingDocId) {
-        auto const & building = m_index.GetDoc(buildingDocId);
-        auto const & multipleHN = building.GetNormalizedMultipleNames(
-            Type::Building, m_hierarchy.GetNormalizedNameDictionary());
-        auto const & realHN = multipleHN.GetMainName();
-        auto const & realHNUniStr = strings::MakeUniString(realHN);
-        auto matchResult = search::house_numbers::MatchResult{};
-        if (search::house_numbers::HouseNumbersMatch(realHNUniStr, subqueryNumberParse, matchResult))
-        {
-          auto && parentCandidateCertainty =
-              forSublocalityLayer ? FindMaxCertaintyInParentCandidates(ctx.GetLayers(), building)
-                                  : boost::optional<double>{buildingOwnerCandidate.m_totalCertainty};
-          if (!parentCandidateCertainty)
-            return;
-
-          auto const totalCertainty =
-              *parentCandidateCertainty + SumHouseNumberSubqueryCertainty(matchResult);
-          auto const isOtherSimilar =
-              matchResult.queryMismatchedTokensCount || matchResult.houseNumberMismatchedTokensCount;
-          candidates.push_back({buildingDocId, totalCertainty, isOtherSimilar});
-        }
-      });
+      // House numbers of the buildings are parsed at index build time, only the buildings
+      // whose numbers start with the same token as the query are compared.
+      m_index.ForEachRelatedBuildingMatch(
+          docId, encodedSubqueryNumberParse,
+          [&](Index::DocId const & buildingDocId,
+              search::house_numbers::MatchResult const & matchResult) {
+            auto const & building = m_index.GetDoc(buildingDocId);
+            auto && parentCandidateCertainty =
+                forSublocalityLayer
+                    ? FindMaxCertaintyInParentCandidates(ctx.GetLayers(), building)
+                    : boost::optional<double>{buildingOwnerCandidate.m_totalCertainty};
+            if (!parentCandidateCertainty)
+              return;
+
+            auto const totalCertainty =
+                *parentCandidateCertainty + SumHouseNumberSubqueryCertainty(matchResult);
+            auto const isOtherSimilar = matchResult.queryMismatchedTokensCount ||
+                                        matchResult.houseNumberMismatchedTokensCount;
+            candidates.push_back({buildingDocId, totalCertainty, isOtherSimilar});
+          });
     }
 
     if (!candidates.empty())
       curLayer.SetCandidates(std::move(candidates));
+    else
+      ctx.ReturnCandidatesBuffer(std::move(candidates));
     break;
   }
 }
 
-void Geocoder::FillRegularLayer(Context const & ctx, Type type, Tokens const & subquery,
+void Geocoder::FillRegularLayer(Context & ctx, Type type, Subquery const & subquery,
                                 Layer & curLayer) const
 {
-  auto candidates = std::vector<Candidate>{};
+  auto candidates = ctx.TakeCandidatesBuffer();
 
-  m_index.ForEachDocId(subquery, [&](Index::DocId const & docId) {
+  auto const subqueryBegin = ctx.GetTokenIt(subquery.m_begin);
+  auto const subqueryEnd = ctx.GetTokenIt(subquery.m_end);
+  auto & indexKey = ctx.GetSubqueryBuffers().m_indexKey;
+  m_index.ForEachDocId(subqueryBegin, subqueryEnd, indexKey, [&](Index::DocId const & docId) {
     auto const & d = m_index.GetDoc(docId);
     if (d.m_type != type)
       return;
@@ -548,7 +689,8 @@ void Geocoder::FillRegularLayer(Context const & ctx, Type type, Tokens const & s
       return;
 
     auto const subqueryWeight =
-        (d.m_kind != Kind::Unknown ? GetWeight(d.m_kind) : GetWeight(d.m_type)) * subquery.size();
+        (d.m_kind != Kind::Unknown ? GetWeight(d.m_kind) : GetWeight(d.m_type)) *
+        subquery.GetNumTokens();
     auto const totalCertainty = *parentCandidateCertainty + subqueryWeight;
 
     candidates.push_back({docId, totalCertainty, false /* m_isOtherSimilar */});
@@ -556,22 +698,13 @@ void Geocoder::FillRegularLayer(Context const & ctx, Type type, Tokens const & s
 
   if (!candidates.empty())
     curLayer.SetCandidates(std::move(candidates));
+  else
+    ctx.ReturnCandidatesBuffer(std::move(candidates));
 }
 
 void Geocoder::AddResults(Context & ctx, std::vector<Candidate> const & candidates) const
 {
-  vector<size_t> tokensPositions;
-  vector<Type> allTypes;
-  for (size_t tokenPos = 0; tokenPos < ctx.GetNumTokens(); ++tokenPos)
-  {
-    auto const t = ctx.GetTokenType(tokenPos);
-    if (t != Type::Count)
-    {
-      tokensPositions.push_back(tokenPos);
-      allTypes.push_back(t);
-    }
-  }
-
+  auto const usedTokens = ctx.SaveUsedTokens();
   for (auto const & candidate : candidates)
   {
     auto const & docId = candidate.m_entry;
@@ -587,24 +720,22 @@ void Geocoder::AddResults(Context & ctx, std::vector<Candidate> const & candidat
       entryCertainty += kCityStateExtraWeight;
     }
 
-    ctx.AddResult(entry.m_osmId, entryCertainty, entry.m_type, tokensPositions, allTypes,
+    ctx.AddResult(entry.m_osmId, entryCertainty, entry.m_type, usedTokens,
                   candidate.m_isOtherSimilar);
   }
 }
 
-bool Geocoder::IsValidHouseNumberWithNextUnusedToken(
-    Context const & ctx, Tokens const & subquery,
-    vector<size_t> const & subqueryTokensPositions) const
+bool Geocoder::IsValidHouseNumberWithNextUnusedToken(Context & ctx,
+                                                     Subquery const & subquery) const
 {
-  auto const nextTokenPos = subqueryTokensPositions.back() + 1;
+  auto const nextTokenPos = subquery.m_end;
   if (nextTokenPos >= ctx.GetNumTokens() || ctx.IsTokenUsed(nextTokenPos))
     return false;
 
-  auto subqueryHouseNumber = MakeHouseNumber(subquery);
-  subqueryHouseNumber += strings::MakeUniString(" ");
-  subqueryHouseNumber += strings::MakeUniString(ctx.GetToken(nextTokenPos));
-
-  return search::house_numbers::LooksLikeHouseNumber(subqueryHouseNumber, false /* isPrefix */);
+  auto & buffers = ctx.GetSubqueryBuffers();
+  MakeHouseNumber(ctx, subquery.m_begin, nextTokenPos + 1, buffers.m_houseNumber);
+  return search::house_numbers::LooksLikeHouseNumber(buffers.m_houseNumber, false /* isPrefix */,
+                                                     buffers.m_houseNumberParse);
 }
 
 double Geocoder::SumHouseNumberSubqueryCertainty(
@@ -683,9 +814,10 @@ boost::optional<double> Geocoder::FindMaxCertaintyInParentCandidates(
 }
 
 bool Geocoder::IsRelevantLocalityMember(Context const & ctx, Hierarchy::Entry const & member,
-                                        Tokens const & subquery) const
+                                        Subquery const & subquery) const
 {
-  auto const isNumeric = subquery.size() == 1 && strings::IsASCIINumeric(subquery.front());
+  auto const isNumeric =
+      subquery.GetNumTokens() == 1 && strings::IsASCIINumeric(ctx.GetToken(subquery.m_begin));
   return !isNumeric || HasMemberLocalityInMatching(ctx, member);
 }
 
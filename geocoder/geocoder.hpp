@@ -12,7 +12,7 @@
 #include "base/string_utils.hpp"
 
 #include <cstddef>
-#include <set>
+#include <cstdint>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -47,6 +47,15 @@ public:
   DECLARE_EXCEPTION(Exception, RootException);
   DECLARE_EXCEPTION(OpenException, Exception);
 
+  // Time spent by ProcessQuery() in its stages, accumulated over queries.
+  struct Stats
+  {
+    double m_tokenizeSeconds = 0.0;
+    double m_layersSeconds = 0.0;
+    double m_beamSeconds = 0.0;
+    double m_resultsSeconds = 0.0;
+  };
+
   // Candidate contain matched entry with certainty of all matched tokens.
   struct Candidate
   {
@@ -55,6 +64,15 @@ public:
     bool m_isOtherSimilar;
   };
 
+  // Tokens [m_begin, m_end) of the query.
+  struct Subquery
+  {
+    size_t GetNumTokens() const { return m_end - m_begin; }
+
+    size_t m_begin = 0;
+    size_t m_end = 0;
+  };
+
   // A Layer contains all entries matched by a subquery of consecutive tokens.
   class Layer
   {
@@ -67,6 +85,7 @@ public:
       return m_candidatesByCertainty;
     }
     void SetCandidates(std::vector<Candidate> && candidates);
+    std::vector<Candidate> TakeCandidates() { return std::move(m_candidatesByCertainty); }
 
   private:
     Index const & m_index;
@@ -76,32 +95,53 @@ public:
 
   // This class is very similar to the one we use in search/.
   // See search/geocoder_context.hpp.
+  //
+  // A context may be reused by consecutive queries of one thread: all its buffers keep
+  // their memory between queries.
   class Context
   {
   public:
+    // Positions and types of the tokens used by a result. The positions are stored
+    // in the context as [m_begin, m_end) range.
+    struct UsedTokens
+    {
+      uint32_t m_begin = 0;
+      uint32_t m_end = 0;
+      // Bit mask of types.
+      uint32_t m_types = 0;
+
+      size_t GetNumTokens() const { return m_end - m_begin; }
+      bool HasType(Type type) const { return (m_types >> static_cast<size_t>(type)) & 1; }
+    };
+
     struct BeamKey
     {
-      BeamKey(base::GeoObjectId osmId, Type type, std::vector<size_t> const & tokensPositions,
-              std::vector<Type> const & allTypes, bool isOtherSimilar)
-        : m_osmId(osmId)
-        , m_type(type)
-        , m_tokensPositions{tokensPositions}
-        , m_allTypes(allTypes)
-        , m_isOtherSimilar(isOtherSimilar)
+      BeamKey(base::GeoObjectId osmId, Type type, UsedTokens const & usedTokens,
+              bool isOtherSimilar)
+        : m_osmId(osmId), m_type(type), m_usedTokens(usedTokens), m_isOtherSimilar(isOtherSimilar)
       {
-        base::SortUnique(m_allTypes);
       }
 
       base::GeoObjectId m_osmId;
       Type m_type;
-      std::vector<size_t> m_tokensPositions;
-      std::vector<Type> m_allTypes;
+      UsedTokens m_usedTokens;
       bool m_isOtherSimilar;
     };
 
-    Context(std::string const & query);
+    // Buffers for processing of a single subquery, they are shared by all subqueries.
+    struct SubqueryBuffers
+    {
+      std::string m_indexKey;
+      strings::UniString m_houseNumber;
+      std::vector<search::house_numbers::Token> m_houseNumberParse;
+      std::string m_encodedHouseNumberParse;
+    };
+
+    Context();
+    explicit Context(std::string const & query);
 
-    void Clear();
+    // Prepares the context for |query|.
+    void Reset(std::string const & query);
 
     std::vector<Type> & GetTokenTypes();
     size_t GetNumTokens() const;
@@ -110,6 +150,9 @@ public:
     Type GetTokenType(size_t id) const;
 
     std::string const & GetToken(size_t id) const;
+    // Returns the iterator to the token |id| or to the end of the tokens if |id| is the number
+    // of the tokens.
+    Tokens::const_iterator GetTokenIt(size_t id) const;
 
     void MarkToken(size_t id, Type type);
 
@@ -119,42 +162,72 @@ public:
     // Returns true iff all tokens are used.
     bool AllTokensUsed() const;
 
+    // Saves positions and types of the currently used tokens.
+    UsedTokens SaveUsedTokens();
+
     void AddResult(base::GeoObjectId const & osmId, double certainty, Type type,
-                   std::vector<size_t> const & tokensPositions, std::vector<Type> const & allTypes,
-                   bool isOtherSimilar);
+                   UsedTokens const & usedTokens, bool isOtherSimilar);
 
-    void FillResults(std::vector<Result> & results) const;
+    void FillResults(std::vector<Result> & results);
 
     std::vector<Layer> & GetLayers();
 
     std::vector<Layer> const & GetLayers() const;
 
-    void MarkHouseNumberPositionsInQuery(std::vector<size_t> const & tokensPositions);
+    // Pops the last layer and keeps its candidates buffer for TakeCandidatesBuffer().
+    void PopLayer();
+
+    // Returns an empty buffer for layer candidates.
+    std::vector<Candidate> TakeCandidatesBuffer();
+    void ReturnCandidatesBuffer(std::vector<Candidate> && candidates);
+
+    SubqueryBuffers & GetSubqueryBuffers() { return m_subqueryBuffers; }
+
+    // |stats| may be null when stage timings are not needed.
+    void SetStats(Stats * stats) { m_stats = stats; }
+    Stats * GetStats() const { return m_stats; }
+
+    void MarkHouseNumberPositionsInQuery(Subquery const & subquery);
 
   private:
-    bool IsGoodForPotentialHouseNumberAt(BeamKey const & beamKey,
-                                         std::set<size_t> const & tokensPositions) const;
+    bool IsGoodForPotentialHouseNumberAt(BeamKey const & beamKey) const;
     bool IsBuildingWithAddress(BeamKey const & beamKey) const;
     bool HasLocalityOrRegion(BeamKey const & beamKey) const;
-    bool ContainsTokens(BeamKey const & beamKey, std::set<size_t> const & needTokensPostions) const;
+    bool ContainsHouseNumberTokens(BeamKey const & beamKey) const;
 
+    strings::UniString m_normalizedQuery;
+    // Tokens of the query are the first |m_numTokens| strings, the rest keep their memory for
+    // next queries.
     Tokens m_tokens;
+    size_t m_numTokens = 0;
     std::vector<Type> m_tokenTypes;
 
     size_t m_numUsedTokens = 0;
 
-    // |m_houseNumberPositionsInQuery| has indexes of query tokens which are placed on
+    // |m_houseNumberPositionsInQuery| marks query tokens which are placed on
     // context-dependent positions of house number.
     // The rationale is that we must only emit buildings in this case
     // and implement a fallback to a more powerful geocoder if we
     // could not find a building.
-    std::set<size_t> m_houseNumberPositionsInQuery;
+    std::vector<bool> m_houseNumberPositionsInQuery;
+    size_t m_numHouseNumberPositions = 0;
+
+    // Token positions of all beam keys.
+    std::vector<size_t> m_usedTokensPositions;
 
     // The highest value of certainty for a fixed amount of
     // the most relevant retrieved osm ids.
     base::Beam<BeamKey, double> m_beam;
 
     std::vector<Layer> m_layers;
+    std::vector<std::vector<Candidate>> m_candidatesBuffers;
+
+    SubqueryBuffers m_subqueryBuffers;
+
+    // Sorted osm ids of emitted results.
+    std::vector<base::GeoObjectId> m_seenResults;
+
+    Stats * m_stats = nullptr;
   };
 
   void LoadFromJsonl(std::string const & pathToJsonHierarchy, bool dataVersionHeadline = false,
@@ -172,6 +245,14 @@ public:
   }
 
   void ProcessQuery(std::string const & query, std::vector<Result> & results) const;
+  // Same as above and adds stage timings of the query to |stats|.
+  void ProcessQuery(std::string const & query, std::vector<Result> & results,
+                    Stats & stats) const;
+  // Same as above with the caller's |ctx| which is reset for |query|. Reusing one context
+  // per thread saves the allocations of the query state. Stage timings are added to
+  // ctx.GetStats() if it is set.
+  void ProcessQuery(std::string const & query, std::vector<Result> & results,
+                    Context & ctx) const;
 
   Hierarchy const & GetHierarchy() const;
 
@@ -180,16 +261,12 @@ public:
 private:
   void Go(Context & ctx, Type type) const;
 
-  void FillBuildingsLayer(Context & ctx, Tokens const & subquery,
-                          std::vector<size_t> const & subqueryTokensPositions,
-                          Layer & curLayer) const;
-  void FillRegularLayer(Context const & ctx, Type type, Tokens const & subquery,
+  void FillBuildingsLayer(Context & ctx, Subquery const & subquery, Layer & curLayer) const;
+  void FillRegularLayer(Context & ctx, Type type, Subquery const & subquery,
                         Layer & curLayer) const;
   void AddResults(Context & ctx, std::vector<Candidate> const & candidates) const;
 
-  bool IsValidHouseNumberWithNextUnusedToken(
-      Context const & ctx, Tokens const & subquery,
-      std::vector<size_t> const & subqueryTokensPositions) const;
+  bool IsValidHouseNumberWithNextUnusedToken(Context & ctx, Subquery const & subquery) const;
   double SumHouseNumberSubqueryCertainty(
       search::house_numbers::MatchResult const & matchResult) const;
 
@@ -202,7 +279,7 @@ private:
       std::vector<Geocoder::Layer> const & layers, Hierarchy::Entry const & e) const;
 
   bool IsRelevantLocalityMember(Context const & ctx, Hierarchy::Entry const & member,
-                                Tokens const & subquery) const;
+                                Subquery const & subquery) const;
   bool HasMemberLocalityInMatching(Context const & ctx, Hierarchy::Entry const & member) const;
 
   Hierarchy m_hierarchy;
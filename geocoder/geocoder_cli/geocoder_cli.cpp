@@ -1,13 +1,32 @@
 #include "geocoder/geocoder.hpp"
 #include "geocoder/result.hpp"
 
+#include "indexer/covering_index.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/json.hpp"
+#include "coding/reader.hpp"
+
+#include "geometry/mercator.hpp"
+
 #include "base/internal/message.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
+#include "base/timer.hpp"
+
+#include "3party/rapidjson/stringbuffer.h"
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -16,6 +35,30 @@ using namespace std;
 
 namespace po = boost::program_options;
 
+using GeoObjectsIndex = indexer::GeoObjectsIndex<ReaderPtr<Reader>>;
+
+void PrintAddress(Hierarchy const & hierarchy, base::GeoObjectId const & osmId)
+{
+  auto const && e = hierarchy.GetEntryForOsmId(osmId);
+  if (!e)
+    return;
+
+  auto const & dictionary = hierarchy.GetNormalizedNameDictionary();
+  cout << " [";
+  auto const * delimiter = "";
+  for (size_t i = 0; i < static_cast<size_t>(Type::Count); ++i)
+  {
+    if (e->m_normalizedAddress[i] != NameDictionary::kUnspecifiedPosition)
+    {
+      auto type = static_cast<Type>(i);
+      auto multipleNames = e->GetNormalizedMultipleNames(type, dictionary);
+      cout << delimiter << ToString(type) << ": " << multipleNames.GetMainName();
+      delimiter = ", ";
+    }
+  }
+  cout << "]";
+}
+
 void PrintResults(Hierarchy const & hierarchy, vector<Result> const & results, int32_t top)
 {
   cout << "Found results: " << results.size() << endl;
@@ -23,32 +66,46 @@ void PrintResults(Hierarchy const & hierarchy, vector<Result> const & results, i
     return;
   cout << "Top results:" << endl;
 
-  auto const & dictionary = hierarchy.GetNormalizedNameDictionary();
   for (size_t i = 0; i < results.size(); ++i)
   {
     if (top >= 0 && static_cast<int32_t>(i) >= top)
       break;
     cout << "  " << DebugPrint(results[i]);
-    if (auto const && e = hierarchy.GetEntryForOsmId(results[i].m_osmId))
-    {
-      cout << " [";
-      auto const * delimiter = "";
-      for (size_t i = 0; i < static_cast<size_t>(Type::Count); ++i)
-      {
-        if (e->m_normalizedAddress[i] != NameDictionary::kUnspecifiedPosition)
-        {
-          auto type = static_cast<Type>(i);
-          auto multipleNames = e->GetNormalizedMultipleNames(type, dictionary);
-          cout << delimiter << ToString(type) << ": " << multipleNames.GetMainName();
-          delimiter = ", ";
-        }
-      }
-      cout << "]";
-    }
+    PrintAddress(hierarchy, results[i].m_osmId);
     cout << endl;
   }
 }
 
+// Prints objects of |index| nearest to the "lat,lon" |point| in order of increasing distance to
+// their geometry.
+bool PrintNearestObjects(Hierarchy const & hierarchy, GeoObjectsIndex const & index,
+                         string const & point, double radiusM, int32_t top)
+{
+  vector<string> latLon;
+  strings::ParseCSVRow(point, ',', latLon);
+  double lat = 0.0;
+  double lon = 0.0;
+  if (latLon.size() != 2 || !strings::to_double(latLon[0], lat) ||
+      !strings::to_double(latLon[1], lon))
+  {
+    std::cerr << "ERROR: bad point " << point << ", lat,lon is expected" << std::endl;
+    return false;
+  }
+
+  auto const k = top >= 0 ? static_cast<uint32_t>(top) : numeric_limits<uint32_t>::max();
+  size_t found = 0;
+  index.ForNearestToPoint(
+      [&](base::GeoObjectId const & osmId, double distanceM) {
+        cout << "  " << DebugPrint(osmId) << " " << fixed << setprecision(1) << distanceM << " m";
+        PrintAddress(hierarchy, osmId);
+        cout << endl;
+        ++found;
+      },
+      MercatorBounds::FromLatLon(lat, lon), radiusM, k);
+  cout << "Found objects: " << found << endl;
+  return true;
+}
+
 void ProcessQueriesFromFile(Geocoder const & geocoder, string const & path, int32_t top)
 {
   ifstream stream(path.c_str());
@@ -69,6 +126,170 @@ void ProcessQueriesFromFile(Geocoder const & geocoder, string const & path, int3
   }
 }
 
+vector<string> ReadQueries(string const & path)
+{
+  ifstream stream(path.c_str());
+  CHECK(stream.is_open(), ("Can't open", path));
+
+  vector<string> queries;
+  string s;
+  while (getline(stream, s))
+  {
+    strings::Trim(s);
+    if (!s.empty())
+      queries.push_back(move(s));
+  }
+  return queries;
+}
+
+struct BatchReport
+{
+  size_t m_queries = 0;
+  size_t m_threads = 0;
+  double m_totalSeconds = 0.0;
+  // Sorted latencies of all measured queries.
+  vector<double> m_latencies;
+  Geocoder::Stats m_stats;
+};
+
+double Percentile(vector<double> const & sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+  auto const rank = static_cast<size_t>(ceil(p * sorted.size()));
+  return sorted[min(max(rank, size_t{1}), sorted.size()) - 1];
+}
+
+// Runs |warmup| passes and then one measured pass over |queries| on |threads| threads.
+BatchReport RunBatch(Geocoder const & geocoder, vector<string> const & queries, size_t threads,
+                     size_t warmup)
+{
+  struct WorkerResult
+  {
+    vector<double> m_latencies;
+    Geocoder::Stats m_stats;
+  };
+
+  base::thread_pool::computational::ThreadPool pool(threads);
+  auto const runPass = [&](bool measure) {
+    atomic<size_t> next{0};
+    vector<future<WorkerResult>> futures;
+    for (size_t i = 0; i < threads; ++i)
+    {
+      futures.push_back(pool.Submit([&]() {
+        WorkerResult result;
+        Geocoder::Context ctx;
+        if (measure)
+          ctx.SetStats(&result.m_stats);
+
+        vector<Result> results;
+        for (auto q = next++; q < queries.size(); q = next++)
+        {
+          base::Timer timer;
+          geocoder.ProcessQuery(queries[q], results, ctx);
+          if (measure)
+            result.m_latencies.push_back(timer.ElapsedSeconds());
+        }
+        return result;
+      }));
+    }
+
+    vector<WorkerResult> workerResults;
+    for (auto & f : futures)
+      workerResults.push_back(f.get());
+    return workerResults;
+  };
+
+  for (size_t i = 0; i < warmup; ++i)
+    runPass(false /* measure */);
+
+  BatchReport report;
+  report.m_queries = queries.size();
+  report.m_threads = threads;
+
+  base::Timer timer;
+  auto const workerResults = runPass(true /* measure */);
+  report.m_totalSeconds = timer.ElapsedSeconds();
+
+  for (auto const & r : workerResults)
+  {
+    report.m_latencies.insert(report.m_latencies.end(), r.m_latencies.begin(),
+                              r.m_latencies.end());
+    report.m_stats.m_tokenizeSeconds += r.m_stats.m_tokenizeSeconds;
+    report.m_stats.m_layersSeconds += r.m_stats.m_layersSeconds;
+    report.m_stats.m_beamSeconds += r.m_stats.m_beamSeconds;
+    report.m_stats.m_resultsSeconds += r.m_stats.m_resultsSeconds;
+  }
+  sort(report.m_latencies.begin(), report.m_latencies.end());
+  return report;
+}
+
+void PrintBatchReport(BatchReport const & report)
+{
+  auto const ms = [](double seconds) { return seconds * 1000.0; };
+  auto const qps = report.m_totalSeconds > 0 ? report.m_queries / report.m_totalSeconds : 0.0;
+  auto const & latencies = report.m_latencies;
+  auto const & stats = report.m_stats;
+
+  cout << fixed << setprecision(3);
+  cout << "Queries: " << report.m_queries << ", threads: " << report.m_threads << endl;
+  cout << "Total time: " << report.m_totalSeconds << " s, QPS: " << qps << endl;
+  cout << "Latency, ms: p50 " << ms(Percentile(latencies, 0.5)) << ", p95 "
+       << ms(Percentile(latencies, 0.95)) << ", p99 " << ms(Percentile(latencies, 0.99))
+       << ", max " << ms(latencies.empty() ? 0.0 : latencies.back()) << endl;
+  cout << "Stages, total ms: tokenize " << ms(stats.m_tokenizeSeconds) << ", layer fill "
+       << ms(stats.m_layersSeconds) << ", beam " << ms(stats.m_beamSeconds) << ", results "
+       << ms(stats.m_resultsSeconds) << endl;
+}
+
+void SaveBatchReport(BatchReport const & report, string const & path)
+{
+  auto const qps = report.m_totalSeconds > 0 ? report.m_queries / report.m_totalSeconds : 0.0;
+  auto const & latencies = report.m_latencies;
+  auto const & stats = report.m_stats;
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("queries");
+  writer.Uint64(report.m_queries);
+  writer.Key("threads");
+  writer.Uint64(report.m_threads);
+  writer.Key("total_seconds");
+  writer.Double(report.m_totalSeconds);
+  writer.Key("qps");
+  writer.Double(qps);
+
+  writer.Key("latency_seconds");
+  writer.StartObject();
+  writer.Key("p50");
+  writer.Double(Percentile(latencies, 0.5));
+  writer.Key("p95");
+  writer.Double(Percentile(latencies, 0.95));
+  writer.Key("p99");
+  writer.Double(Percentile(latencies, 0.99));
+  writer.Key("max");
+  writer.Double(latencies.empty() ? 0.0 : latencies.back());
+  writer.EndObject();
+
+  writer.Key("stage_seconds");
+  writer.StartObject();
+  writer.Key("tokenize");
+  writer.Double(stats.m_tokenizeSeconds);
+  writer.Key("layer_fill");
+  writer.Double(stats.m_layersSeconds);
+  writer.Key("beam");
+  writer.Double(stats.m_beamSeconds);
+  writer.Key("results");
+  writer.Double(stats.m_resultsSeconds);
+  writer.EndObject();
+  writer.EndObject();
+
+  ofstream stream(path.c_str());
+  CHECK(stream.is_open(), ("Can't open", path));
+  stream << buffer.GetString() << endl;
+}
+
 void ProcessQueriesFromCommandLine(Geocoder const & geocoder, int32_t top)
 {
   string query;
@@ -90,6 +311,13 @@ struct CliCommandOptions
   std::string m_hierarchy_path;
   std::string m_queries_path;
   int32_t m_top;
+  bool m_batch;
+  size_t m_threads;
+  size_t m_warmup;
+  std::string m_json_path;
+  std::string m_geo_objects_index;
+  std::string m_nearest_to;
+  double m_nearest_radius;
 };
 
 CliCommandOptions DefineOptions(int argc, char * argv[])
@@ -101,6 +329,13 @@ CliCommandOptions DefineOptions(int argc, char * argv[])
     ("hierarchy_path", po::value(&o.m_hierarchy_path), "Path to the hierarchy file for the geocoder")
     ("queries_path", po::value(&o.m_queries_path)->default_value(""), "Path to the file with queries")
     ("top", po::value(&o.m_top)->default_value(5), "Number of top results to show for every query, -1 to show all results")
+    ("batch", po::bool_switch(&o.m_batch), "Benchmark queries from queries_path instead of printing results")
+    ("threads", po::value(&o.m_threads)->default_value(1), "Number of threads for the batch mode")
+    ("warmup", po::value(&o.m_warmup)->default_value(1), "Number of unmeasured passes over the queries in the batch mode")
+    ("json_path", po::value(&o.m_json_path)->default_value(""), "Path to save the batch mode report as json")
+    ("geo_objects_index", po::value(&o.m_geo_objects_index)->default_value(""), "Path to the geo objects index for reverse lookups")
+    ("nearest_to", po::value(&o.m_nearest_to)->default_value(""), "Point lat,lon to print top objects of geo_objects_index nearest to")
+    ("nearest_radius", po::value(&o.m_nearest_radius)->default_value(1000.0), "Radius in meters of the nearest objects search")
     ("help", "produce help message");
 
   po::variables_map vm;
@@ -142,6 +377,47 @@ int main(int argc, char * argv[])
     geocoder.LoadFromBinaryIndex(options.m_hierarchy_path);
   }
 
+  if (!options.m_nearest_to.empty())
+  {
+    if (options.m_geo_objects_index.empty())
+    {
+      std::cerr << "ERROR: nearest_to needs geo_objects_index" << std::endl;
+      return 1;
+    }
+
+    auto const index =
+        indexer::ReadIndex<indexer::GeoObjectsIndexBox<ReaderPtr<Reader>>, FileReader>(
+            options.m_geo_objects_index);
+    if (!index.HasGeometry())
+    {
+      std::cerr << "ERROR: geo_objects_index has no geometry of objects, generate it with "
+                << "--geo_objects_index_geometry" << std::endl;
+      return 1;
+    }
+
+    return PrintNearestObjects(geocoder.GetHierarchy(), index, options.m_nearest_to,
+                               options.m_nearest_radius, options.m_top)
+               ? 0
+               : 1;
+  }
+
+  if (options.m_batch)
+  {
+    if (options.m_queries_path.empty() || options.m_threads == 0)
+    {
+      std::cerr << "ERROR: batch mode needs queries_path and a positive number of threads"
+                << std::endl;
+      return 1;
+    }
+
+    auto const report = RunBatch(geocoder, ReadQueries(options.m_queries_path),
+                                 options.m_threads, options.m_warmup);
+    PrintBatchReport(report);
+    if (!options.m_json_path.empty())
+      SaveBatchReport(report, options.m_json_path);
+    return 0;
+  }
+
   if (!options.m_queries_path.empty())
   {
     ProcessQueriesFromFile(geocoder, options.m_queries_path, options.m_top);
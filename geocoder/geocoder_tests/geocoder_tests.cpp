@@ -63,6 +63,51 @@ UNIT_TEST(Geocoder_Smoke)
   TestGeocoder(geocoder, "florencia somewhere in cuba", {{cubaId, 0.713776}, {florenciaId, 1.0}});
 }
 
+UNIT_TEST(Geocoder_StageStats)
+{
+  Geocoder geocoder;
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  geocoder.LoadFromJsonl(regionsJsonFile.GetFullPath());
+
+  vector<Result> expected;
+  geocoder.ProcessQuery("cuba florencia", expected);
+
+  Geocoder::Stats stats;
+  vector<Result> actual;
+  geocoder.ProcessQuery("cuba florencia", actual, stats);
+  TEST_EQUAL(actual.size(), expected.size(), ());
+  for (size_t i = 0; i < actual.size(); ++i)
+    TEST_EQUAL(actual[i].m_osmId, expected[i].m_osmId, ());
+  TEST_GREATER(stats.m_tokenizeSeconds, 0.0, ());
+  TEST_GREATER(stats.m_layersSeconds, 0.0, ());
+  TEST_GREATER(stats.m_beamSeconds, 0.0, ());
+  TEST_GREATER(stats.m_resultsSeconds, 0.0, ());
+}
+
+UNIT_TEST(Geocoder_ReusedContext)
+{
+  Geocoder geocoder;
+  ScopedFile const regionsJsonFile("regions.jsonl", kRegionsData);
+  geocoder.LoadFromJsonl(regionsJsonFile.GetFullPath());
+
+  Geocoder::Context ctx;
+  for (auto const & query : {"cuba florencia", "florencia", "", "florencia somewhere in cuba",
+                             "cuba florencia"})
+  {
+    vector<Result> expected;
+    geocoder.ProcessQuery(query, expected);
+
+    vector<Result> actual;
+    geocoder.ProcessQuery(query, actual, ctx);
+    TEST_EQUAL(actual.size(), expected.size(), (query));
+    for (size_t i = 0; i < actual.size(); ++i)
+    {
+      TEST_EQUAL(actual[i].m_osmId, expected[i].m_osmId, (query));
+      TEST_NEAR(actual[i].m_certainty, expected[i].m_certainty, kCertaintyEps, (query));
+    }
+  }
+}
+
 UNIT_TEST(Geocoder_Hierarchy)
 {
   Geocoder geocoder;
@@ -193,6 +238,38 @@ UNIT_TEST(Geocoder_HouseNumberPartialMatch)
   TestGeocoder(geocoder, "Москва, Зорге 7 A", {{Id{0x12}, 0.95}});
 }
 
+UNIT_TEST(Geocoder_HouseNumbersIndex)
+{
+  string const kData = R"#(
+10 {"properties": {"kind": "city", "locales": {"default": {"address": {"locality": "Москва"}}}}}
+11 {"properties": {"kind": "street", "locales": {"default": {"address": {"street": "Зорге", "locality": "Москва"}}}}}
+12 {"properties": {"kind": "building", "locales": {"default": {"address": {"building": "12", "street": "Зорге", "locality": "Москва"}}}}}
+13 {"properties": {"kind": "building", "locales": {"default": {"address": {"building": "12к3", "street": "Зорге", "locality": "Москва"}}}}}
+14 {"properties": {"kind": "building", "locales": {"default": {"address": {"building": "120", "street": "Зорге", "locality": "Москва"}}}}}
+15 {"properties": {"kind": "building", "locales": {"default": {"address": {"building": "2", "street": "Зорге", "locality": "Москва"}}}}}
+16 {"properties": {"kind": "building", "locales": {"default": {"address": {"building": "14, 12", "street": "Зорге", "locality": "Москва"}}}}}
+)#";
+
+  Geocoder geocoderFromJsonl;
+  ScopedFile const regionsJsonFile("regions.jsonl", kData);
+  geocoderFromJsonl.LoadFromJsonl(regionsJsonFile.GetFullPath());
+
+  ScopedFile const regionsTokenIndexFile("regions.tokidx", ScopedFile::Mode::DoNotCreate);
+  geocoderFromJsonl.SaveToBinaryIndex(regionsTokenIndexFile.GetFullPath());
+
+  Geocoder geocoderFromTokenIndex;
+  geocoderFromTokenIndex.LoadFromBinaryIndex(regionsTokenIndexFile.GetFullPath());
+
+  // House numbers parsed at index build time are kept in the binary index.
+  for (auto * geocoder : {&geocoderFromJsonl, &geocoderFromTokenIndex})
+  {
+    TestGeocoder(*geocoder, "Москва, Зорге 12", {{Id{0x12}, 1.0}, {Id{0x13}, 0.993}});
+    TestGeocoder(*geocoder, "Москва, Зорге 12к3", {{Id{0x13}, 1.0}, {Id{0x12}, 0.975}});
+    TestGeocoder(*geocoder, "Москва, Зорге 14", {{Id{0x16}, 0.95}});
+    TestGeocoder(*geocoder, "Москва, Зорге 120", {{Id{0x14}, 1.0}});
+  }
+}
+
 // Geocoder_Moscow* -----------------------------------------------------------------------------
 UNIT_TEST(Geocoder_MoscowLocalityRank)
 {
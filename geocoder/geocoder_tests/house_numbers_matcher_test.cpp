@@ -146,6 +146,50 @@ UNIT_TEST(HouseNumbersMatcher_Smoke)
   TEST(HouseNumbersMatch("14 д 1", "дом 14 д1"), ());
 }
 
+UNIT_TEST(HouseNumbersMatcher_EncodedParses)
+{
+  // "22, 12" checks that parses dropped by the fast pre-check are not matched either.
+  vector<string> const houseNumbers = {"12",   "12к3",       "12а",          "120",    "2",
+                                       "5/2",  "3-5",        "д 16",         "12, 14", "22, 12",
+                                       "1а",   "7 корпус 1", "10 строение 2", "лит А",  ""};
+  vector<string> const queries = {"12", "12к3", "12 к 3", "5/2", "7 к1", "120",
+                                  "14", "16",   "22",     "3",   "1",    "а"};
+  for (auto const & query : queries)
+  {
+    vector<Token> queryParse;
+    ParseQuery(MakeUniString(query), false /* queryIsPrefix */, queryParse);
+    auto const encodedQuery = EncodeParse(queryParse);
+
+    for (auto const & houseNumber : houseNumbers)
+    {
+      MatchResult expected{};
+      bool const expectedMatch =
+          search::house_numbers::HouseNumbersMatch(MakeUniString(houseNumber), queryParse, expected);
+
+      vector<string> encodedParses;
+      EncodeHouseNumberParses(MakeUniString(houseNumber), encodedParses);
+      MatchResult actual{};
+      bool actualMatch = false;
+      for (auto const & parse : encodedParses)
+      {
+        if (CompareFirstTokens(parse, encodedQuery) == 0 &&
+            EncodedParsesMatch(parse, encodedQuery, actual))
+        {
+          actualMatch = true;
+          break;
+        }
+      }
+
+      TEST_EQUAL(actualMatch, expectedMatch, (houseNumber, query));
+      TEST_EQUAL(actual.matchedTokensCount, expected.matchedTokensCount, (houseNumber, query));
+      TEST_EQUAL(actual.houseNumberMismatchedTokensCount,
+                 expected.houseNumberMismatchedTokensCount, (houseNumber, query));
+      TEST_EQUAL(actual.queryMismatchedTokensCount, expected.queryMismatchedTokensCount,
+                 (houseNumber, query));
+    }
+  }
+}
+
 UNIT_TEST(LooksLikeHouseNumber_Smoke)
 {
   TEST(LooksLikeHouseNumber("1", false /* isPrefix */), ());
@@ -2,6 +2,7 @@
 
 #include "indexer/string_set.hpp"
 
+#include "base/assert.hpp"
 #include "base/logging.hpp"
 
 #include <algorithm>
@@ -194,9 +195,9 @@ public:
   // Returns true when the string |s| looks like a valid house number,
   // (or a prefix of some valid house number, when |isPrefix| is
   // true).
-  bool LooksGood(UniString const & s, bool isPrefix) const
+  bool LooksGood(UniString const & s, bool isPrefix, vector<Token> & parse) const
   {
-    vector<Token> parse;
+    parse.clear();
     Tokenize(s, isPrefix, parse);
 
     size_t i = 0;
@@ -337,6 +338,31 @@ bool IsSubsequence(T1 b1, T1 e1, T2 b2, T2 e2)
   return true;
 }
 
+// Returns the position past the encoded token of |parse| that starts at |pos|.
+size_t NextEncodedToken(string const & parse, size_t pos) { return parse.find('\0', pos) + 1; }
+
+int CompareEncodedTokens(string const & lhs, size_t lhsPos, string const & rhs, size_t rhsPos)
+{
+  return lhs.compare(lhsPos, NextEncodedToken(lhs, lhsPos) - lhsPos, rhs, rhsPos,
+                     NextEncodedToken(rhs, rhsPos) - rhsPos);
+}
+
+// Same as IsSubsequence() for the encoded tokens of |parse2| starting at |b2| and the encoded
+// tokens of |parse1| starting at |b1|.
+bool IsEncodedSubsequence(string const & parse1, size_t b1, string const & parse2, size_t b2)
+{
+  for (; b2 != parse2.size(); b1 = NextEncodedToken(parse1, b1), b2 = NextEncodedToken(parse2, b2))
+  {
+    while (b1 != parse1.size() && CompareEncodedTokens(parse1, b1, parse2, b2) < 0)
+      b1 = NextEncodedToken(parse1, b1);
+    if (b1 == parse1.size() || CompareEncodedTokens(parse1, b1, parse2, b2) != 0)
+      return false;
+  }
+  return true;
+}
+
+size_t CountEncodedTokens(string const & parse) { return count(parse.begin(), parse.end(), '\0'); }
+
 bool IsBuildingPartSynonym(UniString const & s)
 {
   static BuildingPartSynonymsMatcher const kMatcher;
@@ -587,10 +613,98 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber, vector<Token> con
   return false;
 }
 
+string EncodeParse(vector<Token> const & parse)
+{
+  string encoded;
+  EncodeParse(parse, encoded);
+  return encoded;
+}
+
+void EncodeParse(vector<Token> const & parse, string & encoded)
+{
+  encoded.clear();
+  for (auto const & token : parse)
+  {
+    encoded += static_cast<char>('0' + token.m_type);
+    utf8::unchecked::utf32to8(token.m_value.begin(), token.m_value.end(), back_inserter(encoded));
+    encoded += '\0';
+  }
+}
+
+void EncodeHouseNumberParses(strings::UniString const & houseNumber,
+                             vector<string> & encodedParses)
+{
+  if (houseNumber.empty())
+    return;
+
+  vector<vector<Token>> parses;
+  ParseHouseNumber(houseNumber, parses);
+  for (auto const & parse : parses)
+  {
+    if (parse.empty())
+      continue;
+
+    // Parses rejected by the fast pre-check of HouseNumbersMatch(): a query with the same
+    // first token starts with a different digit.
+    auto const & first = parse[0].m_value;
+    if (IsASCIIDigit(houseNumber[0]) && !first.empty() && IsASCIIDigit(first[0]) &&
+        houseNumber[0] != first[0])
+    {
+      continue;
+    }
+
+    encodedParses.push_back(EncodeParse(parse));
+  }
+}
+
+int CompareFirstTokens(string const & lhs, string const & rhs)
+{
+  if (lhs.empty() || rhs.empty())
+    return lhs.empty() == rhs.empty() ? 0 : (lhs.empty() ? -1 : 1);
+  return CompareEncodedTokens(lhs, 0, rhs, 0);
+}
+
+bool EncodedParsesMatch(string const & houseNumberParse, string const & queryParse,
+                        MatchResult & matchResult)
+{
+  ASSERT_EQUAL(CompareFirstTokens(houseNumberParse, queryParse), 0, ());
+  if (houseNumberParse.empty() || queryParse.empty())
+  {
+    matchResult = {};
+    return false;
+  }
+
+  auto const houseNumberRest = NextEncodedToken(houseNumberParse, 0);
+  auto const queryRest = NextEncodedToken(queryParse, 0);
+  auto const houseNumberSize = CountEncodedTokens(houseNumberParse);
+  auto const querySize = CountEncodedTokens(queryParse);
+  if (IsEncodedSubsequence(houseNumberParse, houseNumberRest, queryParse, queryRest))
+  {
+    matchResult = {querySize, houseNumberSize - querySize, 0 /* queryMismatchedTokensCount */};
+    return true;
+  }
+
+  if (IsEncodedSubsequence(queryParse, queryRest, houseNumberParse, houseNumberRest))
+  {
+    matchResult = {houseNumberSize, 0 /* houseNumberMismatchedTokensCount */,
+                   querySize - houseNumberSize};
+    return true;
+  }
+
+  matchResult = {};
+  return false;
+}
+
 bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix)
+{
+  vector<Token> parse;
+  return LooksLikeHouseNumber(s, isPrefix, parse);
+}
+
+bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix, vector<Token> & parse)
 {
   static HouseNumberClassifier const classifier;
-  return classifier.LooksGood(s, isPrefix);
+  return classifier.LooksGood(s, isPrefix, parse);
 }
 
 bool LooksLikeHouseNumber(string const & s, bool isPrefix)
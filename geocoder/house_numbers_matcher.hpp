@@ -82,8 +82,31 @@ bool HouseNumbersMatch(strings::UniString const & houseNumber,
 bool HouseNumbersMatch(strings::UniString const & houseNumber, std::vector<Token> const & queryParse,
                        MatchResult & matchResult);
 
+// Encodes |parse| as a compact canonical string: every token is written as a type character,
+// the UTF-8 value and a zero byte. Equal tokens have equal encodings, and encodings of tokens
+// are ordered as the tokens themselves.
+std::string EncodeParse(std::vector<Token> const & parse);
+// Same as above but writes into |encoded| to reuse its memory.
+void EncodeParse(std::vector<Token> const & parse, std::string & encoded);
+
+// Appends encoded parses of |houseNumber| (see ParseHouseNumber()) to |encodedParses|,
+// except the parses that HouseNumbersMatch() never matches.
+void EncodeHouseNumberParses(strings::UniString const & houseNumber,
+                             std::vector<std::string> & encodedParses);
+
+// Compares the first tokens of encoded parses. A house number parse can only match a query
+// parse with the same first token.
+int CompareFirstTokens(std::string const & lhs, std::string const & rhs);
+
+// Same as HouseNumbersMatch() for an encoded house number parse and an encoded query parse
+// whose first tokens are equal.
+bool EncodedParsesMatch(std::string const & houseNumberParse, std::string const & queryParse,
+                        MatchResult & matchResult);
+
 // Returns true if |s| looks like a house number.
 bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix);
+// Same as above with |parse| as a buffer for the tokens of |s|.
+bool LooksLikeHouseNumber(strings::UniString const & s, bool isPrefix, std::vector<Token> & parse);
 bool LooksLikeHouseNumber(std::string const & s, bool isPrefix);
 
 std::string DebugPrint(Token::Type type);
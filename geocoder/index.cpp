@@ -5,6 +5,7 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "base/assert.hpp"
+#include "base/buffer_vector.hpp"
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
@@ -36,6 +37,7 @@ void Index::BuildIndex(unsigned int loadThreadsCount)
 
   m_docIdsByTokens.clear();
   m_relatedBuildings.clear();
+  m_relatedHouseNumbers.clear();
 
   LOG(LINFO, ("Indexing hierarchy entries..."));
   AddEntries();
@@ -52,12 +54,37 @@ Index::Doc const & Index::GetDoc(DocId const id) const
 // static
 string Index::MakeIndexKey(Tokens const & tokens)
 {
-  if (tokens.size() == 1 || is_sorted(begin(tokens), end(tokens)))
-    return strings::JoinStrings(tokens, " ");
+  string key;
+  MakeIndexKey(tokens.cbegin(), tokens.cend(), key);
+  return key;
+}
+
+// static
+void Index::MakeIndexKey(Tokens::const_iterator begin, Tokens::const_iterator end, string & key)
+{
+  key.clear();
+  bool first = true;
+  auto const append = [&key, &first](string const & token) {
+    if (!first)
+      key += ' ';
+    key += token;
+    first = false;
+  };
 
-  auto indexTokens = tokens;
-  sort(begin(indexTokens), end(indexTokens));
-  return strings::JoinStrings(indexTokens, " ");
+  if (is_sorted(begin, end))
+  {
+    for (auto it = begin; it != end; ++it)
+      append(*it);
+    return;
+  }
+
+  buffer_vector<string const *, 8> indexTokens;
+  for (auto it = begin; it != end; ++it)
+    indexTokens.push_back(&*it);
+  sort(indexTokens.begin(), indexTokens.end(),
+       [](string const * lhs, string const * rhs) { return *lhs < *rhs; });
+  for (auto const * token : indexTokens)
+    append(*token);
 }
 
 void Index::AddEntries()
@@ -148,6 +175,7 @@ void Index::AddHouses(unsigned int loadThreadsCount)
       size_t const size = m_docs.size() / threads.size();
       size_t docId = t * size;
       size_t const docIdEnd = (t + 1 == threads.size() ? m_docs.size() : docId + size);
+      vector<string> houseNumberParses;
 
       for (; docId < docIdEnd; ++docId)
       {
@@ -174,6 +202,12 @@ void Index::AddHouses(unsigned int loadThreadsCount)
         search::NormalizeAndTokenizeAsUtf8(relationName, relationNameTokens);
         CHECK(!relationNameTokens.empty(), ());
 
+        auto const & houseNumber =
+            buildingDoc.GetNormalizedMultipleNames(Type::Building, dictionary).GetMainName();
+        houseNumberParses.clear();
+        search::house_numbers::EncodeHouseNumberParses(strings::MakeUniString(houseNumber),
+                                                       houseNumberParses);
+
         bool indexed = false;
         ForEachDocId(relationNameTokens, [&](DocId const & candidate) {
           auto const & candidateDoc = GetDoc(candidate);
@@ -183,6 +217,9 @@ void Index::AddHouses(unsigned int loadThreadsCount)
 
             lock_guard<mutex> lock(buildingsMutex);
             m_relatedBuildings[candidate].emplace_back(docId);
+            auto & houseNumbers = m_relatedHouseNumbers[candidate];
+            for (auto const & parse : houseNumberParses)
+              houseNumbers.push_back({parse, docId});
           }
         });
 
@@ -199,6 +236,10 @@ void Index::AddHouses(unsigned int loadThreadsCount)
   for (auto & t : threads)
     t.join();
 
+  // Keeps parses of a building adjacent and in order.
+  for (auto & houseNumbers : m_relatedHouseNumbers)
+    stable_sort(houseNumbers.second.begin(), houseNumbers.second.end(), FirstTokenLess{});
+
   if (numIndexed % kLogBatch != 0)
     LOG(LINFO, ("Indexed", numIndexed, "houses"));
 }
@@ -1,16 +1,21 @@
 #pragma once
 
 #include "geocoder/hierarchy.hpp"
+#include "geocoder/house_numbers_matcher.hpp"
 
 #include "base/geo_object_id.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <boost/serialization/string.hpp>
 #include <boost/serialization/unordered_map.hpp>
+#include <boost/serialization/vector.hpp>
 #include <boost/serialization/version.hpp>
 
 namespace geocoder
@@ -24,6 +29,22 @@ public:
   // that the index was constructed from.
   using DocId = std::vector<Doc>::size_type;
 
+  // Parse of the house number of a related building.
+  struct RelatedHouseNumber
+  {
+    template <class Archive>
+    void serialize(Archive & ar, unsigned int const version)
+    {
+      CHECK_EQUAL(version, kIndexFormatVersion, ());
+      ar & m_parse;
+      ar & m_building;
+    }
+
+    // See search::house_numbers::EncodeHouseNumberParses().
+    std::string m_parse;
+    DocId m_building = 0;
+  };
+
   explicit Index(Hierarchy const & hierarchy);
 
   void BuildIndex(unsigned int loadThreadsCount = 1);
@@ -34,6 +55,7 @@ public:
     CHECK_EQUAL(version, kIndexFormatVersion, ());
     ar & m_docIdsByTokens;
     ar & m_relatedBuildings;
+    ar & m_relatedHouseNumbers;
   }
 
   Doc const & GetDoc(DocId const id) const;
@@ -46,7 +68,17 @@ public:
   template <typename Fn>
   void ForEachDocId(Tokens const & tokens, Fn && fn) const
   {
-    auto const it = m_docIdsByTokens.find(MakeIndexKey(tokens));
+    std::string key;
+    ForEachDocId(tokens.cbegin(), tokens.cend(), key, std::forward<Fn>(fn));
+  }
+
+  // Same as above for the tokens [begin, end) with |key| as a buffer for the index key.
+  template <typename Fn>
+  void ForEachDocId(Tokens::const_iterator begin, Tokens::const_iterator end, std::string & key,
+                    Fn && fn) const
+  {
+    MakeIndexKey(begin, end, key);
+    auto const it = m_docIdsByTokens.find(key);
     if (it == m_docIdsByTokens.end())
       return;
 
@@ -67,12 +99,62 @@ public:
       fn(docId);
   }
 
+  // Calls |fn| for DocIds and match results of the buildings related to |docId| whose house
+  // numbers match |queryParse| encoded by search::house_numbers::EncodeParse(). Only the
+  // parses with the same first token as the query are checked, the first match of a building
+  // is reported as search::house_numbers::HouseNumbersMatch() does.
+  template <typename Fn>
+  void ForEachRelatedBuildingMatch(DocId const & docId, std::string const & queryParse,
+                                   Fn && fn) const
+  {
+    auto const it = m_relatedHouseNumbers.find(docId);
+    if (it == m_relatedHouseNumbers.end() || queryParse.empty())
+      return;
+
+    auto const range = std::equal_range(it->second.begin(), it->second.end(), queryParse,
+                                        FirstTokenLess{});
+    auto matched = m_docs.size();
+    for (auto hn = range.first; hn != range.second; ++hn)
+    {
+      // Parses of a building are adjacent.
+      if (hn->m_building == matched)
+        continue;
+
+      search::house_numbers::MatchResult matchResult;
+      if (search::house_numbers::EncodedParsesMatch(hn->m_parse, queryParse, matchResult))
+      {
+        matched = hn->m_building;
+        fn(hn->m_building, matchResult);
+      }
+    }
+  }
+
 private:
+  struct FirstTokenLess
+  {
+    bool operator()(RelatedHouseNumber const & lhs, std::string const & rhs) const
+    {
+      return search::house_numbers::CompareFirstTokens(lhs.m_parse, rhs) < 0;
+    }
+
+    bool operator()(std::string const & lhs, RelatedHouseNumber const & rhs) const
+    {
+      return search::house_numbers::CompareFirstTokens(lhs, rhs.m_parse) < 0;
+    }
+
+    bool operator()(RelatedHouseNumber const & lhs, RelatedHouseNumber const & rhs) const
+    {
+      return search::house_numbers::CompareFirstTokens(lhs.m_parse, rhs.m_parse) < 0;
+    }
+  };
+
   void InsertToIndex(Tokens const & tokens, DocId docId);
 
   // Converts |tokens| to a single UTF-8 string that can be used
   // as a key in the |m_docIdsByTokens| map.
   static std::string MakeIndexKey(Tokens const & tokens);
+  static void MakeIndexKey(Tokens::const_iterator begin, Tokens::const_iterator end,
+                           std::string & key);
 
   // Adds address information of |m_docs| to the index.
   void AddEntries();
@@ -81,7 +163,7 @@ private:
   // with and without synonyms of the word "street".
   void AddStreet(DocId const & docId, Doc const & e);
 
-  // Fills the |m_relatedBuildings| field.
+  // Fills the |m_relatedBuildings| and |m_relatedHouseNumbers| fields.
   void AddHouses(unsigned int loadThreadsCount);
 
   std::vector<Doc> const & m_docs;
@@ -91,7 +173,11 @@ private:
 
   // Lists of houses grouped by the streets/localities they belong to.
   std::unordered_map<DocId, std::vector<DocId>> m_relatedBuildings;
+
+  // House number parses of |m_relatedBuildings| sorted by the first token.
+  std::unordered_map<DocId, std::vector<RelatedHouseNumber>> m_relatedHouseNumbers;
 };
 }  // namespace geocoder
 
 BOOST_CLASS_VERSION(geocoder::Index, geocoder::kIndexFormatVersion)
+BOOST_CLASS_VERSION(geocoder::Index::RelatedHouseNumber, geocoder::kIndexFormatVersion)
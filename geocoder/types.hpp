@@ -7,7 +7,7 @@
 
 namespace geocoder
 {
-enum : unsigned int { kIndexFormatVersion = 2 };
+enum : unsigned int { kIndexFormatVersion = 3 };
 
 using Tokens = std::vector<std::string>;
 
@@ -32,6 +32,18 @@ public:
     return false;
   }
 
+  // Calls |fn| with the region id and the points of each outer and inner border.
+  template <typename Fn>
+  void ForEachRing(Fn && fn) const
+  {
+    for (auto const & border : m_borders)
+    {
+      fn(border.first, border.second.m_outer.Data());
+      for (auto const & inner : border.second.m_inners)
+        fn(border.first, inner.Data());
+    }
+  }
+
   // Throws Reader::Exception in case of data reading errors.
   void Deserialize(std::string const & filename);
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/optional.hpp>
+
+namespace indexer
+{
+// A wrapper class around a serialized bounds section: the version byte followed by records of
+// fixed size. A record is an optional key and points packed with fixed width, so records are
+// read by their indexes without decoding of the section.
+template <typename Reader>
+class BoundsRecords
+{
+public:
+  static size_t constexpr kPointSize = 2 * sizeof(uint32_t);
+  static size_t constexpr kRectSize = 2 * kPointSize;
+  // Max number of points read by one GetPoints() call.
+  static size_t constexpr kMaxPointsCount = 4;
+
+  // Loads records of |recordSize| bytes from |reader|. Returns boost::none if the section is not
+  // of |version| or can't be loaded.
+  static boost::optional<BoundsRecords> Load(Reader const & reader, uint8_t version,
+                                             size_t recordSize)
+  {
+    try
+    {
+      if (reader.Size() == 0 || ReadPrimitiveFromPos<uint8_t>(reader, 0) != version)
+        return {};
+
+      auto const dataSize = reader.Size() - sizeof(version);
+      if (dataSize % recordSize != 0)
+        return {};
+
+      return BoundsRecords(reader.SubReader(sizeof(version), dataSize), recordSize,
+                           dataSize / recordSize);
+    }
+    catch (::Reader::Exception const & e)
+    {
+      LOG(LERROR, ("Can't load bounds section:", e.Msg()));
+      return {};
+    }
+  }
+
+  size_t GetNumRecords() const { return m_numRecords; }
+
+  // Returns the key at the beginning of the record |index|.
+  template <typename Key>
+  Key GetKey(size_t index) const
+  {
+    return ReadPrimitiveFromPos<Key>(m_reader, index * m_recordSize);
+  }
+
+  // Reads |count| points at |offset| bytes of the record |index|.
+  void GetPoints(size_t index, size_t offset, uint8_t coordBits, m2::PointD * points,
+                 size_t count) const
+  {
+    CHECK_LESS(index, m_numRecords, ());
+    CHECK_LESS_OR_EQUAL(count, kMaxPointsCount, ());
+    CHECK_LESS_OR_EQUAL(offset + count * kPointSize, m_recordSize, ());
+
+    uint32_t coords[2 * kMaxPointsCount];
+    m_reader.Read(index * m_recordSize + offset, coords, count * kPointSize);
+    for (size_t i = 0; i < count; ++i)
+    {
+      points[i] = PointUToPointD(m2::PointU(SwapIfBigEndianMacroBased(coords[2 * i]),
+                                            SwapIfBigEndianMacroBased(coords[2 * i + 1])),
+                                 coordBits);
+    }
+  }
+
+  m2::RectD GetRect(size_t index, size_t offset, uint8_t coordBits) const
+  {
+    m2::PointD points[2];
+    GetPoints(index, offset, coordBits, points, 2);
+    return m2::RectD(points[0], points[1]);
+  }
+
+private:
+  BoundsRecords(Reader const & reader, size_t recordSize, size_t numRecords)
+    : m_reader(reader), m_recordSize(recordSize), m_numRecords(numRecords)
+  {
+  }
+
+  Reader m_reader;
+  size_t m_recordSize;
+  size_t m_numRecords;
+};
+
+// static
+template <typename Reader>
+size_t constexpr BoundsRecords<Reader>::kPointSize;
+// static
+template <typename Reader>
+size_t constexpr BoundsRecords<Reader>::kRectSize;
+// static
+template <typename Reader>
+size_t constexpr BoundsRecords<Reader>::kMaxPointsCount;
+
+// Writes |point| packed for BoundsRecords.
+template <typename Sink>
+void WriteBoundsPoint(Sink & sink, m2::PointU const & point)
+{
+  WriteToSink(sink, point.x);
+  WriteToSink(sink, point.y);
+}
+
+// Writes |rect| packed for BoundsRecords.
+template <typename Sink>
+void WriteBoundsRect(Sink & sink, m2::RectD const & rect, uint8_t coordBits)
+{
+  WriteBoundsPoint(sink, PointDToPointU(rect.LeftBottom(), coordBits));
+  WriteBoundsPoint(sink, PointDToPointU(rect.RightTop(), coordBits));
+}
+}  // namespace indexer
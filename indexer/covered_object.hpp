@@ -47,6 +47,16 @@ public:
       toDo(m_triangles[i - 2], m_triangles[i - 1], m_triangles[i]);
   }
 
+  template <typename ToDo>
+  void ForEachRing(ToDo && toDo) const
+  {
+    for (auto const & ring : m_rings)
+      toDo(ring);
+  }
+
+  // An object with rings is an area which is covered by its rings instead of triangles.
+  bool HasRings() const { return !m_rings.empty(); }
+
   void SetId(uint64_t id)
   {
     m_id = id;
@@ -62,6 +72,11 @@ public:
     m_triangles = std::move(triangles);
   }
 
+  void SetRings(std::vector<std::vector<m2::PointD>> && rings)
+  {
+    m_rings = std::move(rings);
+  }
+
   void SetForTesting(uint64_t id, m2::PointD point)
   {
     m_id = id;
@@ -93,5 +108,7 @@ private:
   buffer_vector<m2::PointD, 32> m_points;
   // m_triangles[3 * i], m_triangles[3 * i + 1], m_triangles[3 * i + 2] form the i-th triangle.
   buffer_vector<m2::PointD, 32> m_triangles;
+  // Rings of an area, the interior is defined by the even-odd rule.
+  std::vector<std::vector<m2::PointD>> m_rings;
 };
 }  // namespace indexer
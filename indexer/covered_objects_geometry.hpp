@@ -0,0 +1,289 @@
+#pragma once
+
+#include "indexer/bounds_records.hpp"
+#include "indexer/covered_object.hpp"
+
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/triangle2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/geo_object_id.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace indexer
+{
+namespace covered_objects_geometry
+{
+uint8_t constexpr kVersion = 0;
+
+enum class GeomType : uint8_t
+{
+  // Points joined by segments, a point object has a single point.
+  Line = 0,
+  // Triangles of an area, every three points form a triangle.
+  Triangles = 1,
+};
+}  // namespace covered_objects_geometry
+
+// A wrapper class around serialized geometry section of CoveringIndex: geometry of the indexed
+// objects as it is covered by the index, i.e. points, simplified lines and triangles of areas.
+// The section is the version byte, the number of objects, object records of fixed width sorted
+// by stored ids to be found by binary search and the points of all objects.
+template <typename Reader>
+class CoveredObjectsGeometry
+{
+public:
+  // Stored id, index of the first point and number of points with the geometry type.
+  static size_t constexpr kObjectSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+  static size_t constexpr kHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+
+  // Loads the geometry from |reader|. Returns nullptr if the geometry can't be loaded.
+  static std::unique_ptr<CoveredObjectsGeometry> Load(Reader const & reader)
+  {
+    try
+    {
+      if (reader.Size() < kHeaderSize ||
+          ReadPrimitiveFromPos<uint8_t>(reader, 0) != covered_objects_geometry::kVersion)
+      {
+        return {};
+      }
+
+      auto const numObjects = ReadPrimitiveFromPos<uint32_t>(reader, sizeof(uint8_t));
+      auto const pointsOffset = kHeaderSize + uint64_t{numObjects} * kObjectSize;
+      if (pointsOffset > reader.Size() ||
+          (reader.Size() - pointsOffset) % BoundsRecords<Reader>::kPointSize != 0)
+      {
+        return {};
+      }
+
+      return std::unique_ptr<CoveredObjectsGeometry>(new CoveredObjectsGeometry(
+          reader.SubReader(kHeaderSize, pointsOffset - kHeaderSize),
+          reader.SubReader(pointsOffset, reader.Size() - pointsOffset), numObjects));
+    }
+    catch (::Reader::Exception const & e)
+    {
+      LOG(LERROR, ("Can't load objects geometry section:", e.Msg()));
+      return {};
+    }
+  }
+
+  size_t GetNumObjects() const { return m_numObjects; }
+
+  // Returns the distance in meters from |point| to the geometry of the object |id| or
+  // std::numeric_limits<double>::max() if there is no object |id|.
+  double GetDistance(base::GeoObjectId const & id, m2::PointD const & point) const
+  {
+    CoveredObject object;
+    object.SetId(id.GetEncodedId());
+    auto const storedId = object.GetStoredId();
+
+    size_t begin = 0;
+    size_t end = m_numObjects;
+    while (begin < end)
+    {
+      auto const middle = begin + (end - begin) / 2;
+      if (GetStoredId(middle) < storedId)
+        begin = middle + 1;
+      else
+        end = middle;
+    }
+
+    // An object put several times has a record for every geometry.
+    auto distance = std::numeric_limits<double>::max();
+    for (auto i = begin; i < m_numObjects && GetStoredId(i) == storedId; ++i)
+      distance = std::min(distance, GetDistance(i, point));
+    return distance;
+  }
+
+private:
+  CoveredObjectsGeometry(Reader const & objects, Reader const & points, size_t numObjects)
+    : m_objects(objects), m_points(points), m_numObjects(numObjects)
+  {
+  }
+
+  uint64_t GetStoredId(size_t index) const
+  {
+    return ReadPrimitiveFromPos<uint64_t>(m_objects, index * kObjectSize);
+  }
+
+  double GetDistance(size_t index, m2::PointD const & point) const
+  {
+    using covered_objects_geometry::GeomType;
+
+    auto const pos = index * kObjectSize + sizeof(uint64_t);
+    auto const firstPoint = ReadPrimitiveFromPos<uint32_t>(m_objects, pos);
+    auto const header = ReadPrimitiveFromPos<uint32_t>(m_objects, pos + sizeof(uint32_t));
+    auto const geomType = static_cast<GeomType>(header & 1);
+    std::vector<m2::PointD> points(header >> 1);
+    ReadPoints(firstPoint, points);
+
+    auto distance = std::numeric_limits<double>::max();
+    auto const updateBySegment = [&](m2::PointD const & p0, m2::PointD const & p1) {
+      auto const nearest = m2::ParametrizedSegment<m2::PointD>(p0, p1).ClosestPointTo(point);
+      distance = std::min(distance, MercatorBounds::DistanceOnEarth(point, nearest));
+    };
+
+    switch (geomType)
+    {
+    case GeomType::Line:
+    {
+      if (points.size() == 1)
+        return MercatorBounds::DistanceOnEarth(point, points.front());
+
+      for (size_t i = 1; i < points.size(); ++i)
+        updateBySegment(points[i - 1], points[i]);
+      break;
+    }
+    case GeomType::Triangles:
+    {
+      for (size_t i = 2; i < points.size(); i += 3)
+      {
+        auto const & p0 = points[i - 2];
+        auto const & p1 = points[i - 1];
+        auto const & p2 = points[i];
+        if (m2::IsPointInsideTriangle(point, p0, p1, p2))
+          return 0.0;
+
+        updateBySegment(p0, p1);
+        updateBySegment(p1, p2);
+        updateBySegment(p2, p0);
+      }
+      break;
+    }
+    }
+    return distance;
+  }
+
+  void ReadPoints(uint32_t firstPoint, std::vector<m2::PointD> & points) const
+  {
+    std::vector<uint32_t> coords(2 * points.size());
+    m_points.Read(uint64_t{firstPoint} * BoundsRecords<Reader>::kPointSize, coords.data(),
+                  coords.size() * sizeof(uint32_t));
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      points[i] = PointUToPointD(m2::PointU(SwapIfBigEndianMacroBased(coords[2 * i]),
+                                            SwapIfBigEndianMacroBased(coords[2 * i + 1])),
+                                 kPointCoordBits);
+    }
+  }
+
+  Reader m_objects;
+  Reader m_points;
+  size_t m_numObjects;
+};
+
+// static
+template <typename Reader>
+size_t constexpr CoveredObjectsGeometry<Reader>::kObjectSize;
+// static
+template <typename Reader>
+size_t constexpr CoveredObjectsGeometry<Reader>::kHeaderSize;
+
+class CoveredObjectsGeometryBuilder
+{
+public:
+  // Puts points and triangles of |object|, rings are not supported.
+  void Put(CoveredObject const & object)
+  {
+    using covered_objects_geometry::GeomType;
+
+    CHECK(!object.HasRings(), ("Rings of objects are not supported."));
+
+    Object result;
+    result.m_storedId = object.GetStoredId();
+    result.m_firstPoint = m_points.size();
+
+    auto const putPoint = [this](m2::PointD const & point) {
+      m_points.push_back(PointDToPointU(point, kPointCoordBits));
+    };
+    object.ForEachTriangle(
+        [&putPoint](m2::PointD const & p0, m2::PointD const & p1, m2::PointD const & p2) {
+          putPoint(p0);
+          putPoint(p1);
+          putPoint(p2);
+        });
+    result.m_geomType = GeomType::Triangles;
+    if (m_points.size() == result.m_firstPoint)
+    {
+      object.ForEachPoint(putPoint);
+      result.m_geomType = GeomType::Line;
+    }
+
+    auto const numPoints = m_points.size() - result.m_firstPoint;
+    if (numPoints == 0)
+      return;
+
+    // The geometry type is kept in the lowest bit of the number of points.
+    CHECK_LESS(numPoints, uint32_t{1} << 31, ());
+    result.m_numPoints = static_cast<uint32_t>(numPoints);
+    m_objects.push_back(result);
+  }
+
+  void Append(CoveredObjectsGeometryBuilder && other)
+  {
+    auto const pointsShift = m_points.size();
+    for (auto object : other.m_objects)
+    {
+      object.m_firstPoint += pointsShift;
+      m_objects.push_back(object);
+    }
+    m_points.insert(m_points.end(), other.m_points.begin(), other.m_points.end());
+    other.m_objects = {};
+    other.m_points = {};
+  }
+
+  template <typename Writer>
+  void Freeze(Writer & writer)
+  {
+    std::stable_sort(m_objects.begin(), m_objects.end(),
+                     [](auto const & l, auto const & r) { return l.m_storedId < r.m_storedId; });
+
+    CHECK_LESS_OR_EQUAL(m_objects.size(), std::numeric_limits<uint32_t>::max(), ());
+    CHECK_LESS_OR_EQUAL(m_points.size(), std::numeric_limits<uint32_t>::max(), ());
+
+    WriteToSink(writer, covered_objects_geometry::kVersion);
+    WriteToSink(writer, static_cast<uint32_t>(m_objects.size()));
+
+    // Points are written in order of objects.
+    uint32_t firstPoint = 0;
+    for (auto const & object : m_objects)
+    {
+      WriteToSink(writer, object.m_storedId);
+      WriteToSink(writer, firstPoint);
+      WriteToSink(writer, object.m_numPoints << 1 | static_cast<uint32_t>(object.m_geomType));
+      firstPoint += object.m_numPoints;
+    }
+
+    for (auto const & object : m_objects)
+    {
+      for (size_t i = 0; i < object.m_numPoints; ++i)
+        WriteBoundsPoint(writer, m_points[object.m_firstPoint + i]);
+    }
+  }
+
+private:
+  struct Object
+  {
+    uint64_t m_storedId = 0;
+    size_t m_firstPoint = 0;
+    uint32_t m_numPoints = 0;
+    covered_objects_geometry::GeomType m_geomType = covered_objects_geometry::GeomType::Line;
+  };
+
+  std::vector<Object> m_objects;
+  std::vector<m2::PointU> m_points;
+};
+}  // namespace indexer
@@ -2,6 +2,7 @@
 
 #include "indexer/cell_id.hpp"
 #include "indexer/covered_object.hpp"
+#include "indexer/covered_objects_geometry.hpp"
 #include "indexer/feature_covering.hpp"
 #include "indexer/interval_index.hpp"
 #include "indexer/scales.hpp"
@@ -15,10 +16,15 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 #include "defines.hpp"
 
@@ -33,6 +39,9 @@ class CoveringIndex
 public:
   using ProcessObject = std::function<void(base::GeoObjectId const &)>;
   using ProcessCloseObject = std::function<void(base::GeoObjectId const & objectId, double closenessWeight)>;
+  using ProcessNearObject =
+      std::function<void(base::GeoObjectId const & objectId, double distanceM)>;
+  using ObjectDistance = std::function<double(base::GeoObjectId const & objectId)>;
 
   CoveringIndex() = default;
   explicit CoveringIndex(Reader const & reader)
@@ -40,6 +49,18 @@ public:
     m_intervalIndex = std::make_unique<IntervalIndex<Reader, uint64_t>>(reader);
   }
 
+  // Objects geometry is read from |geometryReader| if it is set.
+  CoveringIndex(Reader const & reader, boost::optional<Reader> const & geometryReader)
+    : CoveringIndex(reader)
+  {
+    if (geometryReader)
+      m_geometry = CoveredObjectsGeometry<Reader>::Load(*geometryReader);
+  }
+
+  // Returns true if the index has geometry of objects, it is needed by ForNearestToPoint()
+  // without the distance function.
+  bool HasGeometry() const { return m_geometry != nullptr; }
+
   void ForEachAtPoint(ProcessObject const & processObject, m2::PointD const & point) const
   {
     ForEachInRect(processObject, m2::RectD(point, point));
@@ -48,16 +69,13 @@ public:
   void ForEachInRect(ProcessObject const & processObject, m2::RectD const & rect) const
   {
     covering::CoveringGetter cov(rect, covering::CoveringMode::ViewportWithLowLevels);
+    // Intervals of the covering are sorted and merged, so they are read in one pass.
     covering::Intervals const & intervals = cov.Get<DEPTH_LEVELS>(scales::GetUpperScale());
-
-    for (auto const & i : intervals)
-    {
-      m_intervalIndex->ForEach(
-            [&processObject](uint64_t /* key */, uint64_t storedId) {
-        processObject(CoveredObject::FromStoredId(storedId));
-      },
-      i.first, i.second);
-    }
+    m_intervalIndex->ForEach(
+        [&processObject](uint64_t /* key */, uint64_t storedId) {
+          processObject(CoveredObject::FromStoredId(storedId));
+        },
+        intervals);
   }
 
   // Applies |processObject| to the objects located within |radiusM| meters from |center|.
@@ -137,8 +155,151 @@ public:
       processObject(base::GeoObjectId(object.first), object.second);
   }
 
+  // Same as ForNearestToPoint() below with the exact distance to the objects geometry kept
+  // next to the index.
+  void ForNearestToPoint(ProcessNearObject const & processObject, m2::PointD const & center,
+                         double radiusM, uint32_t k) const
+  {
+    CHECK(m_geometry, ("The index has no geometry of objects."));
+
+    auto const distance = [this, &center](base::GeoObjectId const & objectId) {
+      return m_geometry->GetDistance(objectId, center);
+    };
+    ForNearestToPoint(processObject, distance, center, radiusM, k);
+  }
+
+  // Applies |processObject| to at most |k| objects nearest to |center| within |radiusM| meters
+  // in order of increasing distance. |distance| gives the exact distance in meters from |center|
+  // to an object geometry.
+  // Index cells are scanned ring by ring around |center| and the scanning stops once the |k|-th
+  // distance does not exceed the distance to the border of the scanned rings.
+  void ForNearestToPoint(ProcessNearObject const & processObject, ObjectDistance const & distance,
+                         m2::PointD const & center, double radiusM, uint32_t k) const
+  {
+    using CellId = m2::CellId<DEPTH_LEVELS>;
+    using Converter = CellIdConverter<MercatorBounds, CellId>;
+
+    if (k == 0)
+      return;
+
+    auto rect = MercatorBounds::RectByCenterXYAndSizeInMeters(center, radiusM);
+    if (!rect.Intersect(MercatorBounds::FullRect()))
+      return;
+
+    auto const cellDepth = covering::GetCodingDepth<DEPTH_LEVELS>(scales::GetUpperScale());
+    auto centralCell = Converter::ToCellId(center.x, center.y);
+    while (centralCell.Level() > cellDepth - 1)
+      centralCell = centralCell.Parent();
+
+    auto const cellRect = [](CellId const & cell) {
+      double minX, minY, maxX, maxY;
+      Converter::GetCellBounds(cell, minX, minY, maxX, maxY);
+      return m2::RectD(minX, minY, maxX, maxY);
+    };
+    // Bounds the number of rings by the cell size.
+    int32_t constexpr kMaxRings = 16;
+    auto const rectSize = std::max(rect.SizeX(), rect.SizeY());
+    while (centralCell.Level() > 0 &&
+           rectSize > (2 * kMaxRings + 1) * cellRect(centralCell).SizeX())
+    {
+      centralCell = centralCell.Parent();
+    }
+
+    auto const centralRect = cellRect(centralCell);
+    auto const cellSize = centralRect.SizeX();
+    auto const centralXY = centralCell.XY();
+    int64_t const step = 2 * centralCell.Radius();
+
+    std::set<covering::Interval> visitedIntervals;
+    covering::Intervals ringIntervals;
+    auto const appendCell = [&](int64_t dx, int64_t dy) {
+      int64_t const x = centralXY.first + dx * step;
+      int64_t const y = centralXY.second + dy * step;
+      if (x < 0 || y < 0 || x > CellId::MAX_COORD || y > CellId::MAX_COORD)
+        return;
+
+      auto const cell = CellId::FromXY(static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+                                       centralCell.Level());
+      covering::AppendLowerLevels<DEPTH_LEVELS>(
+          cell, cellDepth, [&](covering::Interval const & interval) {
+            if (visitedIntervals.insert(interval).second)
+              ringIntervals.push_back(interval);
+          });
+    };
+
+    // Max-heap of the nearest objects by distance.
+    std::vector<std::pair<double, base::GeoObjectId>> nearest;
+    auto const farther = [](auto const & l, auto const & r) { return l.first < r.first; };
+    std::unordered_set<uint64_t> visitedObjects;
+    auto const processStoredId = [&](uint64_t /* key */, uint64_t storedId) {
+      auto const objectId = CoveredObject::FromStoredId(storedId);
+      if (!visitedObjects.insert(objectId.GetEncodedId()).second)
+        return;
+
+      auto const objectDistance = distance(objectId);
+      if (objectDistance > radiusM)
+        return;
+
+      if (nearest.size() == k)
+      {
+        if (objectDistance >= nearest.front().first)
+          return;
+
+        std::pop_heap(nearest.begin(), nearest.end(), farther);
+        nearest.pop_back();
+      }
+      nearest.emplace_back(objectDistance, objectId);
+      std::push_heap(nearest.begin(), nearest.end(), farther);
+    };
+
+    // Objects out of the scanned rings are farther than the nearest side of the rings which
+    // is inside the world.
+    auto const distanceToOuterObjects = [&center](m2::RectD const & scanned) {
+      auto const world = MercatorBounds::FullRect();
+      auto result = std::numeric_limits<double>::max();
+      auto const updateBySide = [&](bool inWorld, m2::PointD const & sidePoint) {
+        if (inWorld)
+          result = std::min(result, MercatorBounds::DistanceOnEarth(center, sidePoint));
+      };
+      updateBySide(scanned.minX() > world.minX(), {scanned.minX(), center.y});
+      updateBySide(scanned.maxX() < world.maxX(), {scanned.maxX(), center.y});
+      updateBySide(scanned.minY() > world.minY(), {center.x, scanned.minY()});
+      updateBySide(scanned.maxY() < world.maxY(), {center.x, scanned.maxY()});
+      return result;
+    };
+
+    for (int64_t ring = 0;; ++ring)
+    {
+      ringIntervals.clear();
+      for (int64_t d = -ring; d <= ring; ++d)
+      {
+        appendCell(d, -ring);
+        if (ring != 0)
+          appendCell(d, ring);
+      }
+      for (int64_t d = -ring + 1; d <= ring - 1; ++d)
+      {
+        appendCell(-ring, d);
+        appendCell(ring, d);
+      }
+      m_intervalIndex->ForEach(processStoredId, covering::SortAndMergeIntervals(ringIntervals));
+
+      auto scanned = centralRect;
+      scanned.Inflate(ring * cellSize, ring * cellSize);
+      if (scanned.IsRectInside(rect))
+        break;
+      if (nearest.size() == k && nearest.front().first <= distanceToOuterObjects(scanned))
+        break;
+    }
+
+    std::sort_heap(nearest.begin(), nearest.end(), farther);
+    for (auto const & object : nearest)
+      processObject(object.second, object.first);
+  }
+
 private:
   std::unique_ptr<IntervalIndex<Reader, uint64_t>> m_intervalIndex;
+  std::unique_ptr<CoveredObjectsGeometry<Reader>> m_geometry;
 };
 
 template <typename Reader>
@@ -172,7 +333,17 @@ typename IndexBox::IndexType ReadIndex(std::string const & pathIndx)
   auto const offsetSize = cont.GetAbsoluteOffsetAndSize(IndexBox::kFileTag);
   Reader reader(pathIndx);
   typename IndexBox::ReaderType subReader(reader.CreateSubReader(offsetSize.first, offsetSize.second));
-  typename IndexBox::IndexType index(subReader);
+
+  boost::optional<typename IndexBox::ReaderType> geometryReader;
+  if (cont.IsExist(COVERED_OBJECTS_GEOMETRY_FILE_TAG))
+  {
+    auto const geometryOffsetSize =
+        cont.GetAbsoluteOffsetAndSize(COVERED_OBJECTS_GEOMETRY_FILE_TAG);
+    geometryReader.emplace(
+        reader.CreateSubReader(geometryOffsetSize.first, geometryOffsetSize.second));
+  }
+
+  typename IndexBox::IndexType index(subReader, geometryReader);
   return index;
 }
 
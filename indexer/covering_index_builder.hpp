@@ -83,7 +83,7 @@ public:
     boost::sort::block_indirect_sort(covering.begin(), covering.end(), sortThreadsCount);
 
     BuildIntervalIndex(covering.begin(), covering.end(), std::forward<Writer>(writer),
-                       depthLevel * 2 + 1, IntervalIndexVersion::V2);
+                       depthLevel * 2 + 1, IntervalIndexVersion::V3);
   }
 
 private:
@@ -1,8 +1,11 @@
 #include "indexer/data_source.hpp"
 
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 
 using platform::CountryFile;
 using platform::LocalCountryFile;
@@ -10,6 +13,9 @@ using namespace std;
 
 namespace
 {
+// Mwms with fewer intervals are read by one task.
+size_t constexpr kMinIntervalsPerTask = 16;
+
 class ReadMWMFunctor
 {
 public:
@@ -40,7 +46,7 @@ public:
       // feature ids from it, gets untouched features by ids from |src| and applies |m_fn| by
       // ProcessElement.
       feature::DataHeader const & header = mwmValue->GetHeader();
-      CheckUniqueIndexes checkUnique(header.GetFormat() >= version::Format::v5);
+      m_checkUnique.Reset(header.GetFormat() >= version::Format::v5, src->GetNumFeatures());
 
       // In case of WorldCoasts we should pass correct scale in ForEachInIntervalAndScale.
       auto const lastScale = header.GetLastScale();
@@ -55,7 +61,7 @@ public:
       for (auto const & i : intervals)
       {
         index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint64_t /* key */, uint32_t value) {
-          if (!checkUnique(value))
+          if (!m_checkUnique(value))
             return;
           m_fn(value, *src);
         });
@@ -74,30 +80,44 @@ private:
   FeatureSourceFactory const & m_factory;
   Fn m_fn;
   DataSource::StopSearchCallback m_stop;
+  // Reused by all mwms to keep the memory of the bits.
+  mutable CheckUniqueIndexes m_checkUnique{false /* useBits */};
 };
 
-void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
+// Reads original features into one FeatureType which is reset for every feature, so
+// reading does not allocate a FeatureType per feature. Edited features are passed as is.
+class FeatureTypeReader
 {
-  unique_ptr<FeatureType> ft;
-  switch (src.GetFeatureStatus(index))
-  {
-  case FeatureStatus::Deleted:
-  case FeatureStatus::Obsolete: return;
-  case FeatureStatus::Created:
-  case FeatureStatus::Modified:
-  {
-    ft = src.GetModifiedFeature(index);
-    break;
-  }
-  case FeatureStatus::Untouched:
+public:
+  explicit FeatureTypeReader(DataSource::FeatureCallback const & fn) : m_fn(fn) {}
+
+  void operator()(uint32_t index, FeatureSource & src)
   {
-    ft = src.GetOriginalFeature(index);
-    break;
-  }
+    switch (src.GetFeatureStatus(index))
+    {
+    case FeatureStatus::Deleted:
+    case FeatureStatus::Obsolete: return;
+    case FeatureStatus::Created:
+    case FeatureStatus::Modified:
+    {
+      auto ft = src.GetModifiedFeature(index);
+      CHECK(ft, ());
+      m_fn(*ft);
+      return;
+    }
+    case FeatureStatus::Untouched:
+    {
+      src.ReadOriginalFeature(index, m_ft);
+      m_fn(m_ft);
+      return;
+    }
+    }
   }
-  CHECK(ft, ());
-  fn(*ft);
-}
+
+private:
+  DataSource::FeatureCallback const & m_fn;
+  FeatureType m_ft;
+};
 }  //  namespace
 
 // FeaturesLoaderGuard ---------------------------------------------------------------------
@@ -233,31 +253,128 @@ void DataSource::ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD c
 
 void DataSource::ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
-  };
+  FeatureTypeReader reader(f);
+  auto readFeatureType = [&reader](uint32_t index, FeatureSource & src) { reader(index, src); };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
   ForEachInIntervals(readFunctor, covering::ViewportWithLowLevels, rect, scale);
 }
 
+void DataSource::ForEachInRectParallel(FeatureCallback const & f, m2::RectD const & rect,
+                                       int scale, size_t threadsCount,
+                                       StopSearchCallback const & stop) const
+{
+  CHECK_GREATER(threadsCount, 0, ());
+
+  atomic<bool> stopped{false};
+  auto const isStopped = [&stopped, &stop]() {
+    if (!stopped && stop && stop())
+      stopped = true;
+    return stopped.load();
+  };
+
+  // Every task locks its own mwm value since readers of a value are not thread-safe.
+  auto const readIntervals = [this, &f, &rect, &isStopped](MwmId const & id,
+                                                           covering::Intervals const & intervals,
+                                                           int mwmScale, bool readAdditional,
+                                                           auto & checkUnique) {
+    MwmHandle const handle = GetMwmHandleById(id);
+    if (!handle.IsAlive())
+      return;
+
+    auto src = (*m_factory)(handle);
+    FeatureTypeReader reader(f);
+
+    MwmValue const * mwmValue = handle.GetValue<MwmValue>();
+    ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG),
+                                     mwmValue->m_factory);
+    for (auto const & i : intervals)
+    {
+      if (isStopped())
+        return;
+
+      index.ForEachInIntervalAndScale(i.first, i.second, mwmScale, [&](uint64_t /* key */,
+                                                                       uint32_t value) {
+        if (checkUnique(value))
+          reader(value, *src);
+      });
+    }
+
+    if (readAdditional)
+      src->ForEachAdditionalFeature(rect, mwmScale, [&](uint32_t i) { reader(i, *src); });
+  };
+
+  // Dedup sets must outlive the tasks.
+  vector<unique_ptr<CheckUniqueIndexes>> checkUniques;
+  vector<unique_ptr<ConcurrentCheckUniqueIndexes>> concurrentCheckUniques;
+
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  vector<future<void>> tasks;
+
+  auto const schedule = [&](MwmHandle const & handle, covering::CoveringGetter & cov,
+                            int mwmScale) {
+    MwmValue const * mwmValue = handle.GetValue<MwmValue>();
+    if (!mwmValue)
+      return;
+
+    feature::DataHeader const & header = mwmValue->GetHeader();
+    auto const lastScale = header.GetLastScale();
+    if (mwmScale > lastScale)
+      mwmScale = lastScale;
+
+    // Use last coding scale for covering (see index_builder.cpp).
+    covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
+    auto const & id = handle.GetId();
+
+    // Old formats have no features offsets table and can't share the dedup bits.
+    if (header.GetFormat() < version::Format::v5 || !mwmValue->m_table)
+    {
+      checkUniques.push_back(make_unique<CheckUniqueIndexes>(false /* useBits */));
+      auto & checkUnique = *checkUniques.back();
+      tasks.push_back(pool.Submit([&readIntervals, &checkUnique, id, intervals, mwmScale]() {
+        readIntervals(id, intervals, mwmScale, true /* readAdditional */, checkUnique);
+      }));
+      return;
+    }
+
+    concurrentCheckUniques.push_back(
+        make_unique<ConcurrentCheckUniqueIndexes>(mwmValue->m_table->size()));
+    auto & checkUnique = *concurrentCheckUniques.back();
+
+    auto const numTasks = max(min(threadsCount, intervals.size() / kMinIntervalsPerTask),
+                              size_t{1});
+    for (size_t task = 0; task < numTasks; ++task)
+    {
+      covering::Intervals taskIntervals(intervals.begin() + intervals.size() * task / numTasks,
+                                        intervals.begin() + intervals.size() * (task + 1) / numTasks);
+      tasks.push_back(pool.Submit([&readIntervals, &checkUnique, id, taskIntervals, mwmScale,
+                                  task]() {
+        readIntervals(id, taskIntervals, mwmScale, task == 0 /* readAdditional */, checkUnique);
+      }));
+    }
+  };
+
+  ForEachInIntervals(schedule, covering::ViewportWithLowLevels, rect, scale);
+
+  for (auto & task : tasks)
+    task.get();
+}
+
 void DataSource::ForClosestToPoint(FeatureCallback const & f, StopSearchCallback const & stop,
                                    m2::PointD const & center, double sizeM, int scale) const
 {
   auto const rect = MercatorBounds::RectByCenterXYAndSizeInMeters(center, sizeM);
 
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
-  };
+  FeatureTypeReader reader(f);
+  auto readFeatureType = [&reader](uint32_t index, FeatureSource & src) { reader(index, src); };
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType, stop);
   ForEachInIntervals(readFunctor, covering::CoveringMode::Spiral, rect, scale);
 }
 
 void DataSource::ForEachInScale(FeatureCallback const & f, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
-  };
+  FeatureTypeReader reader(f);
+  auto readFeatureType = [&reader](uint32_t index, FeatureSource & src) { reader(index, src); };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
   ForEachInIntervals(readFunctor, covering::FullCover, m2::RectD::GetInfiniteRect(), scale);
@@ -270,9 +387,8 @@ void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const
   if (handle.IsAlive())
   {
     covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
-    auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-      ReadFeatureType(f, src, index);
-    };
+    FeatureTypeReader reader(f);
+    auto readFeatureType = [&reader](uint32_t index, FeatureSource & src) { reader(index, src); };
 
     ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
     readFunctor(handle, cov, scale);
@@ -283,6 +399,8 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, vector<FeatureID> cons
 {
   ASSERT(is_sorted(features.begin(), features.end()), ());
 
+  // Reused for all original features.
+  FeatureType original;
   auto fidIter = features.begin();
   auto const endIter = features.end();
   while (fidIter != endIter)
@@ -299,13 +417,17 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, vector<FeatureID> cons
         ASSERT_NOT_EQUAL(
             FeatureStatus::Deleted, fts,
             ("Deleted feature was cached. It should not be here. Please review your code."));
-        unique_ptr<FeatureType> ft;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
-          ft = src->GetModifiedFeature(fidIter->m_index);
+        {
+          auto ft = src->GetModifiedFeature(fidIter->m_index);
+          CHECK(ft, ());
+          fn(*ft);
+        }
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
-        CHECK(ft, ());
-        fn(*ft);
+        {
+          src->ReadOriginalFeature(fidIter->m_index, original);
+          fn(original);
+        }
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
     }
     else
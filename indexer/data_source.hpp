@@ -43,6 +43,11 @@ public:
 
   void ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD const & rect, int scale) const;
   void ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const;
+  // Same as ForEachInRect() but reads mwms, and interval ranges of big mwms, by parallel tasks
+  // on |threadsCount| threads. The order of features is not specified. |f| and |stop| are called
+  // concurrently and must be thread-safe, reading stops when |stop| returns true.
+  void ForEachInRectParallel(FeatureCallback const & f, m2::RectD const & rect, int scale,
+                             size_t threadsCount, StopSearchCallback const & stop = {}) const;
   // Calls |f| for features closest to |center| until |stopCallback| returns true or distance
   // |sizeM| from has been reached. Then for EditableDataSource calls |f| for each edited feature
   // inside square with center |center| and side |2 * sizeM|. Edited features are not in the same
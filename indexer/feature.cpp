@@ -176,12 +176,23 @@ uint8_t ReadByte(TSource & src)
 }  // namespace
 
 FeatureType::FeatureType(SharedLoadInfo const * loadInfo, Buffer buffer)
+{
+  Reset(loadInfo, buffer);
+}
+
+void FeatureType::Reset(SharedLoadInfo const * loadInfo, Buffer buffer)
 {
   CHECK(loadInfo, ());
   m_loadInfo = loadInfo;
   m_data = buffer;
   m_header = Header(m_data);
 
+  m_id = FeatureID();
+  m_params.MakeZero();
+  m_points.clear();
+  m_triangles.clear();
+  m_metadata = feature::Metadata();
+
   m_offsets.Reset();
   m_ptsSimpMask = 0;
   m_limitRect.MakeEmpty();
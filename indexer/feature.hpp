@@ -34,9 +34,15 @@ public:
   using Buffer = char const *;
   using GeometryOffsets = buffer_vector<uint32_t, feature::DataHeader::kMaxScalesCount>;
 
+  // Empty feature to be filled by Reset().
+  FeatureType() = default;
   FeatureType(feature::SharedLoadInfo const * loadInfo, Buffer buffer);
   FeatureType(osm::MapObject const & emo);
 
+  // Drops all parsed data and starts parsing of |buffer| in place. Memory of geometry
+  // buffers is kept, so a feature may be reused for reading many features in a row.
+  void Reset(feature::SharedLoadInfo const * loadInfo, Buffer buffer);
+
   feature::GeomType GetGeomType() const;
   FeatureParamsBase & GetParams() { return m_params; }
 
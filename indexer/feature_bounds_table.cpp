@@ -0,0 +1,106 @@
+#include "indexer/feature_bounds_table.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/features_vector.hpp"
+
+#include "coding/file_writer.hpp"
+#include "coding/point_coding.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace feature
+{
+namespace
+{
+// Limit rect min and max points and center.
+size_t constexpr kPointsPerFeature = 3;
+size_t constexpr kFeatureSize =
+    kPointsPerFeature * indexer::BoundsRecords<BoundsTable::Reader>::kPointSize;
+}  // namespace
+
+// static
+uint8_t constexpr BoundsTable::kVersion;
+
+// BoundsTable -------------------------------------------------------------------------------------
+BoundsTable::BoundsTable(indexer::BoundsRecords<Reader> && records, uint8_t coordBits)
+  : m_records(move(records)), m_coordBits(coordBits)
+{
+}
+
+// static
+unique_ptr<BoundsTable> BoundsTable::Load(Reader const & reader, uint8_t coordBits)
+{
+  auto records = indexer::BoundsRecords<Reader>::Load(reader, kVersion, kFeatureSize);
+  if (!records)
+    return {};
+
+  return unique_ptr<BoundsTable>(new BoundsTable(move(*records), coordBits));
+}
+
+void BoundsTable::Get(uint32_t index, m2::RectD & limitRect, m2::PointD & center) const
+{
+  m2::PointD points[kPointsPerFeature];
+  m_records.GetPoints(index, 0 /* offset */, m_coordBits, points, kPointsPerFeature);
+  limitRect = m2::RectD(points[0], points[1]);
+  center = points[2];
+}
+
+// BoundsTableBuilder ------------------------------------------------------------------------------
+void BoundsTableBuilder::Put(m2::RectD const & limitRect, m2::PointD const & center)
+{
+  for (auto const & p : {limitRect.LeftBottom(), limitRect.RightTop(), center})
+    m_points.push_back(PointDToPointU(p, m_coordBits));
+}
+
+void BoundsTableBuilder::Freeze(Writer & writer) const
+{
+  WriteToSink(writer, BoundsTable::kVersion);
+  for (auto const & p : m_points)
+    indexer::WriteBoundsPoint(writer, p);
+}
+
+bool BuildBoundsTable(string const & path)
+{
+  try
+  {
+    vector<uint8_t> buffer;
+    {
+      FeaturesVectorTest features(path);
+      auto const coordBits = features.GetHeader().GetDefGeometryCodingParams().GetCoordBits();
+      BoundsTableBuilder builder(coordBits);
+
+      uint32_t expectedIndex = 0;
+      features.GetVector().ForEach([&](FeatureType & ft, uint32_t index) {
+        CHECK_EQUAL(index, expectedIndex, ("Features offsets table is needed."));
+        ++expectedIndex;
+        builder.Put(ft.GetLimitRect(FeatureType::BEST_GEOMETRY), GetCenter(ft));
+      });
+
+      MemWriter<vector<uint8_t>> writer(buffer);
+      builder.Freeze(writer);
+    }
+
+    FilesContainerW(path, FileWriter::OP_WRITE_EXISTING).Write(buffer, FEATURE_BOUNDS_FILE_TAG);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading file:", e.Msg()));
+    return false;
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LERROR, ("Error writing bounds section:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace feature
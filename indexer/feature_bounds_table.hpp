@@ -0,0 +1,60 @@
+#pragma once
+
+#include "indexer/bounds_records.hpp"
+
+#include "coding/file_container.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Writer;
+
+namespace feature
+{
+// A wrapper class around serialized bounds section: the limit rect and the center of the best
+// geometry for every feature, stored with fixed width to be read by feature index without
+// decoding of the geometry. Centers are the ones of feature::GetCenter().
+class BoundsTable
+{
+public:
+  using Reader = FilesContainerR::TReader;
+
+  static uint8_t constexpr kVersion = 0;
+
+  // Loads the table from |reader|. Returns nullptr if the table can't be loaded.
+  static std::unique_ptr<BoundsTable> Load(Reader const & reader, uint8_t coordBits);
+
+  size_t GetNumFeatures() const { return m_records.GetNumRecords(); }
+
+  void Get(uint32_t index, m2::RectD & limitRect, m2::PointD & center) const;
+
+private:
+  BoundsTable(indexer::BoundsRecords<Reader> && records, uint8_t coordBits);
+
+  indexer::BoundsRecords<Reader> m_records;
+  uint8_t m_coordBits;
+};
+
+class BoundsTableBuilder
+{
+public:
+  explicit BoundsTableBuilder(uint8_t coordBits) : m_coordBits(coordBits) {}
+
+  // Features must be put in the order of indexes.
+  void Put(m2::RectD const & limitRect, m2::PointD const & center);
+  void Freeze(Writer & writer) const;
+
+private:
+  uint8_t m_coordBits;
+  std::vector<m2::PointU> m_points;
+};
+
+// Builds bounds section for mwm |path|. Doesn't throw exceptions.
+bool BuildBoundsTable(std::string const & path);
+}  // namespace feature
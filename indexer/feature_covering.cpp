@@ -5,10 +5,131 @@
 
 #include "geometry/covering_utils.hpp"
 
+#include "base/buffer_vector.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 using namespace std;
 
 namespace
 {
+// Uniform grid over the rects of geometry primitives.
+class PrimitivesGrid
+{
+public:
+  struct Range
+  {
+    uint32_t GetCellsCount() const
+    {
+      return (m_maxRow - m_minRow + 1) * (m_maxColumn - m_minColumn + 1);
+    }
+
+    uint32_t m_minRow;
+    uint32_t m_maxRow;
+    uint32_t m_minColumn;
+    uint32_t m_maxColumn;
+  };
+
+  void Build(m2::RectD const & bounds, vector<m2::RectD> && rects)
+  {
+    m_bounds = bounds;
+    m_rects = move(rects);
+    auto const size = static_cast<uint32_t>(sqrt(m_rects.size()));
+    m_size = base::clamp(size, 1u, kMaxSize);
+
+    m_offsets.assign(m_size * m_size + 1, 0);
+    ForEachItemCell([this](uint32_t cell, uint32_t) { ++m_offsets[cell + 1]; });
+    partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+    m_items.resize(m_offsets.back());
+    auto nextPositions = m_offsets;
+    ForEachItemCell([&](uint32_t cell, uint32_t item) { m_items[nextPositions[cell]++] = item; });
+  }
+
+  bool IsBuilt() const { return m_size != 0; }
+  uint32_t GetCellsCount() const { return m_size * m_size; }
+
+  Range GetRange(m2::RectD const & r) const
+  {
+    return {GetIndex(r.minY(), m_bounds.minY(), m_bounds.SizeY()),
+            GetIndex(r.maxY(), m_bounds.minY(), m_bounds.SizeY()),
+            GetIndex(r.minX(), m_bounds.minX(), m_bounds.SizeX()),
+            GetIndex(r.maxX(), m_bounds.minX(), m_bounds.SizeX())};
+  }
+
+  // Calls |fn| once for each item whose rect intersects |r|.
+  template <typename Fn>
+  void ForEachIntersecting(m2::RectD const & r, Fn && fn) const
+  {
+    auto const range = GetRange(r);
+    for (auto row = range.m_minRow; row <= range.m_maxRow; ++row)
+    {
+      for (auto column = range.m_minColumn; column <= range.m_maxColumn; ++column)
+      {
+        auto const cell = row * m_size + column;
+        for (auto i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+        {
+          auto const item = m_items[i];
+          auto const & itemRect = m_rects[item];
+          if (!r.IsIntersect(itemRect))
+            continue;
+
+          // Each item is taken only from the first grid cell of the query range it lies in.
+          auto const itemRange = GetRange(itemRect);
+          if (row == max(itemRange.m_minRow, range.m_minRow) &&
+              column == max(itemRange.m_minColumn, range.m_minColumn))
+          {
+            fn(item);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  static uint32_t constexpr kMaxSize = 512;
+
+  uint32_t GetIndex(double value, double min, double size) const
+  {
+    if (size <= 0.0)
+      return 0;
+    auto const index = floor((value - min) / size * m_size);
+    return static_cast<uint32_t>(base::clamp(index, 0.0, static_cast<double>(m_size - 1)));
+  }
+
+  template <typename Fn>
+  void ForEachItemCell(Fn && fn) const
+  {
+    for (uint32_t item = 0; item < m_rects.size(); ++item)
+    {
+      auto const range = GetRange(m_rects[item]);
+      for (auto row = range.m_minRow; row <= range.m_maxRow; ++row)
+      {
+        for (auto column = range.m_minColumn; column <= range.m_maxColumn; ++column)
+          fn(row * m_size + column, item);
+      }
+    }
+  }
+
+  m2::RectD m_bounds;
+  vector<m2::RectD> m_rects;
+  // Grid has m_size x m_size cells, m_size is zero if the grid is not built.
+  uint32_t m_size = 0;
+  // Items of cell i are m_items[m_offsets[i], m_offsets[i + 1]).
+  vector<uint32_t> m_offsets;
+  vector<uint32_t> m_items;
+};
+
+m2::RectD GetCellRect(pair<uint32_t, uint32_t> const & xy, uint32_t radius)
+{
+  ASSERT_GREATER_OR_EQUAL(xy.first, radius, ());
+  ASSERT_GREATER_OR_EQUAL(xy.second, radius, ());
+  return m2::RectD(xy.first - radius, xy.second - radius, xy.first + radius, xy.second + radius);
+}
+
 // This class should only be used with covering::CoverObject()!
 template <int DEPTH_LEVELS>
 class FeatureIntersector
@@ -25,6 +146,36 @@ public:
   vector<Trg> m_trg;
   m2::RectD m_rect;
 
+  // Builds a uniform grid over triangles and polyline segments, so a cell query visits only
+  // the primitives near the cell. Must be called after all the primitives are added.
+  void BuildIndex()
+  {
+    size_t const segmentsCount = m_polyline.empty() ? 0 : m_polyline.size() - 1;
+    size_t const primitivesCount = m_trg.size() + segmentsCount;
+    if (primitivesCount < kMinIndexedPrimitivesCount)
+      return;
+
+    vector<m2::RectD> rects;
+    rects.reserve(primitivesCount);
+    for (auto const & trg : m_trg)
+    {
+      m2::RectD r;
+      r.Add(trg.m_a);
+      r.Add(trg.m_b);
+      r.Add(trg.m_c);
+      rects.push_back(r);
+    }
+    for (size_t i = 1; i < m_polyline.size(); ++i)
+    {
+      m2::RectD r;
+      r.Add(m_polyline[i - 1]);
+      r.Add(m_polyline[i]);
+      rects.push_back(r);
+    }
+
+    m_grid.Build(m_rect, move(rects));
+  }
+
   // Note:
   // 1. Here we don't need to differentiate between CELL_OBJECT_INTERSECT and OBJECT_INSIDE_CELL.
   // 2. We can return CELL_OBJECT_INTERSECT instead of CELL_INSIDE_OBJECT - it's just
@@ -33,19 +184,70 @@ public:
   {
     using namespace covering;
 
-    m2::RectD cellRect;
+    // Check for limit rect intersection.
+    auto const cellRect = GetCellRect(cell.XY(), cell.Radius());
+    if (!cellRect.IsIntersect(m_rect))
+      return CELL_OBJECT_NO_INTERSECTION;
+
+    // A query which touches most of the grid is faster without the grid.
+    if (!m_grid.IsBuilt() || 2 * m_grid.GetRange(cellRect).GetCellsCount() > m_grid.GetCellsCount())
+      return IntersectAll(cell, cellRect);
+
+    buffer_vector<uint32_t, 64> triangles;
+    buffer_vector<uint32_t, 64> segments;
+    m_grid.ForEachIntersecting(cellRect, [&](uint32_t item) {
+      if (item < m_trg.size())
+        triangles.push_back(item);
+      else
+        segments.push_back(item - static_cast<uint32_t>(m_trg.size()) + 1);
+    });
+
+    // The first intersected triangle decides the result as in the full scan.
+    sort(triangles.begin(), triangles.end());
+    for (auto const i : triangles)
     {
-      // Check for limit rect intersection.
-      pair<uint32_t, uint32_t> const xy = cell.XY();
-      uint32_t const r = cell.Radius();
-      ASSERT_GREATER_OR_EQUAL(xy.first, r, ());
-      ASSERT_GREATER_OR_EQUAL(xy.second, r, ());
-
-      cellRect = m2::RectD(xy.first - r, xy.second - r, xy.first + r, xy.second + r);
-      if (!cellRect.IsIntersect(m_rect))
-        return CELL_OBJECT_NO_INTERSECTION;
+      auto const res = IntersectTriangle(cell, i);
+      if (res != CELL_OBJECT_NO_INTERSECTION)
+        return res;
+    }
+
+    for (auto const i : segments)
+    {
+      if (IntersectSegment(cell, i) != CELL_OBJECT_NO_INTERSECTION)
+        return CELL_OBJECT_INTERSECT;
     }
 
+    return CELL_OBJECT_NO_INTERSECTION;
+  }
+
+  using Converter = CellIdConverter<MercatorBounds, m2::CellId<DEPTH_LEVELS>>;
+
+  m2::PointD ConvertPoint(m2::PointD const & p)
+  {
+    m2::PointD const pt(Converter::XToCellIdX(p.x), Converter::YToCellIdY(p.y));
+    m_rect.Add(pt);
+    return pt;
+  }
+
+  void operator() (m2::PointD const & pt)
+  {
+    m_polyline.push_back(ConvertPoint(pt));
+  }
+
+  void operator() (m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+  {
+    m_trg.emplace_back(ConvertPoint(a), ConvertPoint(b), ConvertPoint(c));
+  }
+
+private:
+  // Objects with less primitives are intersected by the full scan.
+  static size_t constexpr kMinIndexedPrimitivesCount = 32;
+
+  covering::CellObjectIntersection IntersectAll(m2::CellId<DEPTH_LEVELS> const & cell,
+                                                m2::RectD const & cellRect) const
+  {
+    using namespace covering;
+
     for (size_t i = 0; i < m_trg.size(); ++i)
     {
       m2::RectD r;
@@ -55,59 +257,164 @@ public:
       if (!cellRect.IsIntersect(r))
         continue;
 
-      CellObjectIntersection const res =
-          IntersectCellWithTriangle(cell, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
-
-      switch (res)
-      {
-      case CELL_OBJECT_NO_INTERSECTION:
-        break;
-      case CELL_INSIDE_OBJECT:
-        return CELL_INSIDE_OBJECT;
-      case CELL_OBJECT_INTERSECT:
-      case OBJECT_INSIDE_CELL:
-        return CELL_OBJECT_INTERSECT;
-      }
+      CellObjectIntersection const res = IntersectTriangle(cell, i);
+      if (res != CELL_OBJECT_NO_INTERSECTION)
+        return res;
     }
 
     for (size_t i = 1; i < m_polyline.size(); ++i)
     {
-      CellObjectIntersection const res =
-          IntersectCellWithLine(cell, m_polyline[i], m_polyline[i-1]);
-      switch (res)
-      {
-      case CELL_OBJECT_NO_INTERSECTION:
-        break;
-      case CELL_INSIDE_OBJECT:
-        ASSERT(false, (cell, i, m_polyline));
-        return CELL_OBJECT_INTERSECT;
-      case CELL_OBJECT_INTERSECT:
-      case OBJECT_INSIDE_CELL:
+      if (IntersectSegment(cell, i) != CELL_OBJECT_NO_INTERSECTION)
         return CELL_OBJECT_INTERSECT;
-      }
     }
 
     return CELL_OBJECT_NO_INTERSECTION;
   }
 
+  covering::CellObjectIntersection IntersectTriangle(m2::CellId<DEPTH_LEVELS> const & cell,
+                                                     size_t i) const
+  {
+    using namespace covering;
+
+    CellObjectIntersection const res =
+        IntersectCellWithTriangle(cell, m_trg[i].m_a, m_trg[i].m_b, m_trg[i].m_c);
+
+    switch (res)
+    {
+    case CELL_OBJECT_NO_INTERSECTION:
+      return CELL_OBJECT_NO_INTERSECTION;
+    case CELL_INSIDE_OBJECT:
+      return CELL_INSIDE_OBJECT;
+    case CELL_OBJECT_INTERSECT:
+    case OBJECT_INSIDE_CELL:
+      return CELL_OBJECT_INTERSECT;
+    }
+    UNREACHABLE();
+  }
+
+  covering::CellObjectIntersection IntersectSegment(m2::CellId<DEPTH_LEVELS> const & cell,
+                                                    size_t i) const
+  {
+    using namespace covering;
+
+    CellObjectIntersection const res =
+        IntersectCellWithLine(cell, m_polyline[i], m_polyline[i-1]);
+    switch (res)
+    {
+    case CELL_OBJECT_NO_INTERSECTION:
+      return CELL_OBJECT_NO_INTERSECTION;
+    case CELL_INSIDE_OBJECT:
+      ASSERT(false, (cell, i, m_polyline));
+      return CELL_OBJECT_INTERSECT;
+    case CELL_OBJECT_INTERSECT:
+    case OBJECT_INSIDE_CELL:
+      return CELL_OBJECT_INTERSECT;
+    }
+    UNREACHABLE();
+  }
+
+  PrimitivesGrid m_grid;
+};
+
+// Intersects cells with a polygon given by its rings directly, without triangulation.
+// The polygon interior is defined by the even-odd rule, so rings may be outers or holes.
+// This class should only be used with covering::CoverObject()!
+template <int DEPTH_LEVELS>
+class RingsIntersector
+{
+public:
   using Converter = CellIdConverter<MercatorBounds, m2::CellId<DEPTH_LEVELS>>;
 
-  m2::PointD ConvertPoint(m2::PointD const & p)
+  void operator()(vector<m2::PointD> const & ring)
   {
-    m2::PointD const pt(Converter::XToCellIdX(p.x), Converter::YToCellIdY(p.y));
-    m_rect.Add(pt);
-    return pt;
+    if (ring.size() < 3)
+      return;
+
+    auto const first = m_points.size();
+    for (auto const & p : ring)
+    {
+      m2::PointD const pt(Converter::XToCellIdX(p.x), Converter::YToCellIdY(p.y));
+      m_rect.Add(pt);
+      m_points.push_back(pt);
+    }
+
+    for (auto i = first; i + 1 < m_points.size(); ++i)
+      m_edges.emplace_back(i, i + 1);
+    if (m_points.back() != m_points[first])
+      m_edges.emplace_back(m_points.size() - 1, first);
   }
 
-  void operator() (m2::PointD const & pt)
+  void BuildIndex()
   {
-    m_polyline.push_back(ConvertPoint(pt));
+    vector<m2::RectD> rects;
+    rects.reserve(m_edges.size());
+    for (auto const & edge : m_edges)
+    {
+      m2::RectD r;
+      r.Add(m_points[edge.first]);
+      r.Add(m_points[edge.second]);
+      rects.push_back(r);
+    }
+
+    m_grid.Build(m_rect, move(rects));
   }
 
-  void operator() (m2::PointD const & a, m2::PointD const & b, m2::PointD const & c)
+  bool IsEmpty() const { return m_edges.empty(); }
+
+  covering::CellObjectIntersection operator()(m2::CellId<DEPTH_LEVELS> const & cell) const
   {
-    m_trg.emplace_back(ConvertPoint(a), ConvertPoint(b), ConvertPoint(c));
+    using namespace covering;
+
+    auto const cellRect = GetCellRect(cell.XY(), cell.Radius());
+    if (!cellRect.IsIntersect(m_rect))
+      return CELL_OBJECT_NO_INTERSECTION;
+
+    bool crossed = false;
+    m_grid.ForEachIntersecting(cellRect, [&](uint32_t edge) {
+      if (crossed)
+        return;
+
+      auto const & a = m_points[m_edges[edge].first];
+      auto const & b = m_points[m_edges[edge].second];
+      crossed = IntersectCellWithLine(cell, a, b) != CELL_OBJECT_NO_INTERSECTION;
+    });
+    if (crossed)
+      return CELL_OBJECT_INTERSECT;
+
+    // No edge touches the cell, so the whole cell is either inside or outside.
+    auto const xy = cell.XY();
+    return IsInside({static_cast<double>(xy.first), static_cast<double>(xy.second)})
+               ? CELL_INSIDE_OBJECT
+               : CELL_OBJECT_NO_INTERSECTION;
+  }
+
+private:
+  // Casts a ray from |pt| in the positive x direction and counts ring crossings.
+  bool IsInside(m2::PointD const & pt) const
+  {
+    if (!m_rect.IsPointInside(pt))
+      return false;
+
+    bool inside = false;
+    m2::RectD const ray(pt.x, pt.y, m_rect.maxX(), pt.y);
+    m_grid.ForEachIntersecting(ray, [&](uint32_t edge) {
+      auto const & a = m_points[m_edges[edge].first];
+      auto const & b = m_points[m_edges[edge].second];
+      if ((a.y > pt.y) == (b.y > pt.y))
+        return;
+
+      auto const x = a.x + (pt.y - a.y) * (b.x - a.x) / (b.y - a.y);
+      if (x > pt.x)
+        inside = !inside;
+    });
+    return inside;
   }
+
+  vector<m2::PointD> m_points;
+  // Edges are pairs of point indices.
+  vector<pair<size_t, size_t>> m_edges;
+  m2::RectD m_rect;
+  PrimitivesGrid m_grid;
 };
 
 template <int DEPTH_LEVELS>
@@ -120,11 +427,22 @@ void GetIntersection(FeatureType & f, FeatureIntersector<DEPTH_LEVELS> & fIsect)
 
   f.ForEachPoint(fIsect, scale);
   f.ForEachTriangle(fIsect, scale);
+  fIsect.BuildIndex();
 
   CHECK(!(fIsect.m_trg.empty() && fIsect.m_polyline.empty()) &&
         f.GetLimitRect(scale).IsValid(), (f.DebugString(scale)));
 }
 
+template <int DEPTH_LEVELS>
+vector<int64_t> ToInt64(vector<m2::CellId<DEPTH_LEVELS>> const & cells, int cellDepth)
+{
+  vector<int64_t> res(cells.size());
+  for (size_t i = 0; i < cells.size(); ++i)
+    res[i] = cells[i].ToInt64(cellDepth);
+
+  return res;
+}
+
 template <int DEPTH_LEVELS, typename Cover>
 vector<int64_t> CoverIntersection(
     Cover && cover, FeatureIntersector<DEPTH_LEVELS> const & fIsect, int cellDepth)
@@ -138,18 +456,22 @@ vector<int64_t> CoverIntersection(
                .ToInt64(cellDepth));
   }
 
-  auto && cells = cover(fIsect, cellDepth);
+  return ToInt64(cover(fIsect, cellDepth), cellDepth);
+}
 
-  vector<int64_t> res(cells.size());
-  for (size_t i = 0; i < cells.size(); ++i)
-    res[i] = cells[i].ToInt64(cellDepth);
+template <int DEPTH_LEVELS, typename Cover>
+vector<int64_t> CoverIntersection(
+    Cover && cover, RingsIntersector<DEPTH_LEVELS> const & ringsIsect, int cellDepth)
+{
+  if (ringsIsect.IsEmpty())
+    return {};
 
-  return res;
+  return ToInt64(cover(ringsIsect, cellDepth), cellDepth);
 }
 
-template <int DEPTH_LEVELS>
+template <int DEPTH_LEVELS, template <int> class Intersector>
 vector<int64_t> CoverIntersection(
-    FeatureIntersector<DEPTH_LEVELS> const & fIsect, int cellDepth, uint64_t cellPenaltyArea)
+    Intersector<DEPTH_LEVELS> const & fIsect, int cellDepth, uint64_t cellPenaltyArea)
 {
   auto cover = [cellPenaltyArea] (auto const & intersect, int cellDepth) {
     vector<m2::CellId<DEPTH_LEVELS>> cells;
@@ -161,9 +483,9 @@ vector<int64_t> CoverIntersection(
   return CoverIntersection(cover, fIsect, cellDepth);
 }
 
-template <int DEPTH_LEVELS>
+template <int DEPTH_LEVELS, template <int> class Intersector>
 vector<int64_t> CoverIntersection(
-    FeatureIntersector<DEPTH_LEVELS> const & fIsect, int cellDepth,
+    Intersector<DEPTH_LEVELS> const & fIsect, int cellDepth,
     base::thread_pool::computational::ThreadPool & threadPool)
 {
   auto cover = [&] (auto const & intersect, int cellDepth) {
@@ -176,9 +498,18 @@ vector<int64_t> CoverIntersection(
 template <int DEPTH_LEVELS>
 vector<int64_t> Cover(indexer::CoveredObject const & o, int cellDepth)
 {
+  if (o.HasRings())
+  {
+    RingsIntersector<DEPTH_LEVELS> ringsIsect;
+    o.ForEachRing(ringsIsect);
+    ringsIsect.BuildIndex();
+    return CoverIntersection(ringsIsect, cellDepth, 0 /* cellPenaltyArea */);
+  }
+
   FeatureIntersector<DEPTH_LEVELS> fIsect;
   o.ForEachPoint(fIsect);
   o.ForEachTriangle(fIsect);
+  fIsect.BuildIndex();
   return CoverIntersection(fIsect, cellDepth, 0 /* cellPenaltyArea */);
 }
 
@@ -186,9 +517,18 @@ template <int DEPTH_LEVELS>
 vector<int64_t> Cover(indexer::CoveredObject const & o, int cellDepth,
                       base::thread_pool::computational::ThreadPool & threadPool)
 {
+  if (o.HasRings())
+  {
+    RingsIntersector<DEPTH_LEVELS> ringsIsect;
+    o.ForEachRing(ringsIsect);
+    ringsIsect.BuildIndex();
+    return CoverIntersection(ringsIsect, cellDepth, threadPool);
+  }
+
   FeatureIntersector<DEPTH_LEVELS> fIsect;
   o.ForEachPoint(fIsect);
   o.ForEachTriangle(fIsect);
+  fIsect.BuildIndex();
   return CoverIntersection(fIsect, cellDepth, threadPool);
 }
 }  // namespace
@@ -42,6 +42,14 @@ unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) const
   return ft;
 }
 
+void FeatureSource::ReadOriginalFeature(uint32_t index, FeatureType & ft) const
+{
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector != nullptr, ());
+  m_vector->ReadByIndex(index, ft);
+  ft.SetID(FeatureID(m_handle.GetId(), index));
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t /*index*/) const
 {
   return FeatureStatus::Untouched;
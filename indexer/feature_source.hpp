@@ -34,6 +34,8 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  // Reads the original feature into |ft| without allocation of a new FeatureType.
+  void ReadOriginalFeature(uint32_t index, FeatureType & ft) const;
 
   FeatureID GetFeatureId(uint32_t index) const { return FeatureID(m_handle.GetId(), index); }
 
@@ -1,6 +1,7 @@
 #include "features_vector.hpp"
 #include "features_offsets_table.hpp"
 #include "data_factory.hpp"
+#include "feature_algo.hpp"
 
 #include "platform/constants.hpp"
 #include "platform/mwm_version.hpp"
@@ -15,6 +16,42 @@ std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
   return std::make_unique<FeatureType>(&m_loadInfo, &m_buffer[offset]);
 }
 
+void FeaturesVector::ReadByIndex(uint32_t index, FeatureType & ft) const
+{
+  uint32_t offset = 0, size = 0;
+  auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  m_recordReader.ReadRecord(ftOffset, m_buffer, offset, size);
+  ft.Reset(&m_loadInfo, &m_buffer[offset]);
+}
+
+// static
+void FeaturesVector::Project(FeatureType & ft, uint8_t fields,
+                             feature::BoundsTable const * boundsTable,
+                             feature::ProjectedFeature & projected)
+{
+  projected.m_geomType = ft.GetGeomType();
+
+  projected.m_types.clear();
+  if (fields & feature::PROJECT_TYPES)
+    ft.ForEachType([&projected](uint32_t type) { projected.m_types.push_back(type); });
+
+  projected.m_names = (fields & feature::PROJECT_NAMES) ? &ft.GetNames() : nullptr;
+
+  if ((fields & (feature::PROJECT_CENTER | feature::PROJECT_LIMIT_RECT)) == 0)
+    return;
+
+  if (boundsTable)
+  {
+    boundsTable->Get(projected.m_index, projected.m_limitRect, projected.m_center);
+    return;
+  }
+
+  if (fields & feature::PROJECT_LIMIT_RECT)
+    projected.m_limitRect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+  if (fields & feature::PROJECT_CENTER)
+    projected.m_center = feature::GetCenter(ft);
+}
+
 size_t FeaturesVector::GetNumFeatures() const
 {
   return m_table ? m_table->size() : 0;
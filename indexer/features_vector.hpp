@@ -3,13 +3,45 @@
 #include "indexer/feature.hpp"
 #include "indexer/shared_load_info.hpp"
 
+#include "coding/string_utf8_multilang.hpp"
 #include "coding/var_record_reader.hpp"
 
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/buffer_vector.hpp"
+
 #include <cstdint>
 #include <memory>
 #include <vector>
 
-namespace feature { class FeaturesOffsetsTable; }
+namespace feature
+{
+class FeaturesOffsetsTable;
+
+// Fields of features read by FeaturesVector::ForEachProjected().
+enum ProjectionFields : uint8_t
+{
+  PROJECT_TYPES = 1U << 0,
+  PROJECT_NAMES = 1U << 1,
+  PROJECT_CENTER = 1U << 2,
+  PROJECT_LIMIT_RECT = 1U << 3
+};
+
+// Feature read by FeaturesVector::ForEachProjected(). Only the requested fields are set.
+struct ProjectedFeature
+{
+  uint32_t m_index = 0;
+  GeomType m_geomType = GeomType::Undefined;
+  buffer_vector<uint32_t, kMaxTypesCount> m_types;
+  // Valid until the callback returns.
+  StringUtf8Multilang const * m_names = nullptr;
+  // Center as in feature::GetCenter().
+  m2::PointD m_center;
+  // Limit rect of the best geometry.
+  m2::RectD m_limitRect;
+};
+}  // namespace feature
 
 /// Note! This class is NOT Thread-Safe.
 /// You should have separate instance of Vector for every thread.
@@ -25,6 +57,8 @@ public:
   }
 
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
+  // Same as GetByIndex() but reuses |ft|. The feature is valid until the next read.
+  void ReadByIndex(uint32_t index, FeatureType & ft) const;
 
   size_t GetNumFeatures() const;
 
@@ -43,6 +77,27 @@ public:
     });
   }
 
+  // Same as ForEach() but reads only |fields| (see feature::ProjectionFields) of features.
+  // Centers and limit rects are taken from the bounds section of the mwm, if it exists,
+  // without decoding of the geometry.
+  template <class ToDo> void ForEachProjected(uint8_t fields, ToDo && toDo) const
+  {
+    auto const * boundsTable = m_table ? m_loadInfo.GetBoundsTable() : nullptr;
+    if (boundsTable && boundsTable->GetNumFeatures() != GetNumFeatures())
+      boundsTable = nullptr;
+
+    FeatureType ft;
+    feature::ProjectedFeature projected;
+    uint32_t index = 0;
+    m_recordReader.ForEachRecord([&](uint32_t pos, char const * data, uint32_t /*size*/) {
+      ft.Reset(&m_loadInfo, data);
+      projected.m_index = m_table ? index++ : pos;
+      ft.SetID(FeatureID(MwmSet::MwmId(), projected.m_index));
+      Project(ft, fields, boundsTable, projected);
+      toDo(projected);
+    });
+  }
+
   template <class ToDo> static void ForEachOffset(ModelReaderPtr reader, ToDo && toDo)
   {
     VarRecordReader<ModelReaderPtr, &VarRecordSizeReaderVarint> recordReader(reader, 256);
@@ -55,6 +110,9 @@ public:
 private:
   friend class FeaturesVectorTest;
 
+  static void Project(FeatureType & ft, uint8_t fields, feature::BoundsTable const * boundsTable,
+                      feature::ProjectedFeature & projected);
+
   feature::SharedLoadInfo m_loadInfo;
   VarRecordReader<FilesContainerR::TReader, &VarRecordSizeReaderVarint> m_recordReader;
   mutable std::vector<char> m_buffer;
@@ -0,0 +1,99 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_bounds_table.hpp"
+#include "indexer/features_vector.hpp"
+
+#include "platform/platform.hpp"
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "coding/internal/file_data.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace feature;
+using namespace platform::tests_support;
+using namespace std;
+
+namespace
+{
+double constexpr kEps = 1e-5;
+
+bool AlmostEqual(m2::PointD const & lhs, m2::PointD const & rhs)
+{
+  return base::AlmostEqualAbs(lhs, rhs, kEps);
+}
+}  // namespace
+
+UNIT_TEST(BoundsTable_ForEachProjected)
+{
+  classificator::Load();
+
+  string const fileName = "bounds_table_test" DATA_FILE_EXTENSION;
+  ScopedFile const mwm(fileName, ScopedFile::Mode::DoNotCreate);
+  TEST(base::CopyFileX(GetPlatform().ReadPathForFile("minsk-pass" DATA_FILE_EXTENSION),
+                       mwm.GetFullPath()), ());
+
+  struct Expected
+  {
+    vector<uint32_t> m_types;
+    size_t m_namesCount = 0;
+    m2::RectD m_limitRect;
+    m2::PointD m_center;
+  };
+
+  vector<Expected> expected;
+  {
+    FeaturesVectorTest features(mwm.GetFullPath());
+    features.GetVector().ForEach([&](FeatureType & ft, uint32_t index) {
+      TEST_EQUAL(index, expected.size(), ());
+      Expected e;
+      ft.ForEachType([&e](uint32_t type) { e.m_types.push_back(type); });
+      e.m_namesCount = ft.GetNames().CountLangs();
+      e.m_limitRect = ft.GetLimitRect(FeatureType::BEST_GEOMETRY);
+      e.m_center = GetCenter(ft);
+      expected.push_back(e);
+    });
+  }
+  TEST(!expected.empty(), ());
+
+  auto const check = [&](bool hasBoundsTable) {
+    FilesContainerR cont(mwm.GetFullPath());
+    TEST_EQUAL(cont.IsExist(FEATURE_BOUNDS_FILE_TAG), hasBoundsTable, ());
+
+    FeaturesVectorTest features(cont);
+    auto const & featuresVector = features.GetVector();
+    TEST_EQUAL(featuresVector.GetNumFeatures(), expected.size(), ());
+
+    size_t count = 0;
+    auto const checkGeometry = [&](ProjectedFeature const & f) {
+      auto const & e = expected[f.m_index];
+      TEST(f.m_types.empty(), ());
+      TEST(!f.m_names, ());
+      TEST(AlmostEqual(f.m_center, e.m_center), (f.m_index, f.m_center, e.m_center));
+      TEST(AlmostEqual(f.m_limitRect.LeftBottom(), e.m_limitRect.LeftBottom()), (f.m_index));
+      TEST(AlmostEqual(f.m_limitRect.RightTop(), e.m_limitRect.RightTop()), (f.m_index));
+      ++count;
+    };
+    featuresVector.ForEachProjected(PROJECT_CENTER | PROJECT_LIMIT_RECT, checkGeometry);
+    TEST_EQUAL(count, expected.size(), ());
+
+    featuresVector.ForEachProjected(PROJECT_TYPES | PROJECT_NAMES, [&](ProjectedFeature const & f) {
+      auto const & e = expected[f.m_index];
+      TEST_EQUAL(vector<uint32_t>(f.m_types.begin(), f.m_types.end()), e.m_types, (f.m_index));
+      TEST(f.m_names, ());
+      TEST_EQUAL(f.m_names->CountLangs(), e.m_namesCount, (f.m_index));
+    });
+  };
+
+  check(false /* hasBoundsTable */);
+
+  TEST(BuildBoundsTable(mwm.GetFullPath()), ());
+  check(true /* hasBoundsTable */);
+}
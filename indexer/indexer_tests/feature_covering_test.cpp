@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "indexer/cell_id.hpp"
+#include "indexer/covered_object.hpp"
+#include "indexer/feature_covering.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/buffer_vector.hpp"
+#include "base/math.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Triangle fan approximating a circle, the fan is repeated |copiesCount| times.
+indexer::CoveredObject MakeCircle(size_t trianglesCount, size_t copiesCount)
+{
+  m2::PointD const center{10.0, 20.0};
+  double const radius = 1.0;
+
+  buffer_vector<m2::PointD, 32> triangles;
+  for (size_t copy = 0; copy < copiesCount; ++copy)
+  {
+    for (size_t i = 0; i < trianglesCount; ++i)
+    {
+      auto const a = math::twicePi * i / trianglesCount;
+      auto const b = math::twicePi * (i + 1) / trianglesCount;
+      triangles.push_back(center);
+      triangles.push_back(center + m2::PointD{radius * cos(a), radius * sin(a)});
+      triangles.push_back(center + m2::PointD{radius * cos(b), radius * sin(b)});
+    }
+  }
+
+  indexer::CoveredObject object;
+  object.SetId(1);
+  object.SetTriangles(move(triangles));
+  return object;
+}
+
+vector<m2::PointD> MakeRing(m2::RectD const & rect)
+{
+  return {rect.LeftBottom(), rect.LeftTop(), rect.RightTop(), rect.RightBottom(),
+          rect.LeftBottom()};
+}
+
+bool IsCovered(vector<int64_t> const & cells, int cellDepth, m2::PointD const & point)
+{
+  using CellId = m2::CellId<kRegionsDepthLevels>;
+  using Converter = CellIdConverter<MercatorBounds, CellId>;
+  auto const pointCell = Converter::ToCellId(point.x, point.y);
+  for (auto const cellValue : cells)
+  {
+    auto const cell = CellId::FromInt64(cellValue, cellDepth);
+    auto parent = pointCell;
+    while (parent.Level() > cell.Level())
+      parent = parent.Parent();
+    if (parent == cell)
+      return true;
+  }
+  return false;
+}
+}  // namespace
+
+UNIT_TEST(CoverGeoObject_IndexedTriangles)
+{
+  int const cellDepth = kGeoObjectsDepthLevels - 6;
+  // Few triangles are intersected by the full scan.
+  auto const scanned = covering::CoverGeoObject(MakeCircle(16, 1), cellDepth);
+  // Copies do not change the object, but make it big enough to be intersected with a grid.
+  auto const indexed = covering::CoverGeoObject(MakeCircle(16, 8), cellDepth);
+
+  TEST(!scanned.empty(), ());
+  TEST_EQUAL(scanned, indexed, ());
+}
+
+UNIT_TEST(CoverRegion_Rings)
+{
+  int const cellDepth = 12;
+  base::thread_pool::computational::ThreadPool threadPool{1};
+  m2::RectD const outer{10.0, 10.0, 20.0, 20.0};
+  m2::RectD const hole{14.0, 14.0, 16.0, 16.0};
+
+  indexer::CoveredObject triangulated;
+  triangulated.SetForTesting(1, outer);
+  auto const trianglesCells = covering::CoverRegion(triangulated, cellDepth, threadPool);
+
+  indexer::CoveredObject square;
+  square.SetId(1);
+  square.SetRings({MakeRing(outer)});
+  auto const squareCells = covering::CoverRegion(square, cellDepth, threadPool);
+  TEST(IsCovered(squareCells, cellDepth, {12.0, 12.0}), ());
+  TEST(IsCovered(squareCells, cellDepth, {15.0, 15.0}), ());
+  TEST(!IsCovered(squareCells, cellDepth, {25.0, 25.0}), ());
+  TEST_LESS_OR_EQUAL(squareCells.size(), trianglesCells.size(), ());
+
+  indexer::CoveredObject squareWithHole;
+  squareWithHole.SetId(1);
+  squareWithHole.SetRings({MakeRing(outer), MakeRing(hole)});
+  auto const squareWithHoleCells = covering::CoverRegion(squareWithHole, cellDepth, threadPool);
+  TEST(IsCovered(squareWithHoleCells, cellDepth, {12.0, 12.0}), ());
+  TEST(!IsCovered(squareWithHoleCells, cellDepth, {15.0, 15.0}), ());
+  TEST(!IsCovered(squareWithHoleCells, cellDepth, {25.0, 25.0}), ());
+}
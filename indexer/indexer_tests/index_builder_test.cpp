@@ -14,6 +14,10 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 UNIT_TEST(BuildIndexTest)
 {
   Platform & p = GetPlatform();
@@ -60,3 +64,55 @@ UNIT_TEST(BuildIndexTest)
   // Clean after the test.
   FileWriter::DeleteFileX(filePath);
 }
+
+UNIT_TEST(FeaturesVector_ReadByIndex)
+{
+  classificator::Load();
+
+  FilesContainerR container(GetPlatform().GetReader("minsk-pass" DATA_FILE_EXTENSION));
+  FeaturesVectorTest features(container);
+  auto const & vector = features.GetVector();
+  TEST_GREATER(vector.GetNumFeatures(), 0, ());
+
+  FeatureType reused;
+  for (uint32_t i = 0; i < vector.GetNumFeatures(); ++i)
+  {
+    auto const expected = vector.GetByIndex(i)->DebugString(FeatureType::BEST_GEOMETRY);
+    vector.ReadByIndex(i, reused);
+    TEST_EQUAL(reused.DebugString(FeatureType::BEST_GEOMETRY), expected, (i));
+  }
+}
+
+UNIT_TEST(DataSource_ForEachInRectParallel)
+{
+  classificator::Load();
+
+  FrozenDataSource dataSource;
+  auto const path = GetPlatform().ReadPathForFile("minsk-pass" DATA_FILE_EXTENSION);
+  auto const regResult = dataSource.RegisterMap(platform::LocalCountryFile::MakeTemporary(path));
+  TEST_EQUAL(regResult.second, MwmSet::RegResult::Success, ());
+
+  m2::RectD const rect = regResult.first.GetInfo()->m_bordersRect;
+  for (int scale : {10, 17})
+  {
+    vector<uint32_t> expected;
+    dataSource.ForEachInRect([&](FeatureType & ft) { expected.push_back(ft.GetID().m_index); },
+                             rect, scale);
+    sort(expected.begin(), expected.end());
+    TEST(!expected.empty(), (scale));
+
+    for (size_t threadsCount : {1, 3})
+    {
+      mutex mu;
+      vector<uint32_t> actual;
+      dataSource.ForEachInRectParallel(
+          [&](FeatureType & ft) {
+            lock_guard<mutex> lock(mu);
+            actual.push_back(ft.GetID().m_index);
+          },
+          rect, scale, threadsCount);
+      sort(actual.begin(), actual.end());
+      TEST_EQUAL(actual, expected, (scale, threadsCount));
+    }
+  }
+}
@@ -9,6 +9,9 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <random>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -170,6 +173,39 @@ UNIT_TEST(IntervalIndexV2_Serialized)
   TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
 }
 
+UNIT_TEST(IntervalIndexV3_Serialized)
+{
+  vector<CellIdFeaturePairForTest> data;
+  data.push_back(CellIdFeaturePairForTest(0x1537U, 0));
+  data.push_back(CellIdFeaturePairForTest(0x1538U, 1));
+  data.push_back(CellIdFeaturePairForTest(0x1637U, 2));
+  vector<uint8_t> serialIndex;
+  MemWriter<vector<uint8_t>> writer(serialIndex);
+  IntervalIndexBuilder(IntervalIndexVersion::V3, 16, 1, 4).BuildIndex(writer, data.begin(), data.end());
+
+  char const expSerial [] =
+      "\x03\x02\x04\x01"                  // Header
+      "\x24\x00\x00\x00\x00\x00\x00\x00"  // Leaves level offset
+      "\x2F\x00\x00\x00\x00\x00\x00\x00"  // Level 1 offset
+      "\x34\x00\x00\x00\x00\x00\x00\x00"  // Root level offset
+      "\x37\x00\x00\x00\x00\x00\x00\x00"  // Root level offset
+      "\x02" "\x06\x77\x00" "\x02\x08"      // 0x1537 0x1538: 6 bits keys 0x37 +1, 2 bits values
+      "\x01" "\x06\x37" "\x03\x04"           // 0x1637: 6 bits key 0x37, 3 bits value +2
+      "\x01\x60\x00\x06\x05"              // 0x15, 0x16 node
+      "\x00\x01\x05"                      // Root
+      "";
+
+  TEST_EQUAL(serialIndex, vector<uint8_t>(expSerial, expSerial + ARRAY_SIZE(expSerial) - 1), ());
+
+  MemReader reader(&serialIndex[0], serialIndex.size());
+  IntervalIndex<MemReader, uint32_t> index(reader);
+  uint32_t expected [] = {0, 1, 2};
+  vector<uint32_t> values;
+  TEST_EQUAL(index.KeyEnd(), 0x10000, ());
+  index.ForEach(IndexValueInserter(values), 0, 0x10000);
+  TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
+}
+
 UNIT_TEST(IntervalIndex_Simple)
 {
   vector<CellIdFeaturePairForTest> data;
@@ -318,3 +354,105 @@ UNIT_TEST(IntervalIndex_Simple5)
     TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
   }
 }
+
+UNIT_TEST(IntervalIndex_MultipleIntervals)
+{
+  mt19937 rng(0);
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 5000; ++i)
+    data.emplace_back(rng() % (1 << 20), i);
+  sort(data.begin(), data.end(), [](auto const & l, auto const & r) {
+    return make_pair(l.m_cell, l.m_value) < make_pair(r.m_cell, r.m_value);
+  });
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 20);
+
+  // MemReader is read without copying unlike MemReaderWithExceptions.
+  MemReader reader(serialIndex.data(), serialIndex.size());
+  IntervalIndex<MemReader, uint32_t> index(reader);
+  MemReaderWithExceptions copyingReader(serialIndex.data(), serialIndex.size());
+  IntervalIndex<MemReaderWithExceptions, uint32_t> copyingIndex(copyingReader);
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    vector<uint64_t> bounds;
+    for (size_t i = 0; i < 2 + rng() % 40; ++i)
+      bounds.push_back(rng() % (index.KeyEnd() + 100));
+    sort(bounds.begin(), bounds.end());
+    vector<pair<uint64_t, uint64_t>> intervals;
+    for (size_t i = 0; i + 1 < bounds.size(); i += 2)
+      intervals.emplace_back(bounds[i], bounds[i + 1]);
+
+    vector<pair<uint64_t, uint32_t>> expected;
+    for (auto const & interval : intervals)
+    {
+      index.ForEach([&](uint64_t key, uint32_t value) { expected.emplace_back(key, value); },
+                    interval.first, interval.second);
+    }
+
+    vector<pair<uint64_t, uint32_t>> values;
+    index.ForEach([&](uint64_t key, uint32_t value) { values.emplace_back(key, value); },
+                  intervals);
+    TEST_EQUAL(values, expected, (intervals));
+
+    values.clear();
+    copyingIndex.ForEach([&](uint64_t key, uint32_t value) { values.emplace_back(key, value); },
+                         intervals);
+    TEST_EQUAL(values, expected, (intervals));
+
+    for (auto const & value : values)
+    {
+      TEST(any_of(intervals.begin(), intervals.end(), [&value](auto const & interval) {
+             return interval.first <= value.first && value.first < interval.second;
+           }),
+           (value));
+    }
+  }
+}
+
+UNIT_TEST(IntervalIndexV3_SameAsV2)
+{
+  mt19937 rng(0);
+  vector<CellIdFeaturePairForTest> data;
+  // Leaves have several frames of entries with repeated keys.
+  for (uint32_t i = 0; i < 5000; ++i)
+    data.emplace_back(1 + rng() % (1 << 12), rng() % 3 == 0 ? i : rng());
+  sort(data.begin(), data.end(), [](auto const & l, auto const & r) {
+    return make_pair(l.m_cell, l.m_value) < make_pair(r.m_cell, r.m_value);
+  });
+
+  vector<char> serialIndexV2;
+  vector<char> serialIndexV3;
+  {
+    MemWriter<vector<char>> writer(serialIndexV2);
+    BuildIntervalIndex(data.begin(), data.end(), writer, 16, IntervalIndexVersion::V2);
+  }
+  {
+    MemWriter<vector<char>> writer(serialIndexV3);
+    BuildIntervalIndex(data.begin(), data.end(), writer, 16, IntervalIndexVersion::V3);
+  }
+  TEST_LESS(serialIndexV3.size(), serialIndexV2.size(), ());
+
+  MemReader readerV2(serialIndexV2.data(), serialIndexV2.size());
+  IntervalIndex<MemReader, uint32_t> indexV2(readerV2);
+  MemReaderWithExceptions readerV3(serialIndexV3.data(), serialIndexV3.size());
+  IntervalIndex<MemReaderWithExceptions, uint32_t> indexV3(readerV3);
+  TEST_EQUAL(indexV2.KeyEnd(), indexV3.KeyEnd(), ());
+
+  for (size_t test = 0; test < 100; ++test)
+  {
+    uint64_t beg = rng() % indexV2.KeyEnd();
+    uint64_t end = rng() % indexV2.KeyEnd();
+    if (beg > end)
+      swap(beg, end);
+
+    vector<pair<uint64_t, uint32_t>> expected;
+    indexV2.ForEach([&](uint64_t key, uint32_t value) { expected.emplace_back(key, value); },
+                    beg, end);
+    vector<pair<uint64_t, uint32_t>> values;
+    indexV3.ForEach([&](uint64_t key, uint32_t value) { values.emplace_back(key, value); },
+                    beg, end);
+    TEST_EQUAL(values, expected, (beg, end));
+  }
+}
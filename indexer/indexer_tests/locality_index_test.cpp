@@ -4,6 +4,7 @@
 #include "indexer/covering_index.hpp"
 #include "indexer/covering_index_builder.hpp"
 #include "indexer/covered_object.hpp"
+#include "indexer/covered_objects_geometry.hpp"
 
 #include "coding/file_container.hpp"
 #include "coding/reader.hpp"
@@ -14,6 +15,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -221,4 +223,140 @@ UNIT_TEST(CoveringIndexWeightRankTest)
   TEST(ids[6].second < ids[3].second, ());
 }
 
+UNIT_TEST(LocalityIndexNearestToPointTest)
+{
+  m2::PointD const queryPoint{0.013, 0.021};
+
+  vector<CoveredObject> objects;
+  map<uint64_t, m2::PointD> points;
+  for (int x = -10; x <= 10; ++x)
+  {
+    for (int y = -10; y <= 10; ++y)
+    {
+      uint64_t const id = points.size() + 1;
+      m2::PointD const point{x * 0.05, y * 0.05};
+      points.emplace(id, point);
+      objects.emplace_back();
+      objects.back().SetForTesting(id, point);
+    }
+  }
+
+  vector<uint8_t> localityIndex;
+  MemWriter<vector<uint8_t>> writer(localityIndex);
+  BuildGeoObjectsIndex(objects, writer);
+  MemReader reader(localityIndex.data(), localityIndex.size());
+
+  indexer::GeoObjectsIndex<MemReader> index(reader);
+
+  using DistanceIds = vector<pair<double, uint64_t>>;
+  DistanceIds expected;
+  for (auto const & point : points)
+  {
+    expected.emplace_back(MercatorBounds::DistanceOnEarth(queryPoint, point.second),
+                          point.first);
+  }
+  sort(expected.begin(), expected.end());
+
+  size_t distanceCalls = 0;
+  auto const distance = [&](base::GeoObjectId const & id) {
+    ++distanceCalls;
+    return MercatorBounds::DistanceOnEarth(queryPoint, points.at(id.GetEncodedId()));
+  };
+
+  uint32_t const k = 5;
+  DistanceIds nearest;
+  index.ForNearestToPoint(
+      [&nearest](base::GeoObjectId const & id, double distanceM) {
+        nearest.emplace_back(distanceM, id.GetEncodedId());
+      },
+      distance, queryPoint, MercatorBounds::DistanceOnEarth(queryPoint, {2, 2}), k);
+
+  TEST_EQUAL(nearest, DistanceIds(expected.begin(), expected.begin() + k), ());
+  // Only several rings around the query point are scanned.
+  TEST_LESS(distanceCalls, points.size() / 2, ());
+
+  // Objects out of radius are skipped.
+  nearest.clear();
+  index.ForNearestToPoint(
+      [&nearest](base::GeoObjectId const & id, double distanceM) {
+        nearest.emplace_back(distanceM, id.GetEncodedId());
+      },
+      distance, queryPoint, expected[1].first, k);
+  TEST_EQUAL(nearest, DistanceIds(expected.begin(), expected.begin() + 2), ());
+}
+
+UNIT_TEST(LocalityIndexNearestToPointByGeometryTest)
+{
+  m2::PointD const queryPoint{0.013, 0.021};
+
+  using DistanceIds = vector<pair<double, uint64_t>>;
+  vector<CoveredObject> objects;
+  DistanceIds expected;
+  for (int x = -10; x <= 10; ++x)
+  {
+    for (int y = -10; y <= 10; ++y)
+    {
+      uint64_t const id = objects.size() + 1;
+      m2::PointD const point{x * 0.05, y * 0.05};
+      objects.emplace_back();
+      objects.back().SetForTesting(id, point);
+      expected.emplace_back(MercatorBounds::DistanceOnEarth(queryPoint, point), id);
+    }
+  }
+
+  // The area covers the query point.
+  uint64_t const areaId = objects.size() + 1;
+  objects.emplace_back();
+  objects.back().SetForTesting(areaId, m2::RectD{0.01, 0.02, 0.02, 0.03});
+  expected.emplace_back(0.0, areaId);
+
+  // The limit rect of the line covers the query point but several points are nearer.
+  uint64_t const lineId = objects.size() + 1;
+  objects.emplace_back();
+  objects.back().SetId(lineId);
+  objects.back().SetPoints(
+      buffer_vector<m2::PointD, 32>{{-0.5, -0.03}, {0.5, -0.03}, {0.5, 0.5}});
+  expected.emplace_back(MercatorBounds::DistanceOnEarth(queryPoint, {queryPoint.x, -0.03}),
+                        lineId);
+  sort(expected.begin(), expected.end());
+
+  CoveredObjectsGeometryBuilder geometryBuilder;
+  for (auto const & object : objects)
+    geometryBuilder.Put(object);
+
+  vector<uint8_t> localityIndex;
+  MemWriter<vector<uint8_t>> writer(localityIndex);
+  BuildGeoObjectsIndex(objects, writer);
+  MemReader reader(localityIndex.data(), localityIndex.size());
+
+  vector<uint8_t> geometry;
+  MemWriter<vector<uint8_t>> geometryWriter(geometry);
+  geometryBuilder.Freeze(geometryWriter);
+  MemReader geometryReader(geometry.data(), geometry.size());
+
+  TEST(!indexer::GeoObjectsIndex<MemReader>(reader).HasGeometry(), ());
+  indexer::GeoObjectsIndex<MemReader> index(reader, geometryReader);
+  TEST(index.HasGeometry(), ());
+
+  // The area is the nearest one and the line is before the last one.
+  uint32_t const k = 7;
+  TEST_EQUAL(expected[0].second, areaId, ());
+  TEST_EQUAL(expected[k - 2].second, lineId, ());
+
+  DistanceIds nearest;
+  index.ForNearestToPoint(
+      [&nearest](base::GeoObjectId const & id, double distanceM) {
+        nearest.emplace_back(distanceM, id.GetEncodedId());
+      },
+      queryPoint, MercatorBounds::DistanceOnEarth(queryPoint, {2, 2}), k);
+
+  TEST_EQUAL(nearest.size(), k, ());
+  for (size_t i = 0; i < k; ++i)
+  {
+    TEST_EQUAL(nearest[i].second, expected[i].second, ());
+    // Geometry is stored with the precision of point coding.
+    TEST_NEAR(nearest[i].first, expected[i].first, 1.0, ());
+  }
+}
+
 }  // namespace
@@ -7,7 +7,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 using platform::CountryFile;
@@ -34,6 +36,30 @@ void TestFilesPresence(MwmsInfo const & mwmsInfo, initializer_list<string> const
   for (string const & countryFileName : expectedNames)
     TEST_EQUAL(1, mwmsInfo.count(countryFileName), (countryFileName));
 }
+
+class CountingMwmSet : public TestMwmSet
+{
+public:
+  class Value : public MwmValueBase
+  {
+  public:
+    explicit Value(size_t & count) : m_count(count) { ++m_count; }
+    ~Value() override { --m_count; }
+
+  private:
+    size_t & m_count;
+  };
+
+  explicit CountingMwmSet(size_t cacheSize) : TestMwmSet(cacheSize) {}
+
+  mutable size_t m_valuesCount = 0;
+
+protected:
+  unique_ptr<MwmValueBase> CreateValue(MwmInfo &) const override
+  {
+    return make_unique<Value>(m_valuesCount);
+  }
+};
 }  // namespace
 
 UNIT_TEST(MwmSetSmokeTest)
@@ -158,3 +184,70 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetConcurrentHandlesTest)
+{
+  TestMwmSet mwmSet;
+  auto const id = mwmSet.Register(LocalCountryFile::MakeForTesting("5")).first;
+  TEST(id.IsAlive(), ());
+
+  // Released values are reused by the next handles.
+  MwmSet::MwmValueBase * value = nullptr;
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(id);
+    value = handle.GetValue<MwmSet::MwmValueBase>();
+  }
+  TEST_EQUAL(mwmSet.GetMwmHandleById(id).GetValue<MwmSet::MwmValueBase>(), value, ());
+
+  size_t const kThreadsCount = 4;
+  vector<thread> threads;
+  for (size_t i = 0; i < kThreadsCount; ++i)
+  {
+    threads.emplace_back([&mwmSet, &id]() {
+      for (size_t j = 0; j < 1000; ++j)
+      {
+        MwmSet::MwmHandle const handle0 = mwmSet.GetMwmHandleById(id);
+        MwmSet::MwmHandle const handle1 = mwmSet.GetMwmHandleById(id);
+        if (handle0.IsAlive() && handle1.IsAlive())
+        {
+          TEST_NOT_EQUAL(handle0.GetValue<MwmSet::MwmValueBase>(),
+                         handle1.GetValue<MwmSet::MwmValueBase>(), ());
+        }
+      }
+    });
+  }
+
+  mwmSet.Deregister(CountryFile("5"));
+  for (auto & thread : threads)
+    thread.join();
+
+  // The last released handle completes deregistration.
+  TEST_EQUAL(MwmInfo::STATUS_DEREGISTERED, id.GetInfo()->GetStatus(), ());
+  TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, ());
+  TEST(!mwmSet.GetMwmHandleById(id).IsAlive(), ());
+}
+
+UNIT_TEST(MwmSetIdleValuesLimitTest)
+{
+  size_t const kCacheSize = 2;
+  CountingMwmSet mwmSet(kCacheSize);
+  vector<MwmSet::MwmId> ids;
+  for (auto const & name : {"1", "2", "3"})
+    ids.push_back(mwmSet.Register(LocalCountryFile::MakeForTesting(name)).first);
+
+  {
+    vector<MwmSet::MwmHandle> handles;
+    for (auto const & id : ids)
+    {
+      handles.push_back(mwmSet.GetMwmHandleById(id));
+      handles.push_back(mwmSet.GetMwmHandleById(id));
+    }
+    TEST_EQUAL(mwmSet.m_valuesCount, 2 * ids.size(), ());
+  }
+
+  // Pooled and cached values share the limit.
+  TEST_EQUAL(mwmSet.m_valuesCount, kCacheSize, ());
+
+  mwmSet.ClearCache();
+  TEST_EQUAL(mwmSet.m_valuesCount, 0, ());
+}
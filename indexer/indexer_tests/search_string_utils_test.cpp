@@ -262,3 +262,14 @@ UNIT_TEST(NormalizeAndSimplifyString_Numero)
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area # "), "area   ", ());
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Area #One"), "area #one", ());
 }
+
+UNIT_TEST(NormalizeAndSimplifyString_AsciiRunsAndMixedChars)
+{
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("THE QUICK Brown FOX@[`{AZaz"),
+             "the quick brown fox@[`{azaz", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("OUTSIDE Œuvre İSTANBUL Café №5 😀 ẞ"),
+             "outside oeuvre istanbul cafe  5 😀 ss", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8(""), "", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8(string("Null\0Char", 9)), string("null\0char", 9),
+             ());
+}
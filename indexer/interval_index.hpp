@@ -1,19 +1,25 @@
 #pragma once
+#include "coding/bit_packed_frames.hpp"
 #include "coding/endianness.hpp"
 #include "coding/byte_stream.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/varint.hpp"
 
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <utility>
 
 enum class IntervalIndexVersion : uint8_t
 {
   V1 = 1,
   V2 = 2,
+  // V2 with leaves of bit-packed frames of keys and values, see IntervalIndexBuilder.
+  V3 = 3,
 };
 
 class IntervalIndexBase
@@ -37,18 +43,42 @@ public:
   }
 };
 
+// Returns memory of |reader| to read nodes without copying or nullptr.
+template <class ReaderT>
+uint8_t const * GetIntervalIndexMemory(ReaderT const & /* reader */)
+{
+  return nullptr;
+}
+
+inline uint8_t const * GetIntervalIndexMemory(MemReader const & reader)
+{
+  return reinterpret_cast<uint8_t const *>(reader.Data());
+}
+
+template <class ReaderT>
+uint8_t const * GetIntervalIndexMemory(ReaderPtr<ReaderT> const & reader)
+{
+  if (auto const mmapReader = dynamic_cast<MmapReader const *>(reader.GetPtr()))
+    return mmapReader->DataWithOffset();
+  if (auto const memReader = dynamic_cast<MemReader const *>(reader.GetPtr()))
+    return GetIntervalIndexMemory(*memReader);
+  return nullptr;
+}
+
 template <class ReaderT, typename Value>
 class IntervalIndex : public IntervalIndexBase
 {
   typedef IntervalIndexBase base_t;
 public:
 
-  explicit IntervalIndex(ReaderT const & reader) : m_Reader(reader)
+  explicit IntervalIndex(ReaderT const & reader)
+    : m_Reader(reader), m_Memory(GetIntervalIndexMemory(reader))
   {
     ReaderSource<ReaderT> src(reader);
     src.Read(&m_Header, sizeof(Header));
     auto const version = static_cast<IntervalIndexVersion>(m_Header.m_Version);
-    CHECK(version == IntervalIndexVersion::V1 || version == IntervalIndexVersion::V2, ());
+    CHECK(version == IntervalIndexVersion::V1 || version == IntervalIndexVersion::V2 ||
+          version == IntervalIndexVersion::V3, ());
     if (m_Header.m_Levels != 0)
     {
       for (int i = 0; i <= m_Header.m_Levels + 1; ++i)
@@ -69,50 +99,132 @@ public:
   template <typename F>
   void ForEach(F const & f, uint64_t beg, uint64_t end) const
   {
-    if (m_Header.m_Levels != 0 && beg != end)
+    std::pair<uint64_t, uint64_t> const intervals[] = {{beg, end}};
+    ForEach(f, intervals);
+  }
+
+  // Calls |f| for keys within sorted non-overlapping [beg, end) |intervals|. Every node of
+  // the index is read and decoded once for all the intervals.
+  template <typename F, typename Intervals>
+  void ForEach(F const & f, Intervals const & intervals) const
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    KeyRanges ranges;
+    for (auto const & interval : intervals)
     {
       // ASSERT_LESS_OR_EQUAL(beg, KeyEnd(), (end));
       // ASSERT_LESS_OR_EQUAL(end, KeyEnd(), (beg));
-      if (beg > KeyEnd())
-        beg = KeyEnd();
-      if (end > KeyEnd())
-        end = KeyEnd();
-      --end;  // end is inclusive in ForEachImpl().
-      ForEachNode(f, beg, end, m_Header.m_Levels, 0,
-                  m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels],
-                  0 /* started keyBase */);
+      auto const beg = std::min(static_cast<uint64_t>(interval.first), KeyEnd());
+      auto const end = std::min(static_cast<uint64_t>(interval.second), KeyEnd());
+      if (beg >= end)
+        continue;
+
+      ASSERT(ranges.empty() || ranges.back().m_end < beg, ("Unsorted or overlapping intervals."));
+      // End is inclusive in ForEachNode().
+      ranges.push_back({beg, end - 1});
     }
+
+    if (ranges.empty())
+      return;
+
+    ForEachNode(f, ranges.begin(), ranges.end(), m_Header.m_Levels, 0,
+                m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels],
+                0 /* started keyBase */);
   }
 
 private:
+  struct KeyRange
+  {
+    uint64_t m_beg;
+    uint64_t m_end;
+  };
+  using KeyRanges = buffer_vector<KeyRange, 32>;
+
+  template <size_t N>
+  uint8_t const * ReadNode(uint64_t offset, uint64_t size, buffer_vector<uint8_t, N> & data) const
+  {
+    if (m_Memory)
+      return m_Memory + offset;
+
+    data.resize_no_init(size);
+    m_Reader.Read(offset, data.data(), size);
+    return data.data();
+  }
+
   template <typename F>
-  void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
+  void ForEachLeaf(F const & f, KeyRange const * first, KeyRange const * last,
       uint64_t const offset, uint64_t const size,
       uint64_t keyBase /* discarded part of object key value in the parent nodes*/) const
   {
-    buffer_vector<uint8_t, 1024> data;
-    data.resize_no_init(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    buffer_vector<uint8_t, 1024> buffer;
+    uint8_t const * data = ReadNode(offset, size, buffer);
+    if (m_Header.m_Version == static_cast<uint8_t>(IntervalIndexVersion::V3))
+    {
+      ForEachPackedLeaf(f, first, last, data, keyBase);
+      return;
+    }
 
-    void const * pEnd = &data[0] + size;
+    ArrayByteSource src(data);
+    void const * pEnd = data + size;
     Value value = 0;
     while (src.Ptr() < pEnd)
     {
       uint32_t key = 0;
       src.Read(&key, m_Header.m_LeafBytes);
       key = SwapIfBigEndianMacroBased(key);
-      if (key > end)
+      uint64_t const fullKey = keyBase + key;
+      while (first != last && first->m_end < fullKey)
+        ++first;
+      if (first == last)
         break;
       value += ReadVarInt<int64_t>(src);
-      if (key >= beg)
-        f(keyBase + key, value);
+      if (fullKey >= first->m_beg)
+        f(fullKey, value);
+    }
+  }
+
+  template <typename F>
+  void ForEachPackedLeaf(F const & f, KeyRange const * first, KeyRange const * last,
+                         uint8_t const * data, uint64_t keyBase) const
+  {
+    ArrayByteSource src(data);
+    uint64_t count = ReadVarUint<uint64_t>(src);
+    data = static_cast<uint8_t const *>(src.Ptr());
+
+    uint64_t keys[coding::kPackedFrameSize];
+    uint64_t values[coding::kPackedFrameSize];
+    uint64_t prevKey = 0;
+    uint64_t prevValue = 0;
+    while (count != 0)
+    {
+      auto const frameSize =
+          static_cast<size_t>(std::min<uint64_t>(count, coding::kPackedFrameSize));
+      count -= frameSize;
+
+      data = coding::ReadPackedFrame(data, frameSize, keys);
+      coding::DecodeDeltas(keys, frameSize, prevKey);
+      data = coding::ReadPackedFrame(data, frameSize, values);
+      coding::DecodeZigZagDeltas(values, frameSize, static_cast<int64_t>(prevValue));
+      prevKey = keys[frameSize - 1];
+      prevValue = values[frameSize - 1];
+
+      for (size_t i = 0; i < frameSize; ++i)
+      {
+        uint64_t const fullKey = keyBase + keys[i];
+        while (first != last && first->m_end < fullKey)
+          ++first;
+        if (first == last)
+          return;
+        if (fullKey >= first->m_beg)
+          f(fullKey, static_cast<Value>(values[i]));
+      }
     }
   }
 
   template <typename F>
-  void ForEachNode(F const & f, uint64_t beg, uint64_t end, int level,
+  void ForEachNode(F const & f, KeyRange const * first, KeyRange const * last, int level,
       uint64_t offset, uint64_t size,
       uint64_t keyBase /* discarded part of object key value in the parent nodes */) const
   {
@@ -120,23 +232,43 @@ private:
 
     if (level == 0)
     {
-      ForEachLeaf(f, beg, end, offset, size, keyBase);
+      ForEachLeaf(f, first, last, offset, size, keyBase);
       return;
     }
 
     uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
-    ASSERT_LESS_OR_EQUAL(beg, end, (skipBits));
+    ASSERT(first != last, (skipBits));
 
     uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
-    uint32_t const beg0 = static_cast<uint32_t>(beg >> skipBits);
-    uint32_t const end0 = static_cast<uint32_t>(end >> skipBits);
-    ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
+    uint32_t const childrenCount = 1U << m_Header.m_BitsPerLevel;
+    // Ranges are within the node but the first and the last ones may stick out of it.
+    auto const childIndex = [&](uint64_t key) {
+      if (key < keyBase)
+        return 0U;
+      return static_cast<uint32_t>(std::min<uint64_t>((key - keyBase) >> skipBits,
+                                                      childrenCount - 1));
+    };
+    uint32_t const end0 = childIndex((last - 1)->m_end);
 
-    buffer_vector<uint8_t, 576> data;
-    data.resize_no_init(size);
+    // Returns false when there are no more ranges for the next children.
+    auto const forEachChild = [&](uint32_t i, uint64_t childOffset, uint64_t childSize) {
+      uint64_t const childKeyBase = keyBase + (uint64_t{i} << skipBits);
+      while (first != last && first->m_end < childKeyBase)
+        ++first;
+      if (first == last)
+        return false;
+
+      auto childLast = first;
+      while (childLast != last && childLast->m_beg <= childKeyBase + levelBytesFF)
+        ++childLast;
+      if (childLast != first)
+        ForEachNode(f, first, childLast, level - 1, childOffset, childSize, childKeyBase);
+      return true;
+    };
 
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    buffer_vector<uint8_t, 576> buffer;
+    uint8_t const * data = ReadNode(offset, size, buffer);
+    ArrayByteSource src(data);
 
     uint64_t const offsetAndFlag = ReadVarUint<uint64_t>(src);
     uint64_t childOffset = offsetAndFlag >> 1;
@@ -150,40 +282,31 @@ private:
         if (bits::GetBit(pBitmap, i))
         {
           uint64_t childSize = ReadVarUint<uint64_t>(src);
-          if (i >= beg0)
-          {
-            uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-            uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-            ForEachNode(f, beg1, end1, level - 1, childOffset, childSize, keyBase + (uint64_t{i} << skipBits));
-          }
+          if (!forEachChild(i, childOffset, childSize))
+            break;
           childOffset += childSize;
         }
       }
-      ASSERT(end0 != (static_cast<uint32_t>(1) << m_Header.m_BitsPerLevel) - 1 ||
-             static_cast<size_t>(static_cast<uint8_t const *>(src.Ptr()) - &data[0]) == size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), &data[0]));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = data + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
         if (i > end0)
           break;
         uint64_t childSize = ReadVarUint<uint64_t>(src);
-        if (i >= beg0)
-        {
-          uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-          uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-          ForEachNode(f, beg1, end1, level - 1, childOffset, childSize, keyBase + (uint64_t{i} << skipBits));
-        }
+        if (!forEachChild(i, childOffset, childSize))
+          break;
         childOffset += childSize;
       }
     }
   }
 
   ReaderT m_Reader;
+  // Not null when the index is in memory and nodes are read without copying.
+  uint8_t const * m_Memory = nullptr;
   Header m_Header;
   buffer_vector<uint64_t, 7> m_LevelOffsets;
 };
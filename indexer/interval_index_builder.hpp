@@ -2,6 +2,7 @@
 
 #include "indexer/interval_index.hpp"
 
+#include "coding/bit_packed_frames.hpp"
 #include "coding/byte_stream.hpp"
 #include "coding/endianness.hpp"
 #include "coding/varint.hpp"
@@ -14,8 +15,10 @@
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <utility>
 #include <vector>
 
 // +------------------------------+
@@ -37,6 +40,10 @@
 // +------------------------------+
 // |        Level N data          |
 // +------------------------------+
+//
+// V1 and V2 leaves are sequences of |leafBytes| keys each followed by a varint value delta.
+// V3 leaves are an entries count followed by frames of up to coding::kPackedFrameSize entries:
+// a packed frame of key deltas and a packed frame of zigzag value deltas.
 class IntervalIndexBuilder
 {
 public:
@@ -51,7 +58,7 @@ public:
     CHECK_GREATER_OR_EQUAL(
         static_cast<uint8_t>(version), static_cast<uint8_t>(IntervalIndexVersion::V1), ());
     CHECK_LESS_OR_EQUAL(
-        static_cast<uint8_t>(version), static_cast<uint8_t>(IntervalIndexVersion::V2), ());
+        static_cast<uint8_t>(version), static_cast<uint8_t>(IntervalIndexVersion::V3), ());
     CHECK_GREATER(leafBytes, 0, ());
     CHECK_LESS(keyBits, 63, ());
     int const nodeKeyBits = keyBits - (m_LeafBytes << 3);
@@ -283,6 +290,8 @@ private:
     uint64_t prevKey = 0;
     uint64_t prevValue = 0;
     uint64_t prevPos = writer.Pos();
+    uint64_t const leafKeyMask = (1ULL << skipBits) - 1;
+    std::vector<std::pair<uint64_t, Value>> leafEntries;
     for (CellIdValueIter it = beg; it != end; ++it)
     {
       uint64_t const key = it->GetCell();
@@ -296,23 +305,63 @@ private:
 
       if ((key >> skipBits) != (prevKey >> skipBits) && prevKey)
       {
+        WritePackedLeaf(writer, leafEntries);
         auto const nodeSize = writer.Pos() - prevPos;
         NewNode(0 /* nodeLevel */, prevKey >> skipBits, nodeSize);
 
         prevValue = 0;
         prevPos = writer.Pos();
       }
-      uint64_t const keySerial = SwapIfBigEndianMacroBased(key);
-      writer.Write(&keySerial, m_LeafBytes);
-      WriteVarInt(writer, static_cast<int64_t>(value) - static_cast<int64_t>(prevValue));
+      if (m_version == IntervalIndexVersion::V3)
+      {
+        leafEntries.emplace_back(key & leafKeyMask, value);
+      }
+      else
+      {
+        uint64_t const keySerial = SwapIfBigEndianMacroBased(key);
+        writer.Write(&keySerial, m_LeafBytes);
+        WriteVarInt(writer, static_cast<int64_t>(value) - static_cast<int64_t>(prevValue));
+      }
       prevKey = key;
       prevValue = value;
     }
 
+    WritePackedLeaf(writer, leafEntries);
     auto const nodeSize = writer.Pos() - prevPos;
     NewNode(0 /* nodeLevel */, prevKey >> skipBits, nodeSize, true /* last */);
   }
 
+  template <class Writer, typename Value>
+  void WritePackedLeaf(Writer & writer, std::vector<std::pair<uint64_t, Value>> & entries)
+  {
+    if (entries.empty())
+      return;
+
+    WriteVarUint(writer, static_cast<uint64_t>(entries.size()));
+
+    uint64_t keyDeltas[coding::kPackedFrameSize];
+    uint64_t valueDeltas[coding::kPackedFrameSize];
+    uint64_t prevKey = 0;
+    int64_t prevValue = 0;
+    for (size_t i = 0; i < entries.size(); i += coding::kPackedFrameSize)
+    {
+      size_t const frameSize = std::min(coding::kPackedFrameSize, entries.size() - i);
+      for (size_t j = 0; j < frameSize; ++j)
+      {
+        auto const key = entries[i + j].first;
+        auto const value = static_cast<int64_t>(entries[i + j].second);
+        keyDeltas[j] = key - prevKey;
+        valueDeltas[j] = bits::ZigZagEncode(value - prevValue);
+        prevKey = key;
+        prevValue = value;
+      }
+      coding::WritePackedFrame(writer, keyDeltas, frameSize);
+      coding::WritePackedFrame(writer, valueDeltas, frameSize);
+    }
+
+    entries.clear();
+  }
+
   IntervalIndexVersion m_version;
   uint32_t m_Levels, m_BitsPerLevel, m_LeafBytes, m_LastBitsMask;
   std::vector<LevelAssembly> m_levelsAssembly;
@@ -10,7 +10,9 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <array>
 #include <exception>
+#include <iterator>
 #include <sstream>
 
 
@@ -18,7 +20,70 @@ using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+class MwmInfo::ValuePool
+{
+public:
+  ValuePool()
+  {
+    for (auto & value : m_values)
+      value = nullptr;
+  }
+
+  ~ValuePool() { Clear(); }
+
+  unique_ptr<MwmSet::MwmValueBase> Take()
+  {
+    for (auto & value : m_values)
+    {
+      if (value.load(memory_order_relaxed) == nullptr)
+        continue;
+      if (auto result = value.exchange(nullptr))
+        return unique_ptr<MwmSet::MwmValueBase>(result);
+    }
+    return nullptr;
+  }
+
+  unique_ptr<MwmSet::MwmValueBase> Put(unique_ptr<MwmSet::MwmValueBase> value)
+  {
+    for (auto & freeValue : m_values)
+    {
+      MwmSet::MwmValueBase * expected = nullptr;
+      if (freeValue.compare_exchange_strong(expected, value.get()))
+      {
+        value.release();
+        return nullptr;
+      }
+    }
+    return value;
+  }
+
+  // Returns the number of removed values.
+  size_t Clear()
+  {
+    size_t count = 0;
+    for (auto & value : m_values)
+    {
+      unique_ptr<MwmSet::MwmValueBase> removed(value.exchange(nullptr));
+      if (removed)
+        ++count;
+    }
+    return count;
+  }
+
+private:
+  array<atomic<MwmSet::MwmValueBase *>, 8> m_values;
+};
+
+MwmInfo::MwmInfo()
+  : m_minScale(0)
+  , m_maxScale(0)
+  , m_status(STATUS_DEREGISTERED)
+  , m_numRefs(0)
+  , m_valuePool(make_unique<ValuePool>())
+{
+}
+
+MwmInfo::~MwmInfo() = default;
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -166,6 +231,9 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     return false;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
+  // The mwm is marked before the refs check, so lock-free LockValue() either sees the mark
+  // or has its ref counted here.
+  SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
   if (info->m_numRefs == 0)
   {
     SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
@@ -175,14 +243,14 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     {
       if (it->first == id)
       {
-        m_cache.erase(it);
+        ClearCacheImpl(it, next(it));
         break;
       }
     }
+    ClearPooledValues(*info);
     return true;
   }
 
-  SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
   return false;
 }
 
@@ -265,6 +333,17 @@ void MwmSet::ProcessEventList(EventList & events)
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
 {
+  if (!id.IsAlive())
+    return nullptr;
+
+  MwmInfo & info = *id.GetInfo();
+  ++info.m_numRefs;
+  if (info.IsRegistered())
+  {
+    if (auto result = TakePooledValue(info))
+      return result;
+  }
+
   unique_ptr<MwmSet::MwmValueBase> result;
   WithEventLog([&](EventList & events)
                {
@@ -275,16 +354,21 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValue(MwmId const & id)
 
 unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
 {
+  // The ref is taken by the caller.
+  shared_ptr<MwmInfo> info = id.GetInfo();
   if (!id.IsAlive())
+  {
+    --info->m_numRefs;
     return nullptr;
-  shared_ptr<MwmInfo> info = id.GetInfo();
+  }
 
   // It's better to return valid "value pointer" even for "out-of-date" files,
   // because they can be locked for a long time by other algos.
   //if (!info->IsUpToDate())
   //  return TMwmValueBasePtr();
 
-  ++info->m_numRefs;
+  if (auto result = TakePooledValue(*info))
+    return result;
 
   // Search in cache.
   for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
@@ -292,7 +376,7 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
     if (it->first == id)
     {
       unique_ptr<MwmValueBase> result = move(it->second);
-      m_cache.erase(it);
+      ClearCacheImpl(it, next(it));
       return result;
     }
   }
@@ -305,6 +389,7 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
   {
     LOG(LERROR, ("Too many open files, can't open:", info->GetCountryName()));
     --info->m_numRefs;
+    DeregisterUnlocked(id, events);
     return nullptr;
   }
   catch (exception const & ex)
@@ -319,6 +404,23 @@ unique_ptr<MwmSet::MwmValueBase> MwmSet::LockValueImpl(MwmId const & id, EventLi
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValueBase> p)
 {
+  if (id.IsAlive() && p)
+  {
+    MwmInfo & info = *id.GetInfo();
+    if (info.IsRegistered())
+      p = PutPooledValue(info, move(p));
+
+    if (!p)
+    {
+      ASSERT_GREATER(info.m_numRefs, 0, ());
+      --info.m_numRefs;
+      // The mwm may have been marked to deregister after the value was pooled.
+      if (info.GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+        WithEventLog([&](EventList & events) { DeregisterUnlocked(id, events); });
+      return;
+    }
+  }
+
   WithEventLog([&](EventList & events)
                {
                  UnlockValueImpl(id, move(p), events);
@@ -335,8 +437,7 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, Event
   shared_ptr<MwmInfo> const & info = id.GetInfo();
   ASSERT_GREATER(info->m_numRefs, 0, ());
   --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
-    VERIFY(DeregisterImpl(id, events), ());
+  DeregisterUnlocked(id, events);
 
   if (info->IsUpToDate())
   {
@@ -344,11 +445,10 @@ void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValueBase> p, Event
     /// But it's no obvious if we have many threads working with the single mwm.
 
     m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
-    {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
-    }
+    ++m_idleValues;
+    // Pooled values are not evicted, so the cache gives way to them.
+    while (m_idleValues > m_cacheSize && !m_cache.empty())
+      ClearCacheImpl(m_cache.begin(), next(m_cache.begin()));
   }
 }
 
@@ -356,6 +456,7 @@ void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearPooledValuesImpl();
   m_info.clear();
 }
 
@@ -363,6 +464,43 @@ void MwmSet::ClearCache()
 {
   lock_guard<mutex> lock(m_lock);
   ClearCacheImpl(m_cache.begin(), m_cache.end());
+  ClearPooledValuesImpl();
+}
+
+unique_ptr<MwmSet::MwmValueBase> MwmSet::TakePooledValue(MwmInfo & info)
+{
+  auto value = info.m_valuePool->Take();
+  if (value)
+    --m_idleValues;
+  return value;
+}
+
+unique_ptr<MwmSet::MwmValueBase> MwmSet::PutPooledValue(MwmInfo & info,
+                                                        unique_ptr<MwmValueBase> value)
+{
+  if (m_idleValues++ < m_cacheSize)
+    value = info.m_valuePool->Put(move(value));
+  if (value)
+    --m_idleValues;
+  return value;
+}
+
+void MwmSet::ClearPooledValues(MwmInfo & info) { m_idleValues -= info.m_valuePool->Clear(); }
+
+void MwmSet::ClearPooledValuesImpl()
+{
+  for (auto const & infos : m_info)
+  {
+    for (auto const & info : infos.second)
+      ClearPooledValues(*info);
+  }
+}
+
+void MwmSet::DeregisterUnlocked(MwmId const & id, EventList & events)
+{
+  auto const & info = id.GetInfo();
+  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
+    VERIFY(DeregisterImpl(id, events), ());
 }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
@@ -383,26 +521,31 @@ MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryF
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(id, events);
-               });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
 {
   unique_ptr<MwmValueBase> value;
   if (id.IsAlive())
+  {
+    ++id.GetInfo()->m_numRefs;
     value = LockValueImpl(id, events);
+  }
   return MwmHandle(*this, id, move(value));
 }
 
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
+void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end)
+{
+  m_idleValues -= static_cast<size_t>(distance(beg, end));
+  m_cache.erase(beg, end);
+}
 
 void MwmSet::ClearCache(MwmId const & id)
 {
+  if (id.GetInfo())
+    ClearPooledValues(*id.GetInfo());
+
   auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmSet::MwmValueBase>> const & p)
   {
     return (p.first == id);
@@ -45,7 +45,7 @@ public:
   };
 
   MwmInfo();
-  virtual ~MwmInfo() = default;
+  virtual ~MwmInfo();
 
   m2::RectD m_bordersRect;        ///< Rect around region border. Features which cross region border may
                                   ///< cross this rect.
@@ -84,7 +84,13 @@ protected:
 
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
-  uint32_t m_numRefs;                 ///< Number of active handles.
+  std::atomic<uint32_t> m_numRefs;    ///< Number of active handles.
+
+private:
+  // Lock-free pool of free values of the mwm.
+  class ValuePool;
+
+  std::unique_ptr<ValuePool> m_valuePool;
 };
 
 class MwmInfoEx : public MwmInfo
@@ -358,7 +364,9 @@ private:
   /// @precondition This function is always called under mutex m_lock.
   MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
 
+  // Takes a value of a registered mwm from its pool without |m_lock| when it is possible.
   std::unique_ptr<MwmValueBase> LockValue(MwmId const & id);
+  /// @precondition The mwm ref is taken by the caller.
   std::unique_ptr<MwmValueBase> LockValueImpl(MwmId const & id, EventList & events);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValueBase> p);
   void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValueBase> p, EventList & events);
@@ -367,8 +375,22 @@ private:
   /// @precondition This function is always called under mutex m_lock.
   void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
 
+  // Values of registered mwms are taken from and returned to per mwm pools without |m_lock|.
+  // Pooled and cached values are limited by |m_cacheSize| together.
+  std::unique_ptr<MwmValueBase> TakePooledValue(MwmInfo & info);
+  // Returns |value| back when it has not been pooled.
+  std::unique_ptr<MwmValueBase> PutPooledValue(MwmInfo & info, std::unique_ptr<MwmValueBase> value);
+  void ClearPooledValues(MwmInfo & info);
+  /// @precondition This function is always called under mutex m_lock.
+  void ClearPooledValuesImpl();
+
+  // Deregisters mwm marked to deregister when its last handle has been released.
+  void DeregisterUnlocked(MwmId const & id, EventList & events);
+
   Cache m_cache;
   size_t const m_cacheSize;
+  // Number of pooled and cached values.
+  std::atomic<size_t> m_idleValues{0};
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -9,6 +9,8 @@
 #include "3party/utfcpp/source/utf8/unchecked.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -55,6 +57,135 @@ void RemoveNumeroSigns(UniString & s)
     i = j;
   }
 }
+
+// The former NormalizeAndSimplifyString() steps for a single code point:
+// special cases, lower case, NFKD and removal of accents.
+void NormalizeChar(UniChar c, UniString & result)
+{
+  result.clear();
+  // MakeLowerCaseInplace() asserts on the null char, it is kept as by the ASCII fast path.
+  if (c == 0)
+  {
+    result.push_back(c);
+    return;
+  }
+
+  switch (c)
+  {
+  // Replace "d with stroke" to simple d letter. Used in Vietnamese.
+  // (unicode-compliant implementation leaves it unchanged)
+  case 0x0110:
+  case 0x0111: result.push_back('d'); break;
+  // Replace small turkish dotless 'ı' with dotted 'i'.  Our own
+  // invented hack to avoid well-known Turkish I-letter bug.
+  case 0x0131: result.push_back('i'); break;
+  // Replace capital turkish dotted 'İ' with dotted lowercased 'i'.
+  // Here we need to handle this case manually too, because default
+  // unicode-compliant implementation of MakeLowerCase converts 'İ'
+  // to 'i' + 0x0307.
+  case 0x0130: result.push_back('i'); break;
+  // Some Danish-specific hacks.
+  case 0x00d8:  // Ø
+  case 0x00f8:  // ø
+    result.push_back('o');
+    break;
+  case 0x0152:  // Œ
+  case 0x0153:  // œ
+    result.push_back('o');
+    result.push_back('e');
+    break;
+  case 0x00c6:  // Æ
+  case 0x00e6:  // æ
+    result.push_back('a');
+    result.push_back('e');
+    break;
+  case 0x2116:  // №
+    result.push_back('#');
+    break;
+  default: result.push_back(c);
+  }
+
+  MakeLowerCaseInplace(result);
+  NormalizeInplace(result);
+
+  // Remove accents that can appear after NFKD normalization.
+  result.erase_if([](UniChar const & c) {
+    // ̀  COMBINING GRAVE ACCENT
+    // ́  COMBINING ACUTE ACCENT
+    return (c == 0x0300 || c == 0x0301);
+  });
+}
+
+// All the normalization steps but numero signs removal are per code point, so the results
+// for the basic multilingual plane are precomputed. Other code points are normalized on the fly.
+class NormalizationTable
+{
+public:
+  NormalizationTable() : m_entries(kSize)
+  {
+    UniString normalized;
+    for (UniChar c = 0; c < kSize; ++c)
+    {
+      NormalizeChar(c, normalized);
+      if (normalized.size() == 1 && normalized[0] == c)
+      {
+        m_entries[c] = kSame;
+        continue;
+      }
+
+      CHECK_LESS(normalized.size(), 0x100, (c));
+      m_entries[c] = static_cast<uint32_t>(m_chars.size() << 8 | normalized.size());
+      m_chars.insert(m_chars.end(), normalized.begin(), normalized.end());
+    }
+  }
+
+  void Append(UniChar c, UniString & s) const
+  {
+    if (c >= kSize)
+    {
+      UniString normalized;
+      NormalizeChar(c, normalized);
+      s.append(normalized.begin(), normalized.end());
+      return;
+    }
+
+    auto const entry = m_entries[c];
+    if (entry == kSame)
+    {
+      s.push_back(c);
+      return;
+    }
+
+    auto const begin = m_chars.begin() + (entry >> 8);
+    s.append(begin, begin + (entry & 0xFF));
+  }
+
+private:
+  static UniChar constexpr kSize = 0x10000;
+  static uint32_t constexpr kSame = numeric_limits<uint32_t>::max();
+
+  // Offset of the normalized chars in |m_chars| shifted by 8 bits and their count or |kSame|.
+  vector<uint32_t> m_entries;
+  vector<UniChar> m_chars;
+};
+
+NormalizationTable const & GetNormalizationTable()
+{
+  static NormalizationTable const table;
+  return table;
+}
+
+uint64_t constexpr kHighBits = 0x8080808080808080ULL;
+uint64_t constexpr kLowBytes = 0x0101010101010101ULL;
+
+// Lowers ASCII chars packed in |word| bytes.
+uint64_t LowerAsciiChars(uint64_t word)
+{
+  uint64_t const aboveZ = word + (0x7F - 'Z') * kLowBytes;
+  uint64_t const fromA = word + (0x80 - 'A') * kLowBytes;
+  uint64_t const upper = fromA & ~aboveZ & kHighBits;
+  return word | (upper >> 2);
+}
 }  // namespace
 
 size_t GetMaxErrorsForTokenLength(size_t length)
@@ -84,65 +215,54 @@ strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
 
 UniString NormalizeAndSimplifyString(string const & s)
 {
-  UniString uniString = MakeUniString(s);
-  for (size_t i = 0; i < uniString.size(); ++i)
+  UniString uniString;
+  NormalizeAndSimplifyString(s, uniString);
+  return uniString;
+}
+
+void NormalizeAndSimplifyString(string const & s, UniString & uniString)
+{
+  auto const & table = GetNormalizationTable();
+
+  uniString.clear();
+  uniString.reserve(s.size());
+  auto it = s.begin();
+  auto const end = s.end();
+  while (it != end)
   {
-    UniChar & c = uniString[i];
-    switch (c)
+    // ASCII fast path by eight chars.
+    while (end - it >= 8)
     {
-    // Replace "d with stroke" to simple d letter. Used in Vietnamese.
-    // (unicode-compliant implementation leaves it unchanged)
-    case 0x0110:
-    case 0x0111:
-      c = 'd';
-      break;
-    // Replace small turkish dotless 'ı' with dotted 'i'.  Our own
-    // invented hack to avoid well-known Turkish I-letter bug.
-    case 0x0131:
-      c = 'i';
-      break;
-    // Replace capital turkish dotted 'İ' with dotted lowercased 'i'.
-    // Here we need to handle this case manually too, because default
-    // unicode-compliant implementation of MakeLowerCase converts 'İ'
-    // to 'i' + 0x0307.
-    case 0x0130:
-      c = 'i';
-      break;
-    // Some Danish-specific hacks.
-    case 0x00d8:  // Ø
-    case 0x00f8:  // ø
-      c = 'o';
-      break;
-    case 0x0152:  // Œ
-    case 0x0153:  // œ
-      c = 'o';
-      uniString.insert(uniString.begin() + (i++) + 1, 'e');
-      break;
-    case 0x00c6:  // Æ
-    case 0x00e6:  // æ
-      c = 'a';
-      uniString.insert(uniString.begin() + (i++) + 1, 'e');
-      break;
-    case 0x2116:  // №
-      c = '#';
-      break;
+      uint64_t word;
+      memcpy(&word, &*it, sizeof(word));
+      if (word & kHighBits)
+        break;
+
+      // Lowering is done by bytes of the word, the bytes are stored back to keep the order of
+      // chars on any endianness.
+      word = LowerAsciiChars(word);
+      char chars[sizeof(word)];
+      memcpy(chars, &word, sizeof(word));
+      for (auto const c : chars)
+        uniString.push_back(static_cast<UniChar>(c));
+      it += 8;
     }
-  }
+    if (it == end)
+      break;
 
-  MakeLowerCaseInplace(uniString);
-  NormalizeInplace(uniString);
+    auto const byte = static_cast<uint8_t>(*it);
+    if (byte < 0x80)
+    {
+      uniString.push_back(static_cast<UniChar>(LowerAsciiChars(byte)));
+      ++it;
+      continue;
+    }
 
-  // Remove accents that can appear after NFKD normalization.
-  uniString.erase_if([](UniChar const & c) {
-    // ̀  COMBINING GRAVE ACCENT
-    // ́  COMBINING ACUTE ACCENT
-    return (c == 0x0300 || c == 0x0301);
-  });
+    table.Append(utf8::unchecked::next(it), uniString);
+  }
 
   RemoveNumeroSigns(uniString);
 
-  return uniString;
-
   /// @todo Restore this logic to distinguish и-й in future.
   /*
   // Just after lower casing is a correct place to avoid normalization for specific chars.
@@ -21,6 +21,8 @@ strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s);
 // This function should be used for all search strings normalization.
 // It does some magic text transformation which greatly helps us to improve our search.
 strings::UniString NormalizeAndSimplifyString(std::string const & s);
+// Same as above but writes into |result| to reuse its memory.
+void NormalizeAndSimplifyString(std::string const & s, strings::UniString & result);
 
 // Replace abbreviations which can be split during tokenization with full form.
 // Eg. "пр-т" -> "проспект".
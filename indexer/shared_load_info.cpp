@@ -41,4 +41,18 @@ SharedLoadInfo::Reader SharedLoadInfo::GetTrianglesReader(int ind) const
 {
   return m_cont.GetReader(GetTagForIndex(TRIANGLE_FILE_TAG, ind));
 }
+
+BoundsTable const * SharedLoadInfo::GetBoundsTable() const
+{
+  if (!m_boundsTableLoaded)
+  {
+    m_boundsTableLoaded = true;
+    if (m_cont.IsExist(FEATURE_BOUNDS_FILE_TAG))
+    {
+      m_boundsTable = BoundsTable::Load(m_cont.GetReader(FEATURE_BOUNDS_FILE_TAG),
+                                        GetDefGeometryCodingParams().GetCoordBits());
+    }
+  }
+  return m_boundsTable.get();
+}
 }  // namespace feature
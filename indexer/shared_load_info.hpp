@@ -1,12 +1,15 @@
 #pragma once
 
 #include "indexer/data_header.hpp"
+#include "indexer/feature_bounds_table.hpp"
 
 #include "coding/file_container.hpp"
 #include "coding/geometry_coding.hpp"
 
 #include "base/macros.hpp"
 
+#include <memory>
+
 namespace feature
 {
 // This info is created once per FeaturesVector.
@@ -41,10 +44,17 @@ public:
   int GetScale(int i) const { return m_header.GetScale(i); }
   int GetLastScale() const { return m_header.GetLastScale(); }
 
+  // Returns the bounds table of the mwm or nullptr if the mwm has no bounds section.
+  // The table is loaded by the first call.
+  BoundsTable const * GetBoundsTable() const;
+
 private:
   FilesContainerR const & m_cont;
   DataHeader const & m_header;
 
+  mutable std::unique_ptr<BoundsTable> m_boundsTable;
+  mutable bool m_boundsTableLoaded = false;
+
   DISALLOW_COPY_AND_MOVE(SharedLoadInfo);
 };
 }  // namespace feature
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "base/assert.hpp"
 #include "base/base.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -45,8 +50,46 @@ class CheckUniqueIndexes
 public:
   explicit CheckUniqueIndexes(bool useBits) : m_useBits(useBits) {}
 
+  /// Empties the set keeping its memory. |numIndexes| is a hint for the bits size.
+  void Reset(bool useBits, size_t numIndexes)
+  {
+    m_useBits = useBits;
+    if (m_useBits)
+    {
+      m_s.clear();
+      m_v.assign(numIndexes, false);
+    }
+    else
+    {
+      m_v.clear();
+      m_s.clear();
+    }
+  }
+
   bool operator()(uint32_t index)
   {
     return Add(index);
   }
 };
+
+/// Thread-safe version of CheckUniqueIndexes for indexes less than |size|.
+class ConcurrentCheckUniqueIndexes
+{
+public:
+  explicit ConcurrentCheckUniqueIndexes(size_t size)
+    : m_size(size), m_bits(new std::atomic<uint64_t>[(size + 63) / 64]())
+  {
+  }
+
+  /// @return true If index was absent.
+  bool operator()(uint32_t index)
+  {
+    ASSERT_LESS(index, m_size, ());
+    uint64_t const bit = uint64_t{1} << (index % 64);
+    return (m_bits[index / 64].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+  }
+
+private:
+  size_t m_size;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_bits;
+};